@@ -9,9 +9,12 @@
 // Arguments:
 // - cchRowWidth - the length of the default text attribute
 // - attr - the default text attribute
+// - hyperlinkRefCounts - the hyperlink reference counts to keep up to date, if any
 // Return Value:
 // - constructed object
-ATTR_ROW::ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr) noexcept
+ATTR_ROW::ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr, HyperlinkRefCounts* const hyperlinkRefCounts) noexcept :
+    _hyperlinkRefCounts{ hyperlinkRefCounts },
+    _hasHyperlinks{ false }
 {
     try
     {
@@ -22,6 +25,121 @@ ATTR_ROW::ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr) noexcept
         FAIL_FAST_CAUGHT_EXCEPTION();
     }
     _cchRowWidth = cchRowWidth;
+    _AcquireHyperlinks();
+}
+
+ATTR_ROW::~ATTR_ROW()
+{
+    _ReleaseHyperlinks();
+}
+
+ATTR_ROW::ATTR_ROW(const ATTR_ROW& other) :
+    _list{ other._list },
+    _cchRowWidth{ other._cchRowWidth },
+    _hyperlinkRefCounts{ other._hyperlinkRefCounts },
+    _hasHyperlinks{ false }
+{
+    _AcquireHyperlinks();
+}
+
+ATTR_ROW& ATTR_ROW::operator=(const ATTR_ROW& other)
+{
+    if (this != &other)
+    {
+        auto list{ other._list };
+        _ReleaseHyperlinks();
+        _list = std::move(list);
+        _cchRowWidth = other._cchRowWidth;
+        _hyperlinkRefCounts = other._hyperlinkRefCounts;
+        _AcquireHyperlinks();
+    }
+    return *this;
+}
+
+// The references move along with the runs, so the moved-from
+// row must not release them anymore.
+ATTR_ROW::ATTR_ROW(ATTR_ROW&& other) noexcept :
+    _list{ std::move(other._list) },
+    _cchRowWidth{ other._cchRowWidth },
+    _hyperlinkRefCounts{ std::exchange(other._hyperlinkRefCounts, nullptr) },
+    _hasHyperlinks{ std::exchange(other._hasHyperlinks, false) }
+{
+}
+
+ATTR_ROW& ATTR_ROW::operator=(ATTR_ROW&& other) noexcept
+{
+    if (this != &other)
+    {
+        _ReleaseHyperlinks();
+        _list = std::move(other._list);
+        _cchRowWidth = other._cchRowWidth;
+        _hyperlinkRefCounts = std::exchange(other._hyperlinkRefCounts, nullptr);
+        _hasHyperlinks = std::exchange(other._hasHyperlinks, false);
+    }
+    return *this;
+}
+
+// Routine Description:
+// - Runs a function that modifies _list, while keeping the hyperlink
+//   reference counts up to date: the references of the old runs are
+//   released before, and those of the new runs acquired afterwards.
+// - This is skipped if there's nothing to count, which is when the row
+//   neither had any hyperlinks before, nor may gain some from the update.
+// Arguments:
+// - mayAddHyperlinks - whether the update may introduce hyperlink runs.
+// - update - the function modifying _list.
+// Return Value:
+// - Whatever update returns.
+template<typename F>
+auto ATTR_ROW::_UpdateRuns(const bool mayAddHyperlinks, F&& update)
+{
+    if (!_hyperlinkRefCounts || !(_hasHyperlinks || mayAddHyperlinks))
+    {
+        return update();
+    }
+
+    _ReleaseHyperlinks();
+    auto reacquire = wil::scope_exit([&]() noexcept {
+        _AcquireHyperlinks();
+    });
+    return update();
+}
+
+void ATTR_ROW::_AcquireHyperlinks() noexcept
+{
+    _hasHyperlinks = false;
+    if (!_hyperlinkRefCounts)
+    {
+        return;
+    }
+
+    for (const auto& run : _list)
+    {
+        const auto& attributes = run.GetAttributes();
+        if (attributes.IsHyperlink())
+        {
+            _hyperlinkRefCounts->Acquire(attributes.GetHyperlinkId());
+            _hasHyperlinks = true;
+        }
+    }
+}
+
+void ATTR_ROW::_ReleaseHyperlinks() noexcept
+{
+    if (!_hasHyperlinks)
+    {
+        return;
+    }
+
+    for (const auto& run : _list)
+    {
+        const auto& attributes = run.GetAttributes();
+        if (attributes.IsHyperlink())
+        {
+            _hyperlinkRefCounts->Release(attributes.GetHyperlinkId());
+        }
+    }
+    _hasHyperlinks = false;
 }
 
 // Routine Description:
@@ -30,8 +148,10 @@ ATTR_ROW::ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr) noexcept
 // - attr - The default text attributes to use on text in this row.
 void ATTR_ROW::Reset(const TextAttribute attr)
 {
-    _list.clear();
-    _list.emplace_back(TextAttributeRun(_cchRowWidth, attr));
+    _UpdateRuns(attr.IsHyperlink(), [&]() {
+        _list.clear();
+        _list.emplace_back(TextAttributeRun(_cchRowWidth, attr));
+    });
 }
 
 // Routine Description:
@@ -47,6 +167,14 @@ void ATTR_ROW::Resize(const size_t newWidth)
 {
     THROW_HR_IF(E_INVALIDARG, 0 == newWidth);
 
+    // Shrinking may cut hyperlink runs off.
+    _UpdateRuns(false, [&]() {
+        _Resize(newWidth);
+    });
+}
+
+void ATTR_ROW::_Resize(const size_t newWidth)
+{
     // Easy case. If the new row is longer, increase the length of the last run by how much new space there is.
     if (newWidth > _cchRowWidth)
     {
@@ -223,13 +351,15 @@ bool ATTR_ROW::SetAttrToEnd(const UINT iStart, const TextAttribute attr)
 // - <none>
 void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAttribute& replaceWith) noexcept
 {
-    for (auto& run : _list)
-    {
-        if (run.GetAttributes() == toBeReplacedAttr)
+    _UpdateRuns(replaceWith.IsHyperlink(), [&]() noexcept {
+        for (auto& run : _list)
         {
-            run.SetAttributes(replaceWith);
+            if (run.GetAttributes() == toBeReplacedAttr)
+            {
+                run.SetAttributes(replaceWith);
+            }
         }
-    }
+    });
 }
 
 // Routine Description:
@@ -250,6 +380,19 @@ void ATTR_ROW::ReplaceAttrs(const TextAttribute& toBeReplacedAttr, const TextAtt
                                                const size_t iStart,
                                                const size_t iEnd,
                                                const size_t cBufferWidth)
+{
+    const auto mayAddHyperlinks = std::any_of(newAttrs.begin(), newAttrs.end(), [](const auto& run) {
+        return run.GetAttributes().IsHyperlink();
+    });
+    return _UpdateRuns(mayAddHyperlinks, [&]() {
+        return _InsertAttrRuns(newAttrs, iStart, iEnd, cBufferWidth);
+    });
+}
+
+[[nodiscard]] HRESULT ATTR_ROW::_InsertAttrRuns(const gsl::span<const TextAttributeRun> newAttrs,
+                                                const size_t iStart,
+                                                const size_t iEnd,
+                                                const size_t cBufferWidth)
 {
     // Definitions:
     // Existing Run = The run length encoded color array we're already storing in memory before this was called.
@@ -22,22 +22,23 @@ Revision History:
 
 #include "TextAttributeRun.hpp"
 #include "AttrRowIterator.hpp"
+#include "HyperlinkRefCounts.hpp"
 
 class ATTR_ROW final
 {
 public:
     using const_iterator = typename AttrRowIterator;
 
-    ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr)
+    ATTR_ROW(const UINT cchRowWidth, const TextAttribute attr, HyperlinkRefCounts* const hyperlinkRefCounts = nullptr)
     noexcept;
 
-    ~ATTR_ROW() = default;
+    ~ATTR_ROW();
 
-    ATTR_ROW(const ATTR_ROW&) = default;
-    ATTR_ROW& operator=(const ATTR_ROW&) = default;
-    ATTR_ROW(ATTR_ROW&&)
-    noexcept = default;
-    ATTR_ROW& operator=(ATTR_ROW&&) noexcept = default;
+    ATTR_ROW(const ATTR_ROW& other);
+    ATTR_ROW& operator=(const ATTR_ROW& other);
+    ATTR_ROW(ATTR_ROW&& other)
+    noexcept;
+    ATTR_ROW& operator=(ATTR_ROW&& other) noexcept;
 
     TextAttribute GetAttrByColumn(const size_t column) const;
     TextAttribute GetAttrByColumn(const size_t column,
@@ -71,13 +72,32 @@ public:
     friend bool operator==(const ATTR_ROW& a, const ATTR_ROW& b) noexcept;
     friend class AttrRowIterator;
     friend class ROW;
+    friend class RowView;
 
 private:
     void Reset(const TextAttribute attr);
 
+    [[nodiscard]] HRESULT _InsertAttrRuns(const gsl::span<const TextAttributeRun> newAttrs,
+                                          const size_t iStart,
+                                          const size_t iEnd,
+                                          const size_t cBufferWidth);
+
+    void _Resize(const size_t newWidth);
+
+    template<typename F>
+    auto _UpdateRuns(const bool mayAddHyperlinks, F&& update);
+    void _AcquireHyperlinks() noexcept;
+    void _ReleaseHyperlinks() noexcept;
+
     boost::container::small_vector<TextAttributeRun, 1> _list;
     size_t _cchRowWidth;
 
+    // The reference counts of the buffer this row belongs to, if any.
+    HyperlinkRefCounts* _hyperlinkRefCounts;
+    // Whether any of the runs in _list is a hyperlink. This is only
+    // maintained if _hyperlinkRefCounts is set.
+    bool _hasHyperlinks;
+
 #ifdef UNIT_TESTING
     friend class AttrRowTests;
     friend class CommonState;
@@ -65,8 +65,6 @@ public:
     DbcsAttribute& DbcsAttrAt(const size_t column);
     void ClearGlyph(const size_t column);
 
-    const DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const;
-
     // working with glyphs
     const reference GlyphAt(const size_t column) const;
     reference GlyphAt(const size_t column);
@@ -88,6 +86,7 @@ public:
 
     friend CharRowCellReference;
     friend class ROW;
+    friend class RowView;
 
 private:
     void Reset() noexcept;
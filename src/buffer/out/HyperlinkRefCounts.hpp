@@ -0,0 +1,62 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- HyperlinkRefCounts.hpp
+
+Abstract:
+- Counts the attribute runs referencing each hyperlink ID in a text buffer.
+  Every ATTR_ROW of the buffer keeps these counts up to date as its runs are
+  written, replaced or recycled, which lets the buffer tell in O(1) whether
+  a hyperlink ID is still in use anywhere.
+--*/
+
+#pragma once
+
+class HyperlinkRefCounts final
+{
+public:
+    void Acquire(const uint16_t id) noexcept
+    {
+        if (!_counts)
+        {
+            // Most buffers never see a hyperlink, so the table is only
+            // allocated once the first one gets written.
+            if (_untracked)
+            {
+                return;
+            }
+            _counts.reset(new (std::nothrow) uint32_t[s_idCount]{});
+            if (!_counts)
+            {
+                _untracked = true;
+                return;
+            }
+        }
+        ++_counts[id];
+    }
+
+    void Release(const uint16_t id) noexcept
+    {
+        if (_counts && _counts[id] != 0)
+        {
+            --_counts[id];
+        }
+    }
+
+    // Method Description:
+    // - Returns whether any run still references the given hyperlink ID.
+    //   If we failed to allocate the table, we can't tell, and err on the
+    //   side of keeping hyperlinks around.
+    bool IsReferenced(const uint16_t id) const noexcept
+    {
+        return _untracked || (_counts && _counts[id] != 0);
+    }
+
+private:
+    static constexpr size_t s_idCount = size_t{ std::numeric_limits<uint16_t>::max() } + 1;
+
+    std::unique_ptr<uint32_t[]> _counts;
+    bool _untracked = false;
+};
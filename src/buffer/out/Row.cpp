@@ -7,6 +7,8 @@
 #include "textBuffer.hpp"
 #include "../types/inc/convert.hpp"
 
+std::atomic<uint64_t> ROW::s_lastRevision{ 0 };
+
 // Routine Description:
 // - constructor
 // Arguments:
@@ -20,11 +22,12 @@ ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute f
     _id{ rowId },
     _rowWidth{ rowWidth },
     _charRow{ rowWidth, this },
-    _attrRow{ rowWidth, fillAttribute },
+    _attrRow{ rowWidth, fillAttribute, pParent ? &pParent->GetHyperlinkRefCounts() : nullptr },
     _lineRendition{ LineRendition::SingleWidth },
     _wrapForced{ false },
     _doubleBytePadded{ false },
-    _pParent{ pParent }
+    _pParent{ pParent },
+    _revision{ s_lastRevision.fetch_add(1, std::memory_order_relaxed) + 1 }
 {
 }
 
@@ -36,6 +39,7 @@ ROW::ROW(const SHORT rowId, const unsigned short rowWidth, const TextAttribute f
 // - <none>
 bool ROW::Reset(const TextAttribute Attr)
 {
+    _Touch();
     _lineRendition = LineRendition::SingleWidth;
     _wrapForced = false;
     _doubleBytePadded = false;
@@ -60,6 +64,7 @@ bool ROW::Reset(const TextAttribute Attr)
 // - S_OK if successful, otherwise relevant error
 [[nodiscard]] HRESULT ROW::Resize(const unsigned short width)
 {
+    _Touch();
     RETURN_IF_FAILED(_charRow.Resize(width));
     try
     {
@@ -81,6 +86,7 @@ bool ROW::Reset(const TextAttribute Attr)
 void ROW::ClearColumn(const size_t column)
 {
     THROW_HR_IF(E_INVALIDARG, column >= _charRow.size());
+    _Touch();
     _charRow.ClearCell(column);
 }
 
@@ -107,6 +113,7 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const size_t index, co
 {
     THROW_HR_IF(E_INVALIDARG, index >= _charRow.size());
     THROW_HR_IF(E_INVALIDARG, limitRight.value_or(0) >= _charRow.size());
+    _Touch();
     size_t currentIndex = index;
 
     // If we're given a right-side column limit, use it. Otherwise, the write limit is the final column index available in the char row.
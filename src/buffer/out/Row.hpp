@@ -37,23 +37,51 @@ public:
 
     size_t size() const noexcept { return _rowWidth; }
 
-    void SetWrapForced(const bool wrap) noexcept { _wrapForced = wrap; }
+    void SetWrapForced(const bool wrap) noexcept
+    {
+        _Touch();
+        _wrapForced = wrap;
+    }
     bool WasWrapForced() const noexcept { return _wrapForced; }
 
-    void SetDoubleBytePadded(const bool doubleBytePadded) noexcept { _doubleBytePadded = doubleBytePadded; }
+    void SetDoubleBytePadded(const bool doubleBytePadded) noexcept
+    {
+        _Touch();
+        _doubleBytePadded = doubleBytePadded;
+    }
     bool WasDoubleBytePadded() const noexcept { return _doubleBytePadded; }
 
     const CharRow& GetCharRow() const noexcept { return _charRow; }
-    CharRow& GetCharRow() noexcept { return _charRow; }
+    CharRow& GetCharRow() noexcept
+    {
+        _Touch();
+        return _charRow;
+    }
 
     const ATTR_ROW& GetAttrRow() const noexcept { return _attrRow; }
-    ATTR_ROW& GetAttrRow() noexcept { return _attrRow; }
+    ATTR_ROW& GetAttrRow() noexcept
+    {
+        _Touch();
+        return _attrRow;
+    }
 
     LineRendition GetLineRendition() const noexcept { return _lineRendition; }
-    void SetLineRendition(const LineRendition lineRendition) noexcept { _lineRendition = lineRendition; }
+    void SetLineRendition(const LineRendition lineRendition) noexcept
+    {
+        _Touch();
+        _lineRendition = lineRendition;
+    }
 
     SHORT GetId() const noexcept { return _id; }
-    void SetId(const SHORT id) noexcept { _id = id; }
+    void SetId(const SHORT id) noexcept
+    {
+        _Touch();
+        _id = id;
+    }
+
+    // The revision changes whenever the row is (or may be) modified and is unique
+    // across all rows, which allows consumers to cache data derived from a row.
+    uint64_t GetRevision() const noexcept { return _revision; }
 
     bool Reset(const TextAttribute Attr);
     [[nodiscard]] HRESULT Resize(const unsigned short width);
@@ -82,6 +110,16 @@ private:
     // Occurs when the user runs out of text to support a double byte character and we're forced to the next line
     bool _doubleBytePadded;
     TextBuffer* _pParent; // non ownership pointer
+    uint64_t _revision;
+
+    static std::atomic<uint64_t> s_lastRevision;
+
+    // Anyone who gets mutable access to the contents might modify them,
+    // so this is called before handing out any such access.
+    void _Touch() noexcept
+    {
+        _revision = s_lastRevision.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
 };
 
 #ifdef UNIT_TESTING
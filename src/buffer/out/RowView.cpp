@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "RowView.hpp"
+
+// Routine Description:
+// - Constructs a cursor over the given attribute runs
+// Arguments:
+// - runs - The attribute runs of a row. They must cover every column of the row.
+RowView::AttrCursor::AttrCursor(const gsl::span<const TextAttributeRun> runs) noexcept :
+    _runs{ runs },
+    _index{ 0 },
+    _runBegin{ 0 }
+{
+}
+
+// Routine Description:
+// - Retrieves the attributes that apply to the given column
+// - Moving backwards restarts the search from the first run.
+// Arguments:
+// - column - The column to look up
+// Return Value:
+// - Reference to the attributes of the run containing the column
+const TextAttribute& RowView::AttrCursor::At(const size_t column) noexcept
+{
+    if (column < _runBegin)
+    {
+        _index = 0;
+        _runBegin = 0;
+    }
+
+    auto runEnd = _runBegin + til::at(_runs, _index).GetLength();
+    while (column >= runEnd && _index + 1 < _runs.size())
+    {
+        ++_index;
+        _runBegin = runEnd;
+        runEnd += til::at(_runs, _index).GetLength();
+    }
+
+    return til::at(_runs, _index).GetAttributes();
+}
+
+// Routine Description:
+// - Constructs a read-only view of the given row
+// Arguments:
+// - row - The row to view. It must outlive the view.
+RowView::RowView(const ROW& row) noexcept :
+    _row{ &row },
+    _cells{ row.GetCharRow()._data.data(), row.GetCharRow()._data.size() }
+{
+}
+
+// Routine Description:
+// - Returns the number of columns in the row
+size_t RowView::size() const noexcept
+{
+    return _cells.size();
+}
+
+// Routine Description:
+// - Returns the cells of the row, one per column. Each holds the character of
+//   the column and its DBCS attribute, which tells whether the column contains
+//   a narrow glyph or the leading or trailing half of a wide one.
+// - If a cell's DbcsAttribute reports IsGlyphStored(), its glyph consists of
+//   more than one character and must be retrieved with GlyphAt().
+gsl::span<const CharRowCell> RowView::Cells() const noexcept
+{
+    return _cells;
+}
+
+// Routine Description:
+// - Returns the run-length encoded attributes of the row. The runs are in
+//   column order and their lengths add up to the width of the row.
+gsl::span<const TextAttributeRun> RowView::AttrRuns() const noexcept
+{
+    const auto& runs = _row->GetAttrRow()._list;
+    return { runs.data(), runs.size() };
+}
+
+// Routine Description:
+// - Returns a cursor for looking up the attributes of individual columns
+RowView::AttrCursor RowView::Attrs() const noexcept
+{
+    return AttrCursor{ AttrRuns() };
+}
+
+// Routine Description:
+// - Retrieves the width information of the given column
+// Arguments:
+// - column - The column to look up
+// Return Value:
+// - Reference to the DBCS attribute of the column
+const DbcsAttribute& RowView::DbcsAttrAt(const size_t column) const
+{
+    return til::at(_cells, column).DbcsAttr();
+}
+
+// Routine Description:
+// - Retrieves the number of columns that the glyph at the given column covers,
+//   counting from that column. This is 2 for the leading half of a wide glyph
+//   and 1 otherwise, which matches OutputCellView::Columns().
+// Arguments:
+// - column - The column to look up
+size_t RowView::ColumnsAt(const size_t column) const
+{
+    return DbcsAttrAt(column).IsLeading() ? 2 : 1;
+}
+
+// Routine Description:
+// - Retrieves the text of the glyph at the given column. For the trailing
+//   half of a wide glyph this is the same text as for its leading half.
+// Arguments:
+// - column - The column to look up
+// Return Value:
+// - View of the text. It is valid until the row is modified.
+std::wstring_view RowView::GlyphAt(const size_t column) const
+{
+    const auto& cell = til::at(_cells, column);
+    if (cell.DbcsAttr().IsGlyphStored())
+    {
+        const auto& charRow = _row->GetCharRow();
+        const auto& text = charRow.GetUnicodeStorage().GetText(charRow.GetStorageKey(column));
+        return { text.data(), text.size() };
+    }
+    return { &cell.Char(), 1 };
+}
+
+// Routine Description:
+// - Retrieves the delimiter class of the glyph at the given column
+// - Used for double click selection and UIA word navigation.
+// Arguments:
+// - column - The column to look up
+// - wordDelimiters - The characters making up DelimiterClass::DelimiterChar
+// Return Value:
+// - The delimiter class of the glyph
+DelimiterClass RowView::DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const
+{
+    const auto glyph = GlyphAt(column).front();
+    if (glyph <= UNICODE_SPACE)
+    {
+        return DelimiterClass::ControlChar;
+    }
+    else if (wordDelimiters.find(glyph) != std::wstring_view::npos)
+    {
+        return DelimiterClass::DelimiterChar;
+    }
+    else
+    {
+        return DelimiterClass::RegularChar;
+    }
+}
@@ -0,0 +1,57 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- RowView.hpp
+
+Abstract:
+- Read-only view of the contents of a single ROW.
+- Exposes the cells of the row (characters and their DBCS width flags) as one
+  contiguous span and its attributes as the row's list of attribute runs.
+- Code that reads whole rows (rendering, searching, copying, word navigation)
+  should use this instead of TextBufferCellIterator, which bounds checks,
+  rebuilds an OutputCellView and steps through the attribute runs for every cell.
+- Like any reference into the buffer, a view is only valid until the row is modified.
+--*/
+
+#pragma once
+
+#include "Row.hpp"
+
+class RowView final
+{
+public:
+    // Looks up the attributes of a column in the attribute runs of a row.
+    // Successive lookups in ascending column order only ever step forward
+    // through the runs, instead of searching them from the start each time.
+    class AttrCursor final
+    {
+    public:
+        AttrCursor(const gsl::span<const TextAttributeRun> runs) noexcept;
+
+        const TextAttribute& At(const size_t column) noexcept;
+
+    private:
+        gsl::span<const TextAttributeRun> _runs;
+        size_t _index;
+        size_t _runBegin;
+    };
+
+    RowView(const ROW& row) noexcept;
+
+    size_t size() const noexcept;
+
+    gsl::span<const CharRowCell> Cells() const noexcept;
+    gsl::span<const TextAttributeRun> AttrRuns() const noexcept;
+    AttrCursor Attrs() const noexcept;
+
+    const DbcsAttribute& DbcsAttrAt(const size_t column) const;
+    size_t ColumnsAt(const size_t column) const;
+    std::wstring_view GlyphAt(const size_t column) const;
+    DelimiterClass DelimiterClassAt(const size_t column, const std::wstring_view wordDelimiters) const;
+
+private:
+    const ROW* _row;
+    gsl::span<const CharRowCell> _cells;
+};
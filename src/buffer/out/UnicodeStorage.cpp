@@ -40,6 +40,13 @@ void UnicodeStorage::Erase(const key_type key) noexcept
     _map.erase(key);
 }
 
+// Routine Description:
+// - erases all data from the storage
+void UnicodeStorage::Clear() noexcept
+{
+    _map.clear();
+}
+
 // Routine Description:
 // - Remaps all of the stored items to new coordinate positions
 //   based on a bulk rearrangement of row IDs and potential row width resize.
@@ -55,6 +55,8 @@ public:
 
     void Erase(const key_type key) noexcept;
 
+    void Clear() noexcept;
+
     void Remap(const std::unordered_map<SHORT, SHORT>& rowMap, const std::optional<SHORT> width);
 
 private:
@@ -194,11 +194,21 @@ bool Search::_FindNeedleInHaystackAt(const COORD pos, COORD& start, COORD& end)
 
     COORD bufferPos = pos;
 
+    // The needle usually lies within a single row, so we hold onto the one we're looking at.
+    const auto& textBuffer = _uiaData.GetTextBuffer();
+    auto row = textBuffer.GetRowViewByOffset(bufferPos.Y);
+    auto rowIndex = bufferPos.Y;
+
     for (const auto& needleCell : _needle)
     {
+        if (bufferPos.Y != rowIndex)
+        {
+            row = textBuffer.GetRowViewByOffset(bufferPos.Y);
+            rowIndex = bufferPos.Y;
+        }
+
         // Haystack is the buffer. Needle is the string we were given.
-        const auto hayIter = _uiaData.GetTextBuffer().GetTextDataAt(bufferPos);
-        const auto hayChars = *hayIter;
+        const auto hayChars = row.GlyphAt(bufferPos.X);
         const auto needleChars = std::wstring_view(needleCell.data(), needleCell.size());
 
         // If we didn't match at any point of the needle, return false.
@@ -39,16 +39,15 @@ TextBuffer::TextBuffer(const COORD screenBufferSize,
     _renderTarget{ renderTarget },
     _size{},
     _currentHyperlinkId{ 1 },
-    _currentPatternId{ 0 }
+    _currentPatternId{ 0 },
+    _blankRevision{ 0 },
+    _placeholderAttributes{ defaultAttributes }
 {
-    // initialize ROWs
+    // The ROWs are constructed on first access. Most rows of a large
+    // scrollback are never written to, so there's no need to pay for them up front.
     _storage.reserve(static_cast<size_t>(screenBufferSize.Y));
-    for (size_t i = 0; i < static_cast<size_t>(screenBufferSize.Y); ++i)
-    {
-        _storage.emplace_back(static_cast<SHORT>(i), screenBufferSize.X, _currentAttributes, this);
-    }
 
-    _UpdateSize();
+    _UpdateSize(screenBufferSize);
 }
 
 // Routine Description:
@@ -71,7 +70,52 @@ void TextBuffer::CopyProperties(const TextBuffer& OtherBuffer) noexcept
 // - Total number of rows in the buffer
 UINT TextBuffer::TotalRowCount() const noexcept
 {
-    return gsl::narrow<UINT>(_storage.size());
+    return gsl::narrow_cast<UINT>(_size.Height());
+}
+
+// Routine Description:
+// - Constructs the rows in _storage that haven't been accessed yet, up to the given count.
+// Arguments:
+// - count - The number of rows at the start of _storage that need to exist.
+// Return Value:
+// - <none>
+void TextBuffer::_MaterializeRows(const size_t count) const
+{
+    // Growing past the capacity would move the rows we've handed out references to.
+    FAIL_FAST_IF(count > _storage.capacity());
+
+    // The rows need a mutable parent, just like the ones we construct in non-const methods.
+    const auto parent = const_cast<TextBuffer*>(this);
+    const auto rowWidth = gsl::narrow_cast<unsigned short>(_size.Width());
+    while (_storage.size() < count)
+    {
+        _storage.emplace_back(gsl::narrow_cast<SHORT>(_storage.size()), rowWidth, _placeholderAttributes, parent);
+    }
+}
+
+// Routine Description:
+// - Retrieves a row by its index in _storage, constructing it if it doesn't exist yet.
+// Arguments:
+// - storageIndex - The index of the row in _storage.
+// Return Value:
+// - reference to the row.
+ROW& TextBuffer::_MaterializeRow(const size_t storageIndex) const
+{
+    _MaterializeRows(storageIndex + 1);
+    return _storage.at(storageIndex);
+}
+
+// Routine Description:
+// - Checks whether the row at the given offset was constructed. Rows that
+//   weren't are blank and filled with _placeholderAttributes.
+// Arguments:
+// - index - Number of rows down from the first row of the buffer.
+// Return Value:
+// - true if the row exists in _storage.
+bool TextBuffer::_IsRowMaterialized(const size_t index) const noexcept
+{
+    const size_t totalRows = TotalRowCount();
+    return totalRows != 0 && (_firstRow + index) % totalRows < _storage.size();
 }
 
 // Routine Description:
@@ -87,7 +131,7 @@ const ROW& TextBuffer::GetRowByOffset(const size_t index) const
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
-    return _storage.at(offsetIndex);
+    return _MaterializeRow(offsetIndex);
 }
 
 // Routine Description:
@@ -103,7 +147,19 @@ ROW& TextBuffer::GetRowByOffset(const size_t index)
 
     // Rows are stored circularly, so the index you ask for is offset by the start position and mod the total of rows.
     const size_t offsetIndex = (_firstRow + index) % totalRows;
-    return _storage.at(offsetIndex);
+    return _MaterializeRow(offsetIndex);
+}
+
+// Routine Description:
+// - Retrieves a read-only view of a row by its offset from the first row of the text buffer.
+// - Prefer this over the cell and text iterators when reading through many cells of a row.
+// Arguments:
+// - Number of rows down from the first row of the buffer.
+// Return Value:
+// - view of the requested row. It is valid until the row is modified.
+RowView TextBuffer::GetRowViewByOffset(const size_t index) const
+{
+    return RowView{ GetRowByOffset(index) };
 }
 
 // Routine Description:
@@ -558,8 +614,10 @@ bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
     // to the logical position 0 in the window (cursor coordinates and all other coordinates).
     _renderTarget.TriggerCircling();
 
-    // Prune hyperlinks to delete obsolete references
-    _PruneHyperlinks();
+    // Remember the hyperlinks in the old "first row", so that we can prune those
+    // that aren't referenced anywhere else anymore once it's been cleaned out.
+    auto& firstRow = _GetFirstRow();
+    const auto hyperlinks = firstRow.GetAttrRow().GetHyperlinks();
 
     // Second, clean out the old "first row" as it will become the "last row" of the buffer after the circle is performed.
     auto fillAttributes = _currentAttributes;
@@ -569,7 +627,8 @@ bool TextBuffer::IncrementCircularBuffer(const bool inVtMode)
         // the current background color, but with no meta attributes set.
         fillAttributes.SetStandardErase();
     }
-    const bool fSuccess = _storage.at(_firstRow).Reset(fillAttributes);
+    const bool fSuccess = firstRow.Reset(fillAttributes);
+    _PruneHyperlinks(hyperlinks);
     if (fSuccess)
     {
         // Now proceed to increment.
@@ -601,13 +660,21 @@ COORD TextBuffer::GetLastNonSpaceCharacter(std::optional<const Microsoft::Consol
 {
     const auto viewport = viewOptional.has_value() ? viewOptional.value() : GetSize();
 
+    // Rows that were never constructed are blank and don't need to be searched.
+    const auto measureRight = [this](const SHORT row) -> SHORT {
+        if (!_IsRowMaterialized(row))
+        {
+            return 0;
+        }
+        return gsl::narrow<short>(GetRowByOffset(row).GetCharRow().MeasureRight());
+    };
+
     COORD coordEndOfText = { 0 };
     // Search the given viewport by starting at the bottom.
     coordEndOfText.Y = viewport.BottomInclusive();
 
-    const auto& currRow = GetRowByOffset(coordEndOfText.Y);
     // The X position of the end of the valid text is the Right draw boundary (which is one beyond the final valid character)
-    coordEndOfText.X = gsl::narrow<short>(currRow.GetCharRow().MeasureRight()) - 1;
+    coordEndOfText.X = measureRight(coordEndOfText.Y) - 1;
 
     // If the X coordinate turns out to be -1, the row was empty, we need to search backwards for the real end of text.
     const auto viewportTop = viewport.Top();
@@ -615,10 +682,9 @@ COORD TextBuffer::GetLastNonSpaceCharacter(std::optional<const Microsoft::Consol
     while (fDoBackUp)
     {
         coordEndOfText.Y--;
-        const auto& backupRow = GetRowByOffset(coordEndOfText.Y);
         // We need to back up to the previous row if this line is empty, AND there are more rows
 
-        coordEndOfText.X = gsl::narrow<short>(backupRow.GetCharRow().MeasureRight()) - 1;
+        coordEndOfText.X = measureRight(coordEndOfText.Y) - 1;
         fDoBackUp = (coordEndOfText.X < 0 && coordEndOfText.Y > viewportTop);
     }
 
@@ -671,9 +737,9 @@ const Viewport TextBuffer::GetSize() const noexcept
     return _size;
 }
 
-void TextBuffer::_UpdateSize()
+void TextBuffer::_UpdateSize(const COORD dimensions)
 {
-    _size = Viewport::FromDimensions({ 0, 0 }, { gsl::narrow<SHORT>(_storage.at(0).size()), gsl::narrow<SHORT>(_storage.size()) });
+    _size = Viewport::FromDimensions({ 0, 0 }, dimensions);
 }
 
 void TextBuffer::_SetFirstRowIndex(const SHORT FirstRowIndex) noexcept
@@ -694,6 +760,9 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
     // To make this easier, first correct the circular buffer to have the first row be 0 again.
     if (_firstRow != 0)
     {
+        // The rotation moves every row, so they all need to exist.
+        _MaterializeRows(TotalRowCount());
+
         // Rotate the buffer to put the first row at the front.
         std::rotate(_storage.begin(), _storage.begin() + _firstRow, _storage.end());
 
@@ -701,6 +770,10 @@ void TextBuffer::ScrollRows(const SHORT firstRow, const SHORT size, const SHORT
         _firstRow = 0;
     }
 
+    // Only the rows up to the end of the affected region are moved.
+    // The ones after it can stay placeholders.
+    _MaterializeRows(static_cast<size_t>(firstRow) + size + std::max<SHORT>(delta, 0));
+
     // Rotate just the subsection specified
     if (delta < 0)
     {
@@ -839,6 +912,10 @@ void TextBuffer::ResetLineRenditionRange(const size_t startRow, const size_t end
 
 LineRendition TextBuffer::GetLineRendition(const size_t row) const
 {
+    if (!_IsRowMaterialized(row))
+    {
+        return LineRendition::SingleWidth;
+    }
     return GetRowByOffset(row).GetLineRendition();
 }
 
@@ -879,12 +956,105 @@ COORD TextBuffer::BufferToScreenPosition(const COORD position) const
 //   and the default current color attributes
 void TextBuffer::Reset()
 {
-    const auto attr = GetCurrentAttributes();
+    ClearRowsFrom(0, GetCurrentAttributes());
+}
+
+// Routine Description:
+// - Resets all rows from the given one to the end of the buffer to the
+//   default character and the given attributes.
+// - Rows are turned back into placeholders where possible. The cost depends on
+//   the number of rows that were in use and not on the size of the buffer.
+// Arguments:
+// - firstRow - Number of rows down from the first row of the buffer to start at.
+// - fillAttributes - The attributes to fill the rows with.
+// Return Value:
+// - <none>
+void TextBuffer::ClearRowsFrom(const size_t firstRow, const TextAttribute fillAttributes)
+{
+    const size_t totalRows = TotalRowCount();
+    if (firstRow >= totalRows)
+    {
+        return;
+    }
+
+    if (firstRow == 0)
+    {
+        // Every row is blank afterwards, so it doesn't matter which one comes first.
+        _firstRow = 0;
+        _storage.clear();
+        _placeholderAttributes = fillAttributes;
+    }
+    else if (_firstRow != 0)
+    {
+        // The cleared rows wrap around the end of _storage.
+        // This only happens once the buffer has circled, at which point
+        // all rows were in use anyways.
+        for (auto row = firstRow; row < totalRows; ++row)
+        {
+            GetRowByOffset(row).Reset(fillAttributes);
+        }
+    }
+    else
+    {
+        if (firstRow < _storage.size())
+        {
+            _storage.erase(_storage.begin() + firstRow, _storage.end());
+        }
+        else if (fillAttributes != _placeholderAttributes)
+        {
+            // The placeholders before the first row keep their attributes.
+            _MaterializeRows(firstRow);
+        }
+        _placeholderAttributes = fillAttributes;
+    }
+
+    const auto width = GetSize().Width();
+    _NotifyPaint(Viewport::FromDimensions({ 0, gsl::narrow<SHORT>(firstRow) }, width, gsl::narrow<SHORT>(totalRows - firstRow)));
+}
+
+// Routine Description:
+// - Returns this buffer to the state it was constructed in, so that it can be
+//   reused instead of being reallocated. The size of the buffer is retained.
+// - Rows that haven't been modified since the previous call with the same
+//   attributes are still blank and are skipped, which keeps this cheap for
+//   buffers that were only partially written to.
+// Arguments:
+// - defaultAttributes - the attributes to fill the buffer with
+// - cursorSize - the height of the cursor
+// Return Value:
+// - <none>
+// Note: may throw exception
+void TextBuffer::Reinitialize(const TextAttribute defaultAttributes, const UINT cursorSize)
+{
+    const bool canSkipRows = _blankAttributes == defaultAttributes;
+    uint64_t blankRevision = 0;
 
+    // The rows keep their place in the circular buffer. They're all blank
+    // afterwards, so it doesn't matter which one of them comes first.
     for (auto& row : _storage)
     {
-        row.Reset(attr);
+        if (!canSkipRows || row.GetRevision() > _blankRevision)
+        {
+            THROW_HR_IF(E_OUTOFMEMORY, !row.Reset(defaultAttributes));
+        }
+        blankRevision = std::max(blankRevision, row.GetRevision());
     }
+
+    _blankRevision = blankRevision;
+    _blankAttributes = defaultAttributes;
+    _placeholderAttributes = defaultAttributes;
+
+    _currentAttributes = defaultAttributes;
+    _cursor.Reinitialize(cursorSize);
+    _unicodeStorage.Clear();
+
+    // All rows were reset, so no hyperlink is referenced anymore.
+    _hyperlinkMap.clear();
+    _hyperlinkCustomIdMap.clear();
+    _currentHyperlinkId = 1;
+
+    _idsAndPatterns.clear();
+    _currentPatternId = 0;
 }
 
 // Routine Description:
@@ -910,6 +1080,11 @@ void TextBuffer::Reset()
         const SHORT TopRowIndex = (GetFirstRowIndex() + TopRow) % currentSize.Y;
 
         // rotate rows until the top row is at index 0
+        if (TopRowIndex != 0)
+        {
+            // The rotation moves every row, so they all need to exist.
+            _MaterializeRows(currentSize.Y);
+        }
         for (int i = 0; i < TopRowIndex; i++)
         {
             _storage.emplace_back(std::move(_storage.front()));
@@ -925,10 +1100,14 @@ void TextBuffer::Reset()
             _storage.pop_back();
         }
         // add rows if we're growing
-        while (_storage.size() < static_cast<size_t>(newSize.Y))
+        // They're placeholders until they're used, which is only possible
+        // if the placeholders we already have use the same attributes.
+        if (newSize.Y > currentSize.Y && attributes != _placeholderAttributes)
         {
-            _storage.emplace_back(static_cast<short>(_storage.size()), newSize.X, attributes, this);
+            _MaterializeRows(currentSize.Y);
+            _placeholderAttributes = attributes;
         }
+        _storage.reserve(static_cast<size_t>(newSize.Y));
 
         // Now that we've tampered with the row placement, refresh all the row IDs.
         // Also take advantage of the row ID refresh loop to resize the rows in the X dimension
@@ -936,7 +1115,7 @@ void TextBuffer::Reset()
         _RefreshRowIDs(newSize.X);
 
         // Update the cached size value
-        _UpdateSize();
+        _UpdateSize(newSize);
     }
     CATCH_RETURN();
 
@@ -1023,7 +1202,7 @@ ROW& TextBuffer::_GetPrevRowNoWrap(const ROW& Row)
     }
 
     THROW_HR_IF(E_FAIL, Row.GetId() == _firstRow);
-    return _storage.at(prevRowIndex);
+    return _MaterializeRow(prevRowIndex);
 }
 
 // Method Description:
@@ -1047,7 +1226,7 @@ Microsoft::Console::Render::IRenderTarget& TextBuffer::GetRenderTarget() noexcep
 // - the delimiter class for the given char
 const DelimiterClass TextBuffer::_GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const
 {
-    return GetRowByOffset(pos.Y).GetCharRow().DelimiterClassAt(pos.X, wordDelimiters);
+    return GetRowViewByOffset(pos.Y).DelimiterClassAt(pos.X, wordDelimiters);
 }
 
 // Method Description:
@@ -1152,24 +1331,26 @@ const COORD TextBuffer::_GetWordStartForAccessibility(const COORD target, const
 // - The COORD for the first character on the current word or delimiter run (stopped by the left margin)
 const COORD TextBuffer::_GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const
 {
-    COORD result = target;
-    const auto bufferSize = GetSize();
+    // This never leaves the row, so we can look at its cells directly.
+    const auto row = GetRowViewByOffset(target.Y);
+    const auto left = gsl::narrow_cast<size_t>(GetSize().Left());
+    auto column = gsl::narrow_cast<size_t>(target.X);
 
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+    const auto initialDelimiter = row.DelimiterClassAt(column, wordDelimiters);
 
     // expand left until we hit the left boundary or a different delimiter class
-    while (result.X > bufferSize.Left() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
+    while (column > left && row.DelimiterClassAt(column, wordDelimiters) == initialDelimiter)
     {
-        bufferSize.DecrementInBounds(result);
+        --column;
     }
 
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    if (row.DelimiterClassAt(column, wordDelimiters) != initialDelimiter)
     {
         // move off of delimiter
-        bufferSize.IncrementInBounds(result);
+        ++column;
     }
 
-    return result;
+    return { gsl::narrow_cast<SHORT>(column), target.Y };
 }
 
 // Method Description:
@@ -1277,66 +1458,45 @@ const COORD TextBuffer::_GetWordEndForSelection(const COORD target, const std::w
         return target;
     }
 
-    COORD result = target;
-    const auto initialDelimiter = _GetDelimiterClassAt(result, wordDelimiters);
+    // This never leaves the row, so we can look at its cells directly.
+    const auto row = GetRowViewByOffset(target.Y);
+    const auto right = gsl::narrow_cast<size_t>(bufferSize.RightInclusive());
+    auto column = gsl::narrow_cast<size_t>(target.X);
+
+    const auto initialDelimiter = row.DelimiterClassAt(column, wordDelimiters);
 
     // expand right until we hit the right boundary or a different delimiter class
-    while (result.X < bufferSize.RightInclusive() && (_GetDelimiterClassAt(result, wordDelimiters) == initialDelimiter))
+    while (column < right && row.DelimiterClassAt(column, wordDelimiters) == initialDelimiter)
     {
-        bufferSize.IncrementInBounds(result);
+        ++column;
     }
 
-    if (_GetDelimiterClassAt(result, wordDelimiters) != initialDelimiter)
+    if (row.DelimiterClassAt(column, wordDelimiters) != initialDelimiter)
     {
         // move off of delimiter
-        bufferSize.DecrementInBounds(result);
+        --column;
     }
 
-    return result;
+    return { gsl::narrow_cast<SHORT>(column), target.Y };
 }
 
-void TextBuffer::_PruneHyperlinks()
+// Routine Description:
+// - Removes the given hyperlinks from our maps, unless they're still referenced
+//   somewhere in the buffer. This way, obsolete hyperlink references are cleared
+//   from our hyperlink map instead of hanging around.
+// - The rows keep _hyperlinkRefCounts up to date, so this doesn't need to
+//   search the rest of the buffer.
+// Arguments:
+// - hyperlinks - The IDs of the hyperlinks that might have become obsolete.
+// Return Value:
+// - <none>
+void TextBuffer::_PruneHyperlinks(const std::vector<uint16_t>& hyperlinks) noexcept
 {
-    // Check the old first row for hyperlink references
-    // If there are any, search the entire buffer for the same reference
-    // If the buffer does not contain the same reference, we can remove that hyperlink from our map
-    // This way, obsolete hyperlink references are cleared from our hyperlink map instead of hanging around
-    // Get all the hyperlink references in the row we're erasing
-    const auto hyperlinks = _storage.at(_firstRow).GetAttrRow().GetHyperlinks();
-
-    if (!hyperlinks.empty())
+    for (const auto id : hyperlinks)
     {
-        // Move to unordered set so we can use hashed lookup of IDs instead of linear search.
-        // Only make it an unordered set now because set always heap allocates but vector
-        // doesn't when the set is empty (saving an allocation in the common case of no links.)
-        std::unordered_set<uint16_t> firstRowRefs{ hyperlinks.cbegin(), hyperlinks.cend() };
-
-        const auto total = TotalRowCount();
-        // Loop through all the rows in the buffer except the first row -
-        // we have found all hyperlink references in the first row and put them in refs,
-        // now we need to search the rest of the buffer (i.e. all the rows except the first)
-        // to see if those references are anywhere else
-        for (size_t i = 1; i != total; ++i)
-        {
-            const auto nextRowRefs = GetRowByOffset(i).GetAttrRow().GetHyperlinks();
-            for (auto id : nextRowRefs)
-            {
-                if (firstRowRefs.find(id) != firstRowRefs.end())
-                {
-                    firstRowRefs.erase(id);
-                }
-            }
-            if (firstRowRefs.empty())
-            {
-                // No more hyperlink references left to search for, terminate early
-                break;
-            }
-        }
-
-        // Now delete obsolete references from our map
-        for (auto hyperlinkReference : firstRowRefs)
+        if (!_hyperlinkRefCounts.IsReferenced(id))
         {
-            RemoveHyperlinkFromMap(hyperlinkReference);
+            RemoveHyperlinkFromMap(id);
         }
     }
 }
@@ -1406,7 +1566,7 @@ const til::point TextBuffer::GetGlyphStart(const til::point pos) const
         bufferSize.DecrementInBounds(resultPos, true);
     }
 
-    if (resultPos != bufferSize.EndExclusive() && GetCellDataAt(resultPos)->DbcsAttr().IsTrailing())
+    if (resultPos != bufferSize.EndExclusive() && GetRowViewByOffset(resultPos.Y).DbcsAttrAt(resultPos.X).IsTrailing())
     {
         bufferSize.DecrementInBounds(resultPos, true);
     }
@@ -1425,7 +1585,7 @@ const til::point TextBuffer::GetGlyphEnd(const til::point pos) const
     COORD resultPos = pos;
 
     const auto bufferSize = GetSize();
-    if (resultPos != bufferSize.EndExclusive() && GetCellDataAt(resultPos)->DbcsAttr().IsLeading())
+    if (resultPos != bufferSize.EndExclusive() && GetRowViewByOffset(resultPos.Y).DbcsAttrAt(resultPos.X).IsLeading())
     {
         bufferSize.IncrementInBounds(resultPos, true);
     }
@@ -1456,7 +1616,7 @@ bool TextBuffer::MoveToNextGlyph(til::point& pos, bool allowBottomExclusive) con
 
     // try to move. If we can't, we're done.
     const bool success = bufferSize.IncrementInBounds(resultPos, allowBottomExclusive);
-    if (resultPos != bufferSize.EndExclusive() && GetCellDataAt(resultPos)->DbcsAttr().IsTrailing())
+    if (resultPos != bufferSize.EndExclusive() && GetRowViewByOffset(resultPos.Y).DbcsAttrAt(resultPos.X).IsTrailing())
     {
         bufferSize.IncrementInBounds(resultPos, allowBottomExclusive);
     }
@@ -1479,7 +1639,7 @@ bool TextBuffer::MoveToPreviousGlyph(til::point& pos) const
     // try to move. If we can't, we're done.
     const auto bufferSize = GetSize();
     const bool success = bufferSize.DecrementInBounds(resultPos, true);
-    if (resultPos != bufferSize.EndExclusive() && GetCellDataAt(resultPos)->DbcsAttr().IsLeading())
+    if (resultPos != bufferSize.EndExclusive() && GetRowViewByOffset(resultPos.Y).DbcsAttrAt(resultPos.X).IsLeading())
     {
         bufferSize.DecrementInBounds(resultPos, true);
     }
@@ -1488,6 +1648,71 @@ bool TextBuffer::MoveToPreviousGlyph(til::point& pos) const
     return success;
 }
 
+// Method Description:
+// - Moves pos by count glyphs: forwards if count is positive, backwards otherwise.
+//   This is equivalent to calling MoveToNextGlyph/MoveToPreviousGlyph count times,
+//   but reads the DBCS attributes straight out of each row instead of constructing
+//   a cell iterator per step, so that large moves (e.g. by accessibility clients)
+//   stay cheap.
+// Arguments:
+// - pos - the position to move from. Updated to the resulting position.
+// - count - the number of glyphs to move
+// - allowBottomExclusive - allow the nonexistent end-of-buffer cell to be encountered
+// Return Value:
+// - the number of glyphs actually moved (negative when moving backwards)
+int TextBuffer::MoveByGlyphs(til::point& pos, const int count, const bool allowBottomExclusive) const
+{
+    const auto bufferSize = GetSize();
+    const ptrdiff_t width = bufferSize.Width();
+    const ptrdiff_t endExclusive = width * bufferSize.Height();
+
+    // Consecutive steps almost always land on the same row,
+    // so we hold on to the last row we looked at.
+    const CharRow* charRow = nullptr;
+    ptrdiff_t charRowIndex = -1;
+    const auto dbcsAttrAt = [&](const ptrdiff_t index) -> const DbcsAttribute& {
+        const auto rowIndex = index / width;
+        if (rowIndex != charRowIndex)
+        {
+            charRow = &GetRowByOffset(gsl::narrow_cast<size_t>(rowIndex)).GetCharRow();
+            charRowIndex = rowIndex;
+        }
+        return charRow->DbcsAttrAt(gsl::narrow_cast<size_t>(index % width));
+    };
+
+    auto index = pos.y() * width + pos.x();
+    int moved = 0;
+
+    if (count > 0)
+    {
+        const auto last = allowBottomExclusive ? endExclusive : endExclusive - 1;
+        while (moved < count && index < last)
+        {
+            ++index;
+            if (index != endExclusive && index < last && dbcsAttrAt(index).IsTrailing())
+            {
+                ++index;
+            }
+            ++moved;
+        }
+    }
+    else
+    {
+        while (moved > count && index > 0)
+        {
+            --index;
+            if (index > 0 && dbcsAttrAt(index).IsLeading())
+            {
+                --index;
+            }
+            --moved;
+        }
+    }
+
+    pos = til::point{ index % width, index / width };
+    return moved;
+}
+
 // Method Description:
 // - Determines the line-by-line rectangles based on two COORDs
 // - expands the rectangles to support wide glyphs
@@ -1563,7 +1788,7 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
 
     // expand left side of rect
     COORD targetPoint{ textRow.Left, textRow.Top };
-    if (GetCellDataAt(targetPoint)->DbcsAttr().IsTrailing())
+    if (GetRowViewByOffset(targetPoint.Y).DbcsAttrAt(targetPoint.X).IsTrailing())
     {
         if (targetPoint.X == bufferSize.Left())
         {
@@ -1578,7 +1803,7 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
 
     // expand right side of rect
     targetPoint = { textRow.Right, textRow.Bottom };
-    if (GetCellDataAt(targetPoint)->DbcsAttr().IsLeading())
+    if (GetRowViewByOffset(targetPoint.Y).DbcsAttrAt(targetPoint.X).IsLeading())
     {
         if (targetPoint.X == bufferSize.RightInclusive())
         {
@@ -1592,6 +1817,28 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
     }
 }
 
+// Routine Description:
+// - Concatenates all rows of text into a single string, ready to be placed
+//   on the clipboard as CF_UNICODETEXT.
+// Return Value:
+// - The text of all rows.
+std::wstring TextBuffer::TextAndColor::JoinText() const
+{
+    size_t length = 0;
+    for (const auto& row : text)
+    {
+        length += row.size();
+    }
+
+    std::wstring joined;
+    joined.reserve(length);
+    for (const auto& row : text)
+    {
+        joined.append(row);
+    }
+    return joined;
+}
+
 // Routine Description:
 // - Retrieves the text data from the selected region and presents it in a clipboard-ready format (given little post-processing).
 // Arguments:
@@ -1601,7 +1848,8 @@ void TextBuffer::_ExpandTextRow(SMALL_RECT& textRow) const
 // - GetAttributeColors - function used to map TextAttribute to RGB COLORREFs. If null, only extract the text.
 // - formatWrappedRows - if set we will apply formatting (CRLF inclusion and whitespace trimming) on wrapped rows
 // Return Value:
-// - The text, background color, and foreground color data of the selected region of the text buffer.
+// - The text of the selected region of the text buffer, and the runs of
+//   foreground and background colors covering it (if requested).
 const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
                                                    const bool trimTrailingWhitespace,
                                                    const std::vector<SMALL_RECT>& selectionRects,
@@ -1614,11 +1862,40 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
     // preallocate our vectors to reduce reallocs
     size_t const rows = selectionRects.size();
     data.text.reserve(rows);
-    if (copyTextColor)
-    {
-        data.FgAttr.reserve(rows);
-        data.BkAttr.reserve(rows);
-    }
+
+    // Appends `length` characters with the given colors to the list of runs,
+    // extending the last run instead if its colors match.
+    const auto appendRun = [&](const size_t length, const COLORREF fg, const COLORREF bk) {
+        auto& runs = data.colorRuns;
+        if (!runs.empty() && runs.back().fg == fg && runs.back().bk == bk)
+        {
+            runs.back().length += length;
+        }
+        else
+        {
+            runs.push_back({ length, fg, bk });
+        }
+    };
+
+    // Removes `length` characters from the end of the list of runs.
+    const auto trimRuns = [&](size_t length) noexcept {
+        auto& runs = data.colorRuns;
+        while (length != 0 && !runs.empty())
+        {
+            const auto trimmed = std::min(length, runs.back().length);
+            runs.back().length -= trimmed;
+            length -= trimmed;
+            if (runs.back().length == 0)
+            {
+                runs.pop_back();
+            }
+        }
+    };
+
+    // GetAttributeColors is comparatively expensive, so we only call it
+    // when the attribute actually changes, which is rare within a row.
+    std::optional<TextAttribute> lastAttr;
+    std::pair<COLORREF, COLORREF> lastColors{};
 
     // for each row in the selection
     for (UINT i = 0; i < rows; i++)
@@ -1627,45 +1904,39 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
 
         const Viewport highlight = Viewport::FromInclusive(selectionRects.at(i));
 
-        // retrieve the data from the screen buffer
-        auto it = GetCellDataAt(highlight.Origin(), highlight);
-
         // allocate a string buffer
         std::wstring selectionText;
-        std::vector<COLORREF> selectionFgAttr;
-        std::vector<COLORREF> selectionBkAttr;
 
         // preallocate to avoid reallocs
         selectionText.reserve(gsl::narrow<size_t>(highlight.Width()) + 2); // + 2 for \r\n if we munged it
-        if (copyTextColor)
-        {
-            selectionFgAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
-            selectionBkAttr.reserve(gsl::narrow<size_t>(highlight.Width()) + 2);
-        }
 
         // copy char data into the string buffer, skipping trailing bytes
-        while (it)
+        for (auto y = highlight.Top(); y < highlight.BottomExclusive(); ++y)
         {
-            const auto& cell = *it;
+            const auto row = GetRowViewByOffset(y);
+            auto attrs = row.Attrs();
 
-            if (!cell.DbcsAttr().IsTrailing())
+            for (auto x = gsl::narrow_cast<size_t>(highlight.Left()); x < gsl::narrow_cast<size_t>(highlight.RightExclusive()); ++x)
             {
-                selectionText.append(cell.Chars());
+                if (row.DbcsAttrAt(x).IsTrailing())
+                {
+                    continue;
+                }
+
+                const auto chars = row.GlyphAt(x);
+                selectionText.append(chars);
 
                 if (copyTextColor)
                 {
-                    const auto cellData = cell.TextAttr();
-                    const auto [CellFgAttr, CellBkAttr] = GetAttributeColors(cellData);
-                    for (const wchar_t wch : cell.Chars())
+                    const auto& cellAttr = attrs.At(x);
+                    if (!lastAttr.has_value() || *lastAttr != cellAttr)
                     {
-                        selectionFgAttr.push_back(CellFgAttr);
-                        selectionBkAttr.push_back(CellBkAttr);
+                        lastAttr = cellAttr;
+                        lastColors = GetAttributeColors(cellAttr);
                     }
+                    appendRun(chars.size(), lastColors.first, lastColors.second);
                 }
             }
-#pragma warning(suppress : 26444)
-            // TODO GH 2675: figure out why there's custom construction/destruction happening here
-            it++;
         }
 
         // We apply formatting to rows if the row was NOT wrapped or formatting of wrapped rows is allowed
@@ -1676,15 +1947,13 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
             if (shouldFormatRow)
             {
                 // remove the spaces at the end (aka trim the trailing whitespace)
-                while (!selectionText.empty() && selectionText.back() == UNICODE_SPACE)
+                const auto lastNonSpace = selectionText.find_last_not_of(UNICODE_SPACE);
+                const auto trimmedLength = lastNonSpace == std::wstring::npos ? 0 : lastNonSpace + 1;
+                if (copyTextColor)
                 {
-                    selectionText.pop_back();
-                    if (copyTextColor)
-                    {
-                        selectionFgAttr.pop_back();
-                        selectionBkAttr.pop_back();
-                    }
+                    trimRuns(selectionText.size() - trimmedLength);
                 }
+                selectionText.resize(trimmedLength);
             }
         }
 
@@ -1700,27 +1969,68 @@ const TextBuffer::TextAndColor TextBuffer::GetText(const bool includeCRLF,
 
                 if (copyTextColor)
                 {
-                    // cant see CR/LF so just use black FG & BK
-                    COLORREF const Blackness = RGB(0x00, 0x00, 0x00);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionFgAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
-                    selectionBkAttr.push_back(Blackness);
+                    // CR/LF can't be seen, so they just join the preceding run.
+                    // If there is none, use black FG & BK.
+                    if (data.colorRuns.empty())
+                    {
+                        COLORREF const Blackness = RGB(0x00, 0x00, 0x00);
+                        appendRun(2, Blackness, Blackness);
+                    }
+                    else
+                    {
+                        data.colorRuns.back().length += 2;
+                    }
                 }
             }
         }
 
         data.text.emplace_back(std::move(selectionText));
-        if (copyTextColor)
-        {
-            data.FgAttr.emplace_back(std::move(selectionFgAttr));
-            data.BkAttr.emplace_back(std::move(selectionBkAttr));
-        }
     }
 
     return data;
 }
 
+// Routine Description:
+// - Walks the rows of the given text and color data, splitting each row into
+//   spans of uniform color. CR and LF (and everything after them) are not
+//   reported, as they are not part of the visible text of a row.
+// Arguments:
+// - rows - the text and color data to walk
+// - onRow - called with the index of each row, before any of its spans
+// - onSpan - called with the text and the color run of each span
+template<typename TRowFn, typename TSpanFn>
+void TextBuffer::_WalkColorSpans(const TextAndColor& rows, TRowFn&& onRow, TSpanFn&& onSpan)
+{
+    auto run = rows.colorRuns.begin();
+    const auto runEnd = rows.colorRuns.end();
+    size_t runRemaining = run != runEnd ? run->length : 0;
+
+    for (size_t row = 0; row < rows.text.size(); ++row)
+    {
+        onRow(row);
+
+        const std::wstring_view rowText{ til::at(rows.text, row) };
+        const auto printableLength = std::min(rowText.find_first_of(L"\r\n"), rowText.size());
+
+        size_t offset = 0;
+        while (offset < rowText.size() && run != runEnd)
+        {
+            const auto length = std::min(runRemaining, rowText.size() - offset);
+            if (offset < printableLength && length != 0)
+            {
+                onSpan(rowText.substr(offset, std::min(length, printableLength - offset)), *run);
+            }
+
+            offset += length;
+            runRemaining -= length;
+            if (runRemaining == 0 && ++run != runEnd)
+            {
+                runRemaining = run->length;
+            }
+        }
+    }
+}
+
 // Routine Description:
 // - Generates a CF_HTML compliant structure based on the passed in text and color data
 // Arguments:
@@ -1737,171 +2047,119 @@ std::string TextBuffer::GenHTML(const TextAndColor& rows,
 {
     try
     {
-        std::ostringstream htmlBuilder;
+        // once filled with values, there will be exactly 157 bytes in the clipboard header
+        constexpr size_t ClipboardHeaderSize = 157;
 
         // First we have to add some standard
         // HTML boiler plate required for CF_HTML
         // as part of the HTML Clipboard format
-        const std::string htmlHeader =
-            "<!DOCTYPE><HTML><HEAD></HEAD><BODY>";
-        htmlBuilder << htmlHeader;
+        constexpr std::string_view HtmlHeader = "<!DOCTYPE><HTML><HEAD></HEAD><BODY>";
+        constexpr std::string_view HtmlFooter = "</BODY></HTML>";
+
+        // The clipboard header is written last, once we know all the offsets.
+        // We leave room for it at the start of the buffer, so that the final
+        // string doesn't need to be assembled from two separate ones.
+        std::string html(ClipboardHeaderSize, '\0');
+        html.reserve(ClipboardHeaderSize + rows.colorRuns.size() * 64 + rows.text.size() * 84);
+        auto out = std::back_inserter(html);
 
-        htmlBuilder << "<!--StartFragment -->";
+        html.append(HtmlHeader);
+        html.append("<!--StartFragment -->");
 
         // apply global style in div element
-        {
-            htmlBuilder << "<DIV STYLE=\"";
-            htmlBuilder << "display:inline-block;";
-            htmlBuilder << "white-space:pre;";
-
-            htmlBuilder << "background-color:";
-            htmlBuilder << Utils::ColorToHexString(backgroundColor);
-            htmlBuilder << ";";
-
-            htmlBuilder << "font-family:";
-            htmlBuilder << "'";
-            htmlBuilder << ConvertToA(CP_UTF8, fontFaceName);
-            htmlBuilder << "',";
-            // even with different font, add monospace as fallback
-            htmlBuilder << "monospace;";
-
-            htmlBuilder << "font-size:";
-            htmlBuilder << fontHeightPoints;
-            htmlBuilder << "pt;";
-
-            // note: MS Word doesn't support padding (in this way at least)
-            htmlBuilder << "padding:";
-            htmlBuilder << 4; // todo: customizable padding
-            htmlBuilder << "px;";
-
-            htmlBuilder << "\">";
-        }
+        // note: MS Word doesn't support padding (in this way at least)
+        // todo: customizable padding
+        fmt::format_to(out,
+                       FMT_COMPILE("<DIV STYLE=\"display:inline-block;white-space:pre;background-color:{};font-family:'{}',monospace;font-size:{}pt;padding:4px;\">"),
+                       Utils::ColorToHexString(backgroundColor),
+                       ConvertToA(CP_UTF8, fontFaceName),
+                       fontHeightPoints);
 
         // copy text and info color from buffer
         bool hasWrittenAnyText = false;
-        std::optional<COLORREF> fgColor = std::nullopt;
-        std::optional<COLORREF> bkColor = std::nullopt;
-        for (size_t row = 0; row < rows.text.size(); row++)
-        {
-            size_t startOffset = 0;
-
-            if (row != 0)
-            {
-                htmlBuilder << "<BR>";
-            }
+        std::optional<std::pair<COLORREF, COLORREF>> lastColors;
+        std::string utf8;
 
-            for (size_t col = 0; col < rows.text.at(row).length(); col++)
-            {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto unescapedText = ConvertToA(CP_UTF8, std::wstring_view(rows.text.at(row)).substr(startOffset, col - startOffset + includeCurrent));
-                        for (const auto c : unescapedText)
-                        {
-                            switch (c)
-                            {
-                            case '<':
-                                htmlBuilder << "&lt;";
-                                break;
-                            case '>':
-                                htmlBuilder << "&gt;";
-                                break;
-                            case '&':
-                                htmlBuilder << "&amp;";
-                                break;
-                            default:
-                                htmlBuilder << c;
-                            }
-                        }
-
-                        startOffset = col;
-                    }
-                };
-
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
-                {
-                    // do not include \r nor \n as they don't have color attributes
-                    // and are not HTML friendly. For line break use '<BR>' instead.
-                    writeAccumulatedChars(false);
-                    break;
-                }
-
-                bool colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
+        _WalkColorSpans(
+            rows,
+            [&](const size_t row) {
+                if (row != 0)
                 {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
+                    html.append("<BR>");
                 }
-
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
+            },
+            [&](const std::wstring_view text, const TextAndColor::ColorRun& colors) {
+                if (!lastColors.has_value() || lastColors->first != colors.fg || lastColors->second != colors.bk)
                 {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
-                }
-
-                if (colorChanged)
-                {
-                    writeAccumulatedChars(false);
+                    lastColors.emplace(colors.fg, colors.bk);
 
                     if (hasWrittenAnyText)
                     {
-                        htmlBuilder << "</SPAN>";
+                        html.append("</SPAN>");
                     }
 
-                    htmlBuilder << "<SPAN STYLE=\"";
-                    htmlBuilder << "color:";
-                    htmlBuilder << Utils::ColorToHexString(fgColor.value());
-                    htmlBuilder << ";";
-                    htmlBuilder << "background-color:";
-                    htmlBuilder << Utils::ColorToHexString(bkColor.value());
-                    htmlBuilder << ";";
-                    htmlBuilder << "\">";
+                    fmt::format_to(out,
+                                   FMT_COMPILE("<SPAN STYLE=\"color:{};background-color:{};\">"),
+                                   Utils::ColorToHexString(colors.fg),
+                                   Utils::ColorToHexString(colors.bk));
                 }
 
                 hasWrittenAnyText = true;
 
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
+                THROW_IF_FAILED(til::u16u8(text, utf8));
+                for (const auto c : utf8)
                 {
-                    writeAccumulatedChars(true);
+                    switch (c)
+                    {
+                    case '<':
+                        html.append("&lt;");
+                        break;
+                    case '>':
+                        html.append("&gt;");
+                        break;
+                    case '&':
+                        html.append("&amp;");
+                        break;
+                    default:
+                        html.push_back(c);
+                    }
                 }
-            }
-        }
+            });
 
         if (hasWrittenAnyText)
         {
             // last opened span wasn't closed in loop above, so close it now
-            htmlBuilder << "</SPAN>";
+            html.append("</SPAN>");
         }
 
-        htmlBuilder << "</DIV>";
-
-        htmlBuilder << "<!--EndFragment -->";
-
-        constexpr std::string_view HtmlFooter = "</BODY></HTML>";
-        htmlBuilder << HtmlFooter;
-
-        // once filled with values, there will be exactly 157 bytes in the clipboard header
-        constexpr size_t ClipboardHeaderSize = 157;
+        html.append("</DIV>");
+        html.append("<!--EndFragment -->");
+        html.append(HtmlFooter);
 
         // these values are byte offsets from start of clipboard
         const size_t htmlStartPos = ClipboardHeaderSize;
-        const size_t htmlEndPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlBuilder.tellp());
-        const size_t fragStartPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlHeader.length());
-        const size_t fragEndPos = htmlEndPos - HtmlFooter.length();
+        const size_t htmlEndPos = html.size();
+        const size_t fragStartPos = ClipboardHeaderSize + HtmlHeader.size();
+        const size_t fragEndPos = htmlEndPos - HtmlFooter.size();
 
         // header required by HTML 0.9 format
-        std::ostringstream clipHeaderBuilder;
-        clipHeaderBuilder << "Version:0.9\r\n";
-        clipHeaderBuilder << std::setfill('0');
-        clipHeaderBuilder << "StartHTML:" << std::setw(10) << htmlStartPos << "\r\n";
-        clipHeaderBuilder << "EndHTML:" << std::setw(10) << htmlEndPos << "\r\n";
-        clipHeaderBuilder << "StartFragment:" << std::setw(10) << fragStartPos << "\r\n";
-        clipHeaderBuilder << "EndFragment:" << std::setw(10) << fragEndPos << "\r\n";
-        clipHeaderBuilder << "StartSelection:" << std::setw(10) << fragStartPos << "\r\n";
-        clipHeaderBuilder << "EndSelection:" << std::setw(10) << fragEndPos << "\r\n";
-
-        return clipHeaderBuilder.str() + htmlBuilder.str();
+        const auto clipHeader = fmt::format(FMT_COMPILE("Version:0.9\r\n"
+                                                        "StartHTML:{:010}\r\n"
+                                                        "EndHTML:{:010}\r\n"
+                                                        "StartFragment:{:010}\r\n"
+                                                        "EndFragment:{:010}\r\n"
+                                                        "StartSelection:{:010}\r\n"
+                                                        "EndSelection:{:010}\r\n"),
+                                            htmlStartPos,
+                                            htmlEndPos,
+                                            fragStartPos,
+                                            fragEndPos,
+                                            fragStartPos,
+                                            fragEndPos);
+        THROW_HR_IF(E_UNEXPECTED, clipHeader.size() != ClipboardHeaderSize);
+        html.replace(0, ClipboardHeaderSize, clipHeader);
+
+        return html;
     }
     catch (...)
     {
@@ -1925,22 +2183,6 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
 {
     try
     {
-        std::ostringstream rtfBuilder;
-
-        // start rtf
-        rtfBuilder << "{";
-
-        // Standard RTF header.
-        // This is similar to the header generated by WordPad.
-        // \ansi - specifies that the ANSI char set is used in the current doc
-        // \ansicpg1252 - represents the ANSI code page which is used to perform the Unicode to ANSI conversion when writing RTF text
-        // \deff0 - specifies that the default font for the document is the one at index 0 in the font table
-        // \nouicompat - ?
-        rtfBuilder << "\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat";
-
-        // font table
-        rtfBuilder << "{\\fonttbl{\\f0\\fmodern\\fcharset0 " << ConvertToA(CP_UTF8, fontFaceName) << ";}}";
-
         // map to keep track of colors:
         // keys are colors represented by COLORREF
         // values are indices of the corresponding colors in the color table
@@ -1948,145 +2190,101 @@ std::string TextBuffer::GenRTF(const TextAndColor& rows, const int fontHeightPoi
         int nextColorIndex = 1; // leave 0 for the default color and start from 1.
 
         // RTF color table
-        std::ostringstream colorTableBuilder;
-        colorTableBuilder << "{\\colortbl ;";
-        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(backgroundColor))
-                          << "\\green" << static_cast<int>(GetGValue(backgroundColor))
-                          << "\\blue" << static_cast<int>(GetBValue(backgroundColor))
-                          << ";";
-        colorMap[backgroundColor] = nextColorIndex++;
+        std::string colorTable{ "{\\colortbl ;" };
+        const auto getColorIndex = [&](const COLORREF color) {
+            const auto [it, inserted] = colorMap.try_emplace(color, nextColorIndex);
+            if (inserted)
+            {
+                // color not present in the map, so add it
+                fmt::format_to(std::back_inserter(colorTable),
+                               FMT_COMPILE("\\red{}\\green{}\\blue{};"),
+                               static_cast<int>(GetRValue(color)),
+                               static_cast<int>(GetGValue(color)),
+                               static_cast<int>(GetBValue(color)));
+                ++nextColorIndex;
+            }
+            return it->second;
+        };
+        getColorIndex(backgroundColor);
 
         // content
-        std::ostringstream contentBuilder;
-        contentBuilder << "\\viewkind4\\uc4";
+        std::string content;
+        content.reserve(rows.colorRuns.size() * 32 + rows.text.size() * 86);
+        auto out = std::back_inserter(content);
 
         // paragraph styles
         // \fs specifies font size in half-points i.e. \fs20 results in a font size
         // of 10 pts. That's why, font size is multiplied by 2 here.
-        contentBuilder << "\\pard\\slmult1\\f0\\fs" << std::to_string(2 * fontHeightPoints)
-                       << "\\highlight1"
-                       << " ";
-
-        std::optional<COLORREF> fgColor = std::nullopt;
-        std::optional<COLORREF> bkColor = std::nullopt;
-        for (size_t row = 0; row < rows.text.size(); ++row)
-        {
-            size_t startOffset = 0;
-
-            if (row != 0)
-            {
-                contentBuilder << "\\line "; // new line
-            }
+        fmt::format_to(out, FMT_COMPILE("\\viewkind4\\uc4\\pard\\slmult1\\f0\\fs{}\\highlight1 "), 2 * fontHeightPoints);
 
-            for (size_t col = 0; col < rows.text.at(row).length(); ++col)
-            {
-                const auto writeAccumulatedChars = [&](bool includeCurrent) {
-                    if (col >= startOffset)
-                    {
-                        const auto unescapedText = ConvertToA(CP_UTF8, std::wstring_view(rows.text.at(row)).substr(startOffset, col - startOffset + includeCurrent));
-                        for (const auto c : unescapedText)
-                        {
-                            switch (c)
-                            {
-                            case '\\':
-                            case '{':
-                            case '}':
-                                contentBuilder << "\\" << c;
-                                break;
-                            default:
-                                contentBuilder << c;
-                            }
-                        }
-
-                        startOffset = col;
-                    }
-                };
+        std::optional<std::pair<COLORREF, COLORREF>> lastColors;
+        std::string utf8;
 
-                if (rows.text.at(row).at(col) == '\r' || rows.text.at(row).at(col) == '\n')
+        _WalkColorSpans(
+            rows,
+            [&](const size_t row) {
+                if (row != 0)
                 {
-                    // do not include \r nor \n as they don't have color attributes.
-                    // For line break use \line instead.
-                    writeAccumulatedChars(false);
-                    break;
+                    content.append("\\line "); // new line
                 }
-
-                bool colorChanged = false;
-                if (!fgColor.has_value() || rows.FgAttr.at(row).at(col) != fgColor.value())
+            },
+            [&](const std::wstring_view text, const TextAndColor::ColorRun& colors) {
+                if (!lastColors.has_value() || lastColors->first != colors.fg || lastColors->second != colors.bk)
                 {
-                    fgColor = rows.FgAttr.at(row).at(col);
-                    colorChanged = true;
-                }
+                    lastColors.emplace(colors.fg, colors.bk);
 
-                if (!bkColor.has_value() || rows.BkAttr.at(row).at(col) != bkColor.value())
-                {
-                    bkColor = rows.BkAttr.at(row).at(col);
-                    colorChanged = true;
+                    const auto bkColorIndex = getColorIndex(colors.bk);
+                    const auto fgColorIndex = getColorIndex(colors.fg);
+                    fmt::format_to(out, FMT_COMPILE("\\highlight{}\\cf{} "), bkColorIndex, fgColorIndex);
                 }
 
-                if (colorChanged)
+                THROW_IF_FAILED(til::u16u8(text, utf8));
+                for (const auto c : utf8)
                 {
-                    writeAccumulatedChars(false);
-
-                    int bkColorIndex = 0;
-                    if (colorMap.find(bkColor.value()) != colorMap.end())
+                    switch (c)
                     {
-                        // color already exists in the map, just retrieve the index
-                        bkColorIndex = colorMap[bkColor.value()];
-                    }
-                    else
-                    {
-                        // color not present in the map, so add it
-                        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(bkColor.value()))
-                                          << "\\green" << static_cast<int>(GetGValue(bkColor.value()))
-                                          << "\\blue" << static_cast<int>(GetBValue(bkColor.value()))
-                                          << ";";
-                        colorMap[bkColor.value()] = nextColorIndex;
-                        bkColorIndex = nextColorIndex++;
+                    case '\\':
+                    case '{':
+                    case '}':
+                        content.push_back('\\');
+                        content.push_back(c);
+                        break;
+                    default:
+                        content.push_back(c);
                     }
+                }
+            });
 
-                    int fgColorIndex = 0;
-                    if (colorMap.find(fgColor.value()) != colorMap.end())
-                    {
-                        // color already exists in the map, just retrieve the index
-                        fgColorIndex = colorMap[fgColor.value()];
-                    }
-                    else
-                    {
-                        // color not present in the map, so add it
-                        colorTableBuilder << "\\red" << static_cast<int>(GetRValue(fgColor.value()))
-                                          << "\\green" << static_cast<int>(GetGValue(fgColor.value()))
-                                          << "\\blue" << static_cast<int>(GetBValue(fgColor.value()))
-                                          << ";";
-                        colorMap[fgColor.value()] = nextColorIndex;
-                        fgColorIndex = nextColorIndex++;
-                    }
+        // end colortbl
+        colorTable.push_back('}');
 
-                    contentBuilder << "\\highlight" << bkColorIndex
-                                   << "\\cf" << fgColorIndex
-                                   << " ";
-                }
+        std::string rtf;
+        rtf.reserve(colorTable.size() + content.size() + 128);
 
-                // if this is the last character in the row, flush the whole row
-                if (col == rows.text.at(row).length() - 1)
-                {
-                    writeAccumulatedChars(true);
-                }
-            }
-        }
+        // start rtf
+        rtf.push_back('{');
 
-        // end colortbl
-        colorTableBuilder << "}";
+        // Standard RTF header.
+        // This is similar to the header generated by WordPad.
+        // \ansi - specifies that the ANSI char set is used in the current doc
+        // \ansicpg1252 - represents the ANSI code page which is used to perform the Unicode to ANSI conversion when writing RTF text
+        // \deff0 - specifies that the default font for the document is the one at index 0 in the font table
+        // \nouicompat - ?
+        rtf.append("\\rtf1\\ansi\\ansicpg1252\\deff0\\nouicompat");
+
+        // font table
+        fmt::format_to(std::back_inserter(rtf), FMT_COMPILE("{{\\fonttbl{{\\f0\\fmodern\\fcharset0 {};}}}}"), ConvertToA(CP_UTF8, fontFaceName));
 
         // add color table to the final RTF
-        rtfBuilder << colorTableBuilder.str();
+        rtf.append(colorTable);
 
         // add the text content to the final RTF
-        rtfBuilder << contentBuilder.str();
+        rtf.append(content);
 
         // end rtf
-        rtfBuilder << "}";
+        rtf.push_back('}');
 
-        return rtfBuilder.str();
+        return rtf;
     }
     catch (...)
     {
@@ -2371,8 +2569,8 @@ void TextBuffer::AddHyperlinkToMap(std::wstring_view uri, uint16_t id)
 // Arguments:
 // - The hyperlink ID
 // Return Value:
-// - The URI
-std::wstring TextBuffer::GetHyperlinkUriFromId(uint16_t id) const
+// - The URI. The reference stays valid until the ID is removed from the map.
+const std::wstring& TextBuffer::GetHyperlinkUriFromId(uint16_t id) const
 {
     return _hyperlinkMap.at(id);
 }
@@ -2432,6 +2630,14 @@ void TextBuffer::RemoveHyperlinkFromMap(uint16_t id) noexcept
     }
 }
 
+// Method Description:
+// - Returns the number of attribute runs referencing each hyperlink ID,
+//   which the rows of this buffer keep up to date.
+HyperlinkRefCounts& TextBuffer::GetHyperlinkRefCounts() noexcept
+{
+    return _hyperlinkRefCounts;
+}
+
 // Method Description:
 // - Obtains the custom ID, if there was one, associated with the
 //   uint16_t id of a hyperlink
@@ -2439,9 +2645,9 @@ void TextBuffer::RemoveHyperlinkFromMap(uint16_t id) noexcept
 // - The uint16_t id of the hyperlink
 // Return Value:
 // - The custom ID if there was one, empty string otherwise
-std::wstring TextBuffer::GetCustomIdFromId(uint16_t id) const
+std::wstring_view TextBuffer::GetCustomIdFromId(uint16_t id) const noexcept
 {
-    for (auto customIdPair : _hyperlinkCustomIdMap)
+    for (const auto& customIdPair : _hyperlinkCustomIdMap)
     {
         if (customIdPair.second == id)
         {
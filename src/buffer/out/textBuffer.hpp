@@ -53,6 +53,7 @@ filling in the last row, and updating the screen.
 
 #include "cursor.h"
 #include "Row.hpp"
+#include "RowView.hpp"
 #include "TextAttribute.hpp"
 #include "UnicodeStorage.hpp"
 #include "../types/inc/Viewport.hpp"
@@ -77,6 +78,7 @@ public:
     // row manipulation
     const ROW& GetRowByOffset(const size_t index) const;
     ROW& GetRowByOffset(const size_t index);
+    RowView GetRowViewByOffset(const size_t index) const;
 
     TextBufferCellIterator GetCellDataAt(const COORD at) const;
     TextBufferCellIterator GetCellLineDataAt(const COORD at) const;
@@ -133,6 +135,8 @@ public:
     COORD BufferToScreenPosition(const COORD position) const;
 
     void Reset();
+    void ClearRowsFrom(const size_t firstRow, const TextAttribute fillAttributes);
+    void Reinitialize(const TextAttribute defaultAttributes, const UINT cursorSize);
 
     [[nodiscard]] HRESULT ResizeTraditional(const COORD newSize) noexcept;
 
@@ -150,22 +154,35 @@ public:
     const til::point GetGlyphEnd(const til::point pos) const;
     bool MoveToNextGlyph(til::point& pos, bool allowBottomExclusive = false) const;
     bool MoveToPreviousGlyph(til::point& pos) const;
+    int MoveByGlyphs(til::point& pos, const int count, const bool allowBottomExclusive = false) const;
 
     const std::vector<SMALL_RECT> GetTextRects(COORD start, COORD end, bool blockSelection, bool bufferCoordinates) const;
 
     void AddHyperlinkToMap(std::wstring_view uri, uint16_t id);
-    std::wstring GetHyperlinkUriFromId(uint16_t id) const;
+    const std::wstring& GetHyperlinkUriFromId(uint16_t id) const;
     uint16_t GetHyperlinkId(std::wstring_view uri, std::wstring_view id);
     void RemoveHyperlinkFromMap(uint16_t id) noexcept;
-    std::wstring GetCustomIdFromId(uint16_t id) const;
+    HyperlinkRefCounts& GetHyperlinkRefCounts() noexcept;
+    std::wstring_view GetCustomIdFromId(uint16_t id) const noexcept;
     void CopyHyperlinkMaps(const TextBuffer& OtherBuffer);
 
     class TextAndColor
     {
     public:
+        // A run of consecutive characters sharing the same colors. Runs are
+        // measured in wchar_t and may continue across row boundaries, so that
+        // a selection with uniform coloring only needs a single entry.
+        struct ColorRun
+        {
+            size_t length;
+            COLORREF fg;
+            COLORREF bk;
+        };
+
         std::vector<std::wstring> text;
-        std::vector<std::vector<COLORREF>> FgAttr;
-        std::vector<std::vector<COLORREF>> BkAttr;
+        std::vector<ColorRun> colorRuns;
+
+        std::wstring JoinText() const;
     };
 
     const TextAndColor GetText(const bool includeCRLF,
@@ -200,9 +217,20 @@ public:
     interval_tree::IntervalTree<til::point, size_t> GetPatterns(const size_t firstRow, const size_t lastRow) const;
 
 private:
-    void _UpdateSize();
+    void _UpdateSize(const COORD dimensions);
     Microsoft::Console::Types::Viewport _size;
-    std::vector<ROW> _storage;
+    // Must be declared before _storage, as the rows update it until they're destroyed.
+    HyperlinkRefCounts _hyperlinkRefCounts;
+
+    // Rows are only constructed once they're accessed. The ones past the end of
+    // _storage are blank and filled with _placeholderAttributes. The capacity of
+    // _storage always covers all rows, so constructing one never moves the others.
+    mutable std::vector<ROW> _storage;
+    TextAttribute _placeholderAttributes;
+
+    void _MaterializeRows(const size_t count) const;
+    ROW& _MaterializeRow(const size_t storageIndex) const;
+    bool _IsRowMaterialized(const size_t index) const noexcept;
     Cursor _cursor;
 
     SHORT _firstRow; // indexes top row (not necessarily 0)
@@ -238,17 +266,25 @@ private:
 
     void _ExpandTextRow(SMALL_RECT& selectionRow) const;
 
+    template<typename TRowFn, typename TSpanFn>
+    static void _WalkColorSpans(const TextAndColor& rows, TRowFn&& onRow, TSpanFn&& onSpan);
+
     const DelimiterClass _GetDelimiterClassAt(const COORD pos, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordStartForAccessibility(const COORD target, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordStartForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
     const COORD _GetWordEndForAccessibility(const COORD target, const std::wstring_view wordDelimiters, const COORD lastCharPos) const;
     const COORD _GetWordEndForSelection(const COORD target, const std::wstring_view wordDelimiters) const;
 
-    void _PruneHyperlinks();
+    void _PruneHyperlinks(const std::vector<uint16_t>& hyperlinks) noexcept;
 
     std::unordered_map<size_t, std::wstring> _idsAndPatterns;
     size_t _currentPatternId;
 
+    // The highest row revision and the fill attributes as of the last
+    // Reinitialize. Rows that haven't been touched since are still blank.
+    uint64_t _blankRevision;
+    std::optional<TextAttribute> _blankAttributes;
+
 #ifdef UNIT_TESTING
     friend class TextBufferTests;
     friend class UiaTextRangeTests;
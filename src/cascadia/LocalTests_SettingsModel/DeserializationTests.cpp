@@ -87,9 +87,13 @@ namespace SettingsModelLocalTests
         TEST_METHOD(TestCloneInheritanceTree);
 
         TEST_METHOD(TestValidDefaults);
+        TEST_METHOD(TestDefaultsAreIndependentCopies);
 
         TEST_METHOD(TestInheritedCommand);
 
+        TEST_METHOD(TestChangedProfiles);
+        TEST_METHOD(TestChangedProfilesWithManyProfiles);
+
         TEST_CLASS_SETUP(ClassSetup)
         {
             InitializeJsonReader();
@@ -97,6 +101,15 @@ namespace SettingsModelLocalTests
         }
 
     private:
+        winrt::com_ptr<implementation::CascadiaSettings> _createSettings(const std::string_view settingsJson)
+        {
+            auto settings{ winrt::make_self<implementation::CascadiaSettings>() };
+            settings->_ParseJsonString(settingsJson, false);
+            settings->LayerJson(settings->_userSettings);
+            settings->_ValidateSettings();
+            return settings;
+        }
+
         void _logCommandNames(winrt::Windows::Foundation::Collections::IMapView<winrt::hstring, Command> commands, const int indentation = 1)
         {
             if (indentation == 1)
@@ -2764,6 +2777,34 @@ namespace SettingsModelLocalTests
         VERIFY_ARE_EQUAL(settings.AllProfiles().Size(), 2u);
     }
 
+    void DeserializationTests::TestDefaultsAreIndependentCopies()
+    {
+        // LoadDefaults only parses defaults.json once per process. Every
+        // caller must still get its own settings object to modify.
+
+        const auto settings0{ CascadiaSettings::LoadDefaults() };
+        const auto settings1{ CascadiaSettings::LoadDefaults() };
+        VERIFY_IS_FALSE(settings0 == settings1);
+
+        const auto profile0{ settings0.AllProfiles().GetAt(0) };
+        const auto profile1{ settings1.AllProfiles().GetAt(0) };
+        VERIFY_ARE_EQUAL(profile0.Guid(), profile1.Guid());
+        VERIFY_ARE_EQUAL(profile0.Name(), profile1.Name());
+        VERIFY_IS_TRUE(profile1.Origin() == OriginTag::InBox);
+
+        profile0.Name(L"Modified");
+        settings0.CreateNewProfile();
+        settings0.GlobalSettings().InitialRows(42);
+
+        VERIFY_ARE_NOT_EQUAL(L"Modified", profile1.Name());
+        VERIFY_ARE_EQUAL(2u, settings1.AllProfiles().Size());
+        VERIFY_ARE_NOT_EQUAL(42, settings1.GlobalSettings().InitialRows());
+
+        const auto settings2{ CascadiaSettings::LoadDefaults() };
+        VERIFY_ARE_EQUAL(profile1.Name(), settings2.AllProfiles().GetAt(0).Name());
+        VERIFY_ARE_EQUAL(2u, settings2.AllProfiles().Size());
+    }
+
     void DeserializationTests::TestInheritedCommand()
     {
         // Test unbinding a command's key chord or name that originated in another layer.
@@ -2917,4 +2958,112 @@ namespace SettingsModelLocalTests
             VERIFY_IS_NULL(actualKeyChord);
         }
     }
+
+    void DeserializationTests::TestChangedProfiles()
+    {
+        // profile1 and profile2 both use Scheme1, profile2 only when unfocused.
+        static constexpr std::string_view settingsTemplate{ R"(
+        {{
+            "defaultProfile": "{{6239a42c-0000-49a3-80bd-e8fdd045185c}}",
+            "initialCols": {2},
+            "profiles":
+            [
+                {{
+                    "guid": "{{6239a42c-0000-49a3-80bd-e8fdd045185c}}",
+                    "name": "profile0",
+                    "colorScheme": "Scheme0"
+                }},
+                {{
+                    "guid": "{{6239a42c-1111-49a3-80bd-e8fdd045185c}}",
+                    "name": "profile1",
+                    "colorScheme": "Scheme1",
+                    "fontFace": "{0}"
+                }},
+                {{
+                    "guid": "{{6239a42c-2222-49a3-80bd-e8fdd045185c}}",
+                    "name": "profile2",
+                    "colorScheme": "Scheme0",
+                    "unfocusedAppearance": {{ "colorScheme": "Scheme1" }}
+                }}
+            ],
+            "schemes":
+            [
+                {{ "name": "Scheme0", "foreground": "#CCCCCC" }},
+                {{ "name": "Scheme1", "foreground": "{1}" }}
+            ]
+        }})" };
+        const auto createSettings = [&](const std::string_view fontFace, const std::string_view foreground, const int initialCols) {
+            return _createSettings(fmt::format(settingsTemplate, fontFace, foreground, initialCols));
+        };
+
+        const winrt::guid guid0{ ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-0000-49a3-80bd-e8fdd045185c}") };
+        const winrt::guid guid1{ ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-1111-49a3-80bd-e8fdd045185c}") };
+        const winrt::guid guid2{ ::Microsoft::Console::Utils::GuidFromString(L"{6239a42c-2222-49a3-80bd-e8fdd045185c}") };
+
+        const auto settings{ createSettings("Consolas", "#FFFFFF", 80) };
+
+        {
+            Log::Comment(L"Without previous settings, every profile changed");
+            const auto changed{ settings->ChangedProfiles(nullptr) };
+            VERIFY_ARE_EQUAL(3u, changed.Size());
+            VERIFY_ARE_EQUAL(guid0, changed.GetAt(0));
+            VERIFY_ARE_EQUAL(guid1, changed.GetAt(1));
+            VERIFY_ARE_EQUAL(guid2, changed.GetAt(2));
+        }
+        {
+            Log::Comment(L"Reloading the same settings changes nothing");
+            const auto changed{ createSettings("Consolas", "#FFFFFF", 80)->ChangedProfiles(*settings) };
+            VERIFY_ARE_EQUAL(0u, changed.Size());
+        }
+        {
+            Log::Comment(L"A copy of the settings changes nothing either");
+            VERIFY_ARE_EQUAL(0u, settings->Copy().ChangedProfiles(*settings).Size());
+        }
+        {
+            Log::Comment(L"Changing a profile only changes that profile");
+            const auto changed{ createSettings("Cascadia Code", "#FFFFFF", 80)->ChangedProfiles(*settings) };
+            VERIFY_ARE_EQUAL(1u, changed.Size());
+            VERIFY_ARE_EQUAL(guid1, changed.GetAt(0));
+        }
+        {
+            Log::Comment(L"Changing a scheme changes the profiles that use it, focused or not");
+            const auto changed{ createSettings("Consolas", "#000000", 80)->ChangedProfiles(*settings) };
+            VERIFY_ARE_EQUAL(2u, changed.Size());
+            VERIFY_ARE_EQUAL(guid1, changed.GetAt(0));
+            VERIFY_ARE_EQUAL(guid2, changed.GetAt(1));
+        }
+        {
+            Log::Comment(L"Changing a global setting changes every profile");
+            const auto changed{ createSettings("Consolas", "#FFFFFF", 120)->ChangedProfiles(*settings) };
+            VERIFY_ARE_EQUAL(3u, changed.Size());
+        }
+    }
+
+    void DeserializationTests::TestChangedProfilesWithManyProfiles()
+    {
+        static constexpr size_t profileCount{ 500 };
+
+        const auto createSettingsJson = [](const size_t changedProfile) {
+            std::string profiles;
+            for (size_t i = 0; i < profileCount; i++)
+            {
+                profiles += fmt::format(R"({{ "guid": "{{6239a42c-{0:04x}-49a3-80bd-e8fdd045185c}}", "name": "profile{0}", "fontSize": {1} }},)",
+                                        i,
+                                        i == changedProfile ? 20 : 12);
+            }
+            profiles.pop_back();
+            return fmt::format(R"({{ "defaultProfile": "{{6239a42c-0000-49a3-80bd-e8fdd045185c}}", "profiles": [ {0} ] }})", profiles);
+        };
+
+        const auto settings{ _createSettings(createSettingsJson(profileCount)) };
+        const auto reloadedSettings{ _createSettings(createSettingsJson(42)) };
+
+        const auto start{ std::chrono::steady_clock::now() };
+        const auto changed{ reloadedSettings->ChangedProfiles(*settings) };
+        const auto elapsed{ std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start) };
+        Log::Comment(fmt::format(L"Compared {} profiles in {}us", profileCount, elapsed.count()).c_str());
+
+        VERIFY_ARE_EQUAL(1u, changed.Size());
+        VERIFY_ARE_EQUAL(reloadedSettings->_allProfiles.GetAt(42).Guid(), changed.GetAt(0));
+    }
 }
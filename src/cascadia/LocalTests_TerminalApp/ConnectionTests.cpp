@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+
+#include "../inc/cppwinrt_utils.h"
+
+using namespace Microsoft::Console;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+using namespace WEX::Common;
+using namespace winrt::Microsoft::Terminal::TerminalConnection;
+
+namespace TerminalAppLocalTests
+{
+    // This is like the EchoConnection, but it doesn't pretty print control
+    // characters, so that the recording gets to see the raw output.
+    class RawEchoConnection : public winrt::implements<RawEchoConnection, ITerminalConnection>
+    {
+    public:
+        RawEchoConnection() noexcept = default;
+
+        void Start() noexcept {};
+        void WriteInput(winrt::hstring const& data)
+        {
+            _TerminalOutputHandlers(data);
+        }
+        void Resize(uint32_t /*rows*/, uint32_t /*columns*/) noexcept {}
+        void Close() noexcept {}
+
+        ConnectionState State() const noexcept { return ConnectionState::Connected; }
+
+        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
+        TYPED_EVENT(StateChanged, ITerminalConnection, IInspectable);
+    };
+
+    class ConnectionTests
+    {
+        BEGIN_TEST_CLASS(ConnectionTests)
+            TEST_CLASS_PROPERTY(L"RunAs", L"UAP")
+            TEST_CLASS_PROPERTY(L"UAP:AppXManifest", L"TestHostAppXManifest.xml")
+        END_TEST_CLASS()
+
+        TEST_METHOD(RecordAndReplay);
+        TEST_METHOD(ReplaySkipsBlankLinesAndOtherEvents);
+        TEST_METHOD(ReplayRequiresHeader);
+
+    private:
+        static std::filesystem::path _TempRecordingPath(const std::wstring_view name);
+        static std::vector<std::wstring> _Replay(const std::filesystem::path& path, const size_t expectedChunks);
+        static std::vector<std::wstring> _ReadLines(const std::filesystem::path& path);
+        static void _WriteFile(const std::filesystem::path& path, const std::string_view content);
+    };
+
+    std::filesystem::path ConnectionTests::_TempRecordingPath(const std::wstring_view name)
+    {
+        return std::filesystem::temp_directory_path() / fmt::format(L"{}.cast", name);
+    }
+
+    // Method Description:
+    // - Plays back a recording as fast as possible and collects its output.
+    // Arguments:
+    // - path: the recording to play back
+    // - expectedChunks: how many chunks of output to wait for
+    // Return Value:
+    // - The chunks of output, in the order they were played back.
+    std::vector<std::wstring> ConnectionTests::_Replay(const std::filesystem::path& path, const size_t expectedChunks)
+    {
+        std::mutex mutex;
+        std::vector<std::wstring> chunks;
+        wil::unique_event done{ wil::EventOptions::ManualReset };
+
+        ReplayConnection connection{ winrt::hstring{ path.wstring() }, ReplaySpeed::AsFastAsPossible };
+        connection.TerminalOutput([&](const winrt::hstring& output) {
+            std::lock_guard<std::mutex> lock{ mutex };
+            chunks.emplace_back(output);
+            if (chunks.size() == expectedChunks)
+            {
+                done.SetEvent();
+            }
+        });
+
+        connection.Start();
+        VERIFY_IS_TRUE(connection.State() == ConnectionState::Connected);
+        VERIFY_IS_TRUE(done.wait(5000), L"All the recorded output should be played back");
+
+        // Closing waits for the playback thread, so nothing can be added to chunks after this.
+        connection.Close();
+
+        std::lock_guard<std::mutex> lock{ mutex };
+        return chunks;
+    }
+
+    std::vector<std::wstring> ConnectionTests::_ReadLines(const std::filesystem::path& path)
+    {
+        std::ifstream file{ path, std::ios::binary };
+        const std::string content{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+        const auto text = til::u8u16(content);
+
+        std::vector<std::wstring> lines;
+        for (size_t begin = 0; begin < text.size();)
+        {
+            const auto end = std::min(text.find(L'\n', begin), text.size());
+            lines.emplace_back(text.substr(begin, end - begin));
+            begin = end + 1;
+        }
+        return lines;
+    }
+
+    void ConnectionTests::_WriteFile(const std::filesystem::path& path, const std::string_view content)
+    {
+        std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+        file.write(content.data(), content.size());
+    }
+
+    void ConnectionTests::RecordAndReplay()
+    {
+        const auto path = _TempRecordingPath(L"RecordAndReplay");
+        auto cleanup = wil::scope_exit([&]() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        });
+
+        const std::vector<std::wstring> chunks{
+            L"plain text",
+            L"\x1b[31mred\x1b[m\r\n",
+            L"\"quotes\" and \\backslashes\\",
+            L"\ttab, bell\a, backspace\b and delete\x7f",
+            L"\u00e9\u4e2d\U0001F600",
+        };
+
+        Log::Comment(L"Record some output, with a resize in between");
+        {
+            RecordingConnection recording{ winrt::make<RawEchoConnection>(), winrt::hstring{ path.wstring() }, 30, 80 };
+            recording.Start();
+            for (size_t i = 0; i < chunks.size(); ++i)
+            {
+                if (i == 2)
+                {
+                    recording.Resize(40, 100);
+                }
+                recording.WriteInput(winrt::hstring{ chunks[i] });
+            }
+            recording.Close();
+        }
+
+        Log::Comment(L"The recording has a header and one line per event");
+        const auto lines = _ReadLines(path);
+        // The header, each chunk, the resize and the empty "line" after the final newline.
+        VERIFY_ARE_EQUAL(chunks.size() + 3, lines.size());
+        const std::wstring_view expectedHeader{ L"{\"version\": 2, \"width\": 80, \"height\": 30, \"timestamp\": " };
+        VERIFY_ARE_EQUAL(expectedHeader, std::wstring_view{ lines.front() }.substr(0, expectedHeader.size()));
+        VERIFY_IS_TRUE(lines.back().empty());
+
+        Log::Comment(L"Events are escaped onto a single line, with timestamps that don't go back");
+        auto previousTime = 0.0;
+        for (size_t i = 1; i < lines.size() - 1; ++i)
+        {
+            const auto& line = lines[i];
+            Log::Comment(NoThrowString().Format(L"Event %zu", i));
+            VERIFY_ARE_EQUAL(L'[', line.front());
+            VERIFY_ARE_EQUAL(L']', line.back());
+            VERIFY_IS_TRUE(std::none_of(line.begin(), line.end(), [](const auto wch) { return wch < L' '; }));
+
+            const auto time = std::stod(line.substr(1));
+            VERIFY_IS_GREATER_THAN_OR_EQUAL(time, previousTime);
+            previousTime = time;
+        }
+        VERIFY_ARE_NOT_EQUAL(std::wstring::npos, lines[3].find(L", \"r\", \"100x40\"]"));
+
+        Log::Comment(L"Playing it back produces the recorded output, but not the resize");
+        const auto replayed = _Replay(path, chunks.size());
+        VERIFY_ARE_EQUAL(chunks.size(), replayed.size());
+        for (size_t i = 0; i < std::min(chunks.size(), replayed.size()); ++i)
+        {
+            VERIFY_ARE_EQUAL(chunks[i], replayed[i]);
+        }
+    }
+
+    void ConnectionTests::ReplaySkipsBlankLinesAndOtherEvents()
+    {
+        const auto path = _TempRecordingPath(L"ReplaySkipsBlankLinesAndOtherEvents");
+        auto cleanup = wil::scope_exit([&]() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        });
+
+        // Written by hand, the way other asciicast tools might: CRLF line
+        // endings, blank lines and event types we don't record ourselves.
+        _WriteFile(path,
+                   "\r\n"
+                   "{\"version\": 2, \"width\": 80, \"height\": 24}\r\n"
+                   "\r\n"
+                   "[0.1, \"o\", \"first\"]\r\n"
+                   "[0.2, \"i\", \"input\"]\r\n"
+                   "  \r\n"
+                   "[0.3, \"r\", \"120x30\"]\r\n"
+                   "[0.4, \"m\", \"marker\"]\r\n"
+                   "[0.5, \"o\", \"\\u001b[1msecond\\r\\n\"]\r\n");
+
+        const auto replayed = _Replay(path, 2);
+        VERIFY_ARE_EQUAL(2u, replayed.size());
+        VERIFY_ARE_EQUAL(L"first", replayed.at(0));
+        VERIFY_ARE_EQUAL(L"\x1b[1msecond\r\n", replayed.at(1));
+    }
+
+    void ConnectionTests::ReplayRequiresHeader()
+    {
+        const auto path = _TempRecordingPath(L"ReplayRequiresHeader");
+        auto cleanup = wil::scope_exit([&]() {
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        });
+
+        const auto verifyFails = [&](const std::string_view content) {
+            _WriteFile(path, content);
+
+            ReplayConnection connection{ winrt::hstring{ path.wstring() }, ReplaySpeed::AsFastAsPossible };
+            connection.Start();
+            VERIFY_IS_TRUE(connection.State() == ConnectionState::Failed);
+        };
+
+        Log::Comment(L"An empty file");
+        verifyFails("");
+
+        Log::Comment(L"Events without a header");
+        verifyFails("[0.1, \"o\", \"first\"]\n");
+
+        Log::Comment(L"A header of a different version");
+        verifyFails("{\"version\": 1, \"width\": 80, \"height\": 24}\n[0.1, \"o\", \"first\"]\n");
+
+        Log::Comment(L"A malformed event");
+        verifyFails("{\"version\": 2, \"width\": 80, \"height\": 24}\n[0.1, \"o\"]\n");
+    }
+}
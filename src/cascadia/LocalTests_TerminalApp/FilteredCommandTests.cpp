@@ -26,6 +26,7 @@ namespace TerminalAppLocalTests
         TEST_METHOD(VerifyWeight);
         TEST_METHOD(VerifyCompare);
         TEST_METHOD(VerifyCompareIgnoreCase);
+        TEST_METHOD(VerifyUpdateFilter);
     };
 
     void FilteredCommandTests::VerifyHighlighting()
@@ -229,4 +230,38 @@ namespace TerminalAppLocalTests
 
         VERIFY_SUCCEEDED(result);
     }
+
+    void FilteredCommandTests::VerifyUpdateFilter()
+    {
+        auto result = RunOnUIThread([]() {
+            const auto paletteItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(L"Split Vertically") };
+            const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
+
+            Log::Comment(L"The highlighted name is only computed once it's requested");
+            filteredCommand->UpdateFilter(L"sv");
+            VERIFY_IS_TRUE(filteredCommand->_HighlightedName == nullptr);
+            VERIFY_ARE_EQUAL(4, filteredCommand->Weight()); // 2 points for each character matched at the beginning of a word
+
+            auto segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 4u);
+            VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"S");
+            VERIFY_IS_TRUE(segments.GetAt(0).IsHighlighted());
+            VERIFY_ARE_EQUAL(segments.GetAt(1).TextSegment(), L"plit ");
+            VERIFY_IS_FALSE(segments.GetAt(1).IsHighlighted());
+            VERIFY_ARE_EQUAL(segments.GetAt(2).TextSegment(), L"V");
+            VERIFY_IS_TRUE(segments.GetAt(2).IsHighlighted());
+            VERIFY_ARE_EQUAL(segments.GetAt(3).TextSegment(), L"ertically");
+            VERIFY_IS_FALSE(segments.GetAt(3).IsHighlighted());
+
+            Log::Comment(L"A filter with a character missing from the name doesn't match");
+            filteredCommand->UpdateFilter(L"svz");
+            VERIFY_IS_TRUE(filteredCommand->_HighlightedName == nullptr);
+            VERIFY_ARE_EQUAL(0, filteredCommand->Weight());
+            segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 1u);
+            VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
+        });
+
+        VERIFY_SUCCEEDED(result);
+    }
 }
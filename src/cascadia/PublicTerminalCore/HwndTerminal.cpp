@@ -175,6 +175,7 @@ HwndTerminal::HwndTerminal(HWND parentHwnd) :
     _uiaProviderInitialized{ false },
     _currentDpi{ USER_DEFAULT_SCREEN_DPI },
     _pfnWriteCallback{ nullptr },
+    _pfnWriteCallbackW{ nullptr },
     _multiClickTime{ 500 } // this will be overwritten by the windows system double-click time
 {
     _EnsureStaticInitialization();
@@ -284,6 +285,18 @@ void HwndTerminal::RegisterScrollCallback(std::function<void(int, int, int)> cal
 
 void HwndTerminal::_WriteTextToConnection(const std::wstring& input) noexcept
 {
+    if (_pfnWriteCallbackW)
+    {
+        // The length-aware callback borrows our string for the duration of the call,
+        // which saves allocating a copy that the host has to free for every keystroke.
+        try
+        {
+            _pfnWriteCallbackW(input.data(), gsl::narrow<unsigned int>(input.size()));
+        }
+        CATCH_LOG();
+        return;
+    }
+
     if (!_pfnWriteCallback)
     {
         return;
@@ -302,6 +315,11 @@ void HwndTerminal::RegisterWriteCallback(const void _stdcall callback(wchar_t*))
     _pfnWriteCallback = callback;
 }
 
+void HwndTerminal::RegisterWriteCallbackW(void _stdcall callback(const wchar_t*, unsigned int))
+{
+    _pfnWriteCallbackW = callback;
+}
+
 ::Microsoft::Console::Types::IUiaData* HwndTerminal::GetUiaData() const noexcept
 {
     return _terminal.get();
@@ -385,6 +403,15 @@ void HwndTerminal::SendOutput(std::wstring_view data)
     _terminal->Write(data);
 }
 
+HRESULT HwndTerminal::SendOutputUtf8(std::string_view data) noexcept
+try
+{
+    RETURN_IF_FAILED(til::u8u16(data, _u16Str, _u8State));
+    _terminal->Write(_u16Str);
+    return S_OK;
+}
+CATCH_RETURN();
+
 HRESULT _stdcall CreateTerminal(HWND parentHwnd, _Out_ void** hwnd, _Out_ void** terminal)
 {
     // In order for UIA to hook up properly there needs to be a "static" window hosting the
@@ -427,12 +454,44 @@ void _stdcall TerminalRegisterWriteCallback(void* terminal, const void __stdcall
     publicTerminal->RegisterWriteCallback(callback);
 }
 
+void _stdcall TerminalRegisterWriteCallbackW(void* terminal, void __stdcall callback(const wchar_t*, unsigned int))
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    publicTerminal->RegisterWriteCallbackW(callback);
+}
+
 void _stdcall TerminalSendOutput(void* terminal, LPCWSTR data)
 {
     const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
     publicTerminal->SendOutput(data);
 }
 
+/// <summary>
+/// Writes output to the terminal without measuring it first. It may contain embedded NULs.
+/// </summary>
+/// <param name="terminal">Terminal pointer.</param>
+/// <param name="data">UTF-16 output.</param>
+/// <param name="length">Length of the output in code units.</param>
+void _stdcall TerminalSendOutputW(void* terminal, _In_reads_(length) LPCWSTR data, unsigned int length)
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    publicTerminal->SendOutput({ data, length });
+}
+
+/// <summary>
+/// Writes UTF-8 output, such as the contents of a pipe, to the terminal.
+/// A sequence that is split between two calls is reassembled.
+/// </summary>
+/// <param name="terminal">Terminal pointer.</param>
+/// <param name="data">UTF-8 output.</param>
+/// <param name="length">Length of the output in bytes.</param>
+/// <returns>S_OK, or the failure to convert the output.</returns>
+HRESULT _stdcall TerminalSendOutputUtf8(void* terminal, _In_reads_(length) LPCSTR data, unsigned int length)
+{
+    const auto publicTerminal = static_cast<HwndTerminal*>(terminal);
+    return publicTerminal->SendOutputUtf8({ data, length });
+}
+
 /// <summary>
 /// Triggers a terminal resize using the new width and height in pixel.
 /// </summary>
@@ -850,13 +909,8 @@ void __stdcall TerminalKillFocus(void* terminal)
 HRESULT HwndTerminal::_CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, bool const fAlsoCopyFormatting)
 try
 {
-    std::wstring finalString;
-
     // Concatenate strings into one giant string to put onto the clipboard.
-    for (const auto& str : rows.text)
-    {
-        finalString += str;
-    }
+    const auto finalString = rows.JoinText();
 
     // allocate the final clipboard data
     const size_t cchNeeded = finalString.size() + 1;
@@ -26,6 +26,8 @@ typedef struct _TerminalTheme
 extern "C" {
 __declspec(dllexport) HRESULT _stdcall CreateTerminal(HWND parentHwnd, _Out_ void** hwnd, _Out_ void** terminal);
 __declspec(dllexport) void _stdcall TerminalSendOutput(void* terminal, LPCWSTR data);
+__declspec(dllexport) void _stdcall TerminalSendOutputW(void* terminal, _In_reads_(length) LPCWSTR data, unsigned int length);
+__declspec(dllexport) HRESULT _stdcall TerminalSendOutputUtf8(void* terminal, _In_reads_(length) LPCSTR data, unsigned int length);
 __declspec(dllexport) void _stdcall TerminalRegisterScrollCallback(void* terminal, void __stdcall callback(int, int, int));
 __declspec(dllexport) HRESULT _stdcall TerminalTriggerResize(_In_ void* terminal, _In_ short width, _In_ short height, _Out_ COORD* dimensions);
 __declspec(dllexport) HRESULT _stdcall TerminalTriggerResizeWithDimension(_In_ void* terminal, _In_ COORD dimensions, _Out_ SIZE* dimensionsInPixels);
@@ -38,6 +40,7 @@ __declspec(dllexport) bool _stdcall TerminalIsSelectionActive(void* terminal);
 __declspec(dllexport) void _stdcall DestroyTerminal(void* terminal);
 __declspec(dllexport) void _stdcall TerminalSetTheme(void* terminal, TerminalTheme theme, LPCWSTR fontFamily, short fontSize, int newDpi);
 __declspec(dllexport) void _stdcall TerminalRegisterWriteCallback(void* terminal, const void __stdcall callback(wchar_t*));
+__declspec(dllexport) void _stdcall TerminalRegisterWriteCallbackW(void* terminal, void __stdcall callback(const wchar_t*, unsigned int));
 __declspec(dllexport) void _stdcall TerminalSendKeyEvent(void* terminal, WORD vkey, WORD scanCode, WORD flags, bool keyDown);
 __declspec(dllexport) void _stdcall TerminalSendCharEvent(void* terminal, wchar_t ch, WORD flags, WORD scanCode);
 __declspec(dllexport) void _stdcall TerminalBlinkCursor(void* terminal);
@@ -60,9 +63,11 @@ public:
     HRESULT Initialize();
     void Teardown() noexcept;
     void SendOutput(std::wstring_view data);
+    HRESULT SendOutputUtf8(std::string_view data) noexcept;
     HRESULT Refresh(const SIZE windowSize, _Out_ COORD* dimensions);
     void RegisterScrollCallback(std::function<void(int, int, int)> callback);
     void RegisterWriteCallback(const void _stdcall callback(wchar_t*));
+    void RegisterWriteCallbackW(void _stdcall callback(const wchar_t*, unsigned int));
     ::Microsoft::Console::Types::IUiaData* GetUiaData() const noexcept;
     HWND GetHwnd() const noexcept;
 
@@ -75,6 +80,7 @@ private:
     int _currentDpi;
     bool _uiaProviderInitialized;
     std::function<void(wchar_t*)> _pfnWriteCallback;
+    std::function<void(const wchar_t*, unsigned int)> _pfnWriteCallbackW;
     ::Microsoft::WRL::ComPtr<::Microsoft::Terminal::TermControlUiaProvider> _uiaProvider;
 
     std::unique_ptr<::Microsoft::Terminal::Core::Terminal> _terminal;
@@ -82,6 +88,10 @@ private:
     std::unique_ptr<::Microsoft::Console::Render::Renderer> _renderer;
     std::unique_ptr<::Microsoft::Console::Render::DxEngine> _renderEngine;
 
+    // UTF-8 output may be split anywhere, so partial sequences are carried over between calls.
+    til::u8state _u8State;
+    std::wstring _u16Str;
+
     bool _focused{ false };
 
     std::chrono::milliseconds _multiClickTime;
@@ -512,6 +512,7 @@ namespace winrt::TerminalApp::implementation
         _nestedActionStack.Clear();
         ParentCommandName(L"");
         _currentNestedCommands.Clear();
+        _resetLastMatches();
         _searchBox().Focus(FocusState::Programmatic);
         _updateFilteredActions();
         _filteredActionsView().SelectedIndex(0);
@@ -620,6 +621,7 @@ namespace winrt::TerminalApp::implementation
                         auto nestedFilteredCommand{ winrt::make<FilteredCommand>(nestedActionPaletteItem) };
                         _currentNestedCommands.Append(nestedFilteredCommand);
                     }
+                    _resetLastMatches();
 
                     _updateUIForStackChange();
                 }
@@ -877,6 +879,7 @@ namespace winrt::TerminalApp::implementation
             auto filteredCommand{ winrt::make<FilteredCommand>(actionPaletteItem) };
             _allCommands.Append(filteredCommand);
         }
+        _resetLastMatches();
 
         if (Visibility() == Visibility::Visible && _currentMode == CommandPaletteMode::ActionMode)
         {
@@ -906,6 +909,7 @@ namespace winrt::TerminalApp::implementation
             auto filteredCommand{ winrt::make<FilteredCommand>(tabPaletteItem) };
             target.Append(filteredCommand);
         }
+        _resetLastMatches();
     }
 
     void CommandPalette::SetTabs(Collections::IObservableVector<TabBase> const& tabs, Collections::IObservableVector<TabBase> const& mruTabs)
@@ -926,6 +930,7 @@ namespace winrt::TerminalApp::implementation
     void CommandPalette::_switchToMode(CommandPaletteMode mode)
     {
         _currentMode = mode;
+        _resetLastMatches();
 
         const auto currentlyVisible{ Visibility() == Visibility::Visible };
 
@@ -1007,9 +1012,8 @@ namespace winrt::TerminalApp::implementation
         }
         else if (_currentMode == CommandPaletteMode::TabSearchMode || _currentMode == CommandPaletteMode::ActionMode || _currentMode == CommandPaletteMode::CommandlineMode)
         {
-            for (const auto& action : commandsToFilter)
-            {
-                // Update filter for all commands
+            const auto filterAction = [&](const winrt::TerminalApp::FilteredCommand& action) {
+                // Update filter for the command
                 // This will modify the highlighting but will also lead to re-computation of weight (and consequently sorting).
                 // Pay attention that it already updates the highlighting in the UI
                 action.UpdateFilter(searchText);
@@ -1019,7 +1023,32 @@ namespace winrt::TerminalApp::implementation
                 {
                     actions.push_back(action);
                 }
+            };
+
+            // Every command matching the new filter also matched any prefix of it.
+            // So if the user only typed more characters since the last time,
+            // we only need to look at the commands that matched back then.
+            const std::wstring_view filter{ searchText };
+            if (_lastMatchesSource == commandsToFilter && filter.substr(0, _lastFilter.size()) == _lastFilter)
+            {
+                for (const auto& action : _lastMatches)
+                {
+                    filterAction(action);
+                }
+            }
+            else
+            {
+                for (const auto& action : commandsToFilter)
+                {
+                    filterAction(action);
+                }
             }
+
+            // Remember the matches before they're sorted, so that they stay in
+            // the same relative order as in commandsToFilter.
+            _lastFilter = filter;
+            _lastMatches = actions;
+            _lastMatchesSource = commandsToFilter;
         }
 
         // We want to present the commands sorted
@@ -1102,6 +1131,21 @@ namespace winrt::TerminalApp::implementation
 
         ParentCommandName(L"");
         _currentNestedCommands.Clear();
+        _resetLastMatches();
+    }
+
+    // Method Description:
+    // - Forgets the commands that matched the last filter. This needs to be
+    //   called whenever the lists of commands to filter change.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - <none>
+    void CommandPalette::_resetLastMatches() noexcept
+    {
+        _lastFilter.clear();
+        _lastMatches.clear();
+        _lastMatchesSource = nullptr;
     }
 
     void CommandPalette::EnableTabSwitcherMode(const uint32_t startIdx, TabSwitcherMode tabSwitcherMode)
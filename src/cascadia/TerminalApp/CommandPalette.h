@@ -72,6 +72,13 @@ namespace winrt::TerminalApp::implementation
 
         bool _lastFilterTextWasEmpty{ true };
 
+        // The filter and the commands it matched the last time the list was
+        // filtered. When the filter grows, only those commands can still match.
+        std::wstring _lastFilter;
+        std::vector<winrt::TerminalApp::FilteredCommand> _lastMatches;
+        Windows::Foundation::Collections::IVector<winrt::TerminalApp::FilteredCommand> _lastMatchesSource{ nullptr };
+        void _resetLastMatches() noexcept;
+
         void _filterTextChanged(Windows::Foundation::IInspectable const& sender,
                                 Windows::UI::Xaml::RoutedEventArgs const& args);
         void _previewKeyDownHandler(Windows::Foundation::IInspectable const& sender,
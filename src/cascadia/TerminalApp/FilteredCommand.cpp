@@ -17,6 +17,34 @@ using namespace winrt::Windows::Foundation;
 using namespace winrt::Windows::Foundation::Collections;
 using namespace winrt::Microsoft::Terminal::Settings::Model;
 
+namespace
+{
+    // Lowercases the text using the user's locale, the way lstrcmpi compares
+    // characters when sorting the palette (GH#9941). Lowercasing never changes
+    // the length of the text, so offsets into it are offsets into the original.
+    void foldCase(const std::wstring_view text, std::wstring& folded)
+    {
+        folded.assign(text);
+        if (!folded.empty())
+        {
+            const auto size = gsl::narrow<int>(folded.size());
+            LCMapStringEx(LOCALE_NAME_USER_DEFAULT, LCMAP_LOWERCASE | LCMAP_LINGUISTIC_CASING, text.data(), size, folded.data(), size, nullptr, nullptr, 0);
+        }
+    }
+
+    // Returns a mask with one bit for every character of the text. Characters
+    // share bits modulo 64, so comparing masks can only rule out a match.
+    uint64_t characterMask(const std::wstring_view text) noexcept
+    {
+        uint64_t mask = 0;
+        for (const auto ch : text)
+        {
+            mask |= uint64_t{ 1 } << (ch & 63);
+        }
+        return mask;
+    }
+}
+
 namespace winrt::TerminalApp::implementation
 {
     // This class is a wrapper of PaletteItem, that is used as an item of a filterable list in CommandPalette.
@@ -26,14 +54,15 @@ namespace winrt::TerminalApp::implementation
         _Filter(L""),
         _Weight(0)
     {
-        _HighlightedName = _computeHighlightedName();
+        _updateNameIndex();
 
         // Recompute the highlighted name if the item name changes
         _itemChangedRevoker = _Item.PropertyChanged(winrt::auto_revoke, [weakThis{ get_weak() }](auto& /*sender*/, auto& e) {
             auto filteredCommand{ weakThis.get() };
             if (filteredCommand && e.PropertyName() == L"Name")
             {
-                filteredCommand->HighlightedName(filteredCommand->_computeHighlightedName());
+                filteredCommand->_updateNameIndex();
+                filteredCommand->_invalidateHighlightedName();
                 filteredCommand->Weight(filteredCommand->_computeWeight());
             }
         });
@@ -46,11 +75,38 @@ namespace winrt::TerminalApp::implementation
         if (filter != _Filter)
         {
             Filter(filter);
-            HighlightedName(_computeHighlightedName());
+            _invalidateHighlightedName();
             Weight(_computeWeight());
         }
     }
 
+    winrt::TerminalApp::HighlightedText FilteredCommand::HighlightedName()
+    {
+        if (!_HighlightedName)
+        {
+            _HighlightedName = _computeHighlightedName();
+        }
+        return _HighlightedName;
+    }
+
+    // Method Description:
+    // - Drops the highlighted name, and notifies the rows that display it to
+    //   ask for it again. Rows that aren't displayed don't compute it at all.
+    void FilteredCommand::_invalidateHighlightedName()
+    {
+        _HighlightedName = nullptr;
+        _PropertyChangedHandlers(*this, Windows::UI::Xaml::Data::PropertyChangedEventArgs{ L"HighlightedName" });
+    }
+
+    // Method Description:
+    // - Builds the lowercase copy of the item name that the filter is matched
+    //   against, and the mask of the characters it contains.
+    void FilteredCommand::_updateNameIndex()
+    {
+        foldCase(_Item.Name(), _foldedName);
+        _nameMask = characterMask(_foldedName);
+    }
+
     // Method Description:
     // - Looks up the filter characters within the item name.
     // Iterating through the filter and the item name it tries to associate the next filter character
@@ -58,94 +114,91 @@ namespace winrt::TerminalApp::implementation
     //
     // E.g., for filter="c l t s" and name="close all tabs after this", the match will be "CLose TabS after this".
     //
-    // The item name is then split into segments (groupings of matched and non matched characters).
+    // The offsets of the matched characters are stored in _matches. If the filter is empty
+    // or any of its characters can't be matched, _matches is left empty.
+    void FilteredCommand::_updateMatches()
+    {
+        _matches.clear();
+
+        foldCase(_Filter, _foldedFilter);
+
+        // If the filter contains a character the name doesn't, there's no need to scan the name.
+        if (_foldedFilter.empty() || (characterMask(_foldedFilter) & ~_nameMask) != 0)
+        {
+            return;
+        }
+
+        size_t offset = 0;
+        for (const auto searchChar : _foldedFilter)
+        {
+            const auto match = _foldedName.find(searchChar, offset);
+            if (match == std::wstring::npos)
+            {
+                // There are still unmatched filter characters but we finished scanning the name.
+                _matches.clear();
+                return;
+            }
+
+            _matches.push_back(gsl::narrow_cast<uint32_t>(match));
+            offset = match + 1;
+        }
+    }
+
+    // Method Description:
+    // - Calls func(begin, end) for every run of consecutive matched characters in _matches.
+    template<typename F>
+    void FilteredCommand::_forEachMatchedRun(F&& func) const
+    {
+        for (size_t i = 0; i < _matches.size();)
+        {
+            const auto begin = _matches[i];
+            auto end = begin + 1;
+            for (++i; i < _matches.size() && _matches[i] == end; ++i)
+            {
+                ++end;
+            }
+            func(begin, end);
+        }
+    }
+
+    // Method Description:
+    // - Splits the item name into segments (groupings of matched and non matched characters).
     //
-    // E.g., the segments were the example above will be "CL", "ose ", "T", "ab", "S", "after this".
+    // E.g., for filter="c l t s" and name="close all tabs after this", the segments will be
+    // "CL", "ose ", "T", "ab", "S", "after this".
     //
     // The segments matching the filter characters are marked as highlighted.
     //
     // E.g., ("CL", true) ("ose ", false), ("T", true), ("ab", false), ("S", true), ("after this", false)
     //
-    // TODO: we probably need to merge this logic with _getWeight computation?
+    // If the filter doesn't match, the entire item name is returned as a single unmatched segment.
     //
     // Return Value:
     // - The HighlightedText object initialized with the segments computed according to the algorithm above.
     winrt::TerminalApp::HighlightedText FilteredCommand::_computeHighlightedName()
     {
+        _updateMatches();
+
         const auto segments = winrt::single_threaded_observable_vector<winrt::TerminalApp::HighlightedTextSegment>();
-        auto commandName = _Item.Name();
-        bool isProcessingMatchedSegment = false;
+        const auto commandName = _Item.Name();
         uint32_t nextOffsetToReport = 0;
-        uint32_t currentOffset = 0;
 
-        for (const auto searchChar : _Filter)
-        {
-            const WCHAR searchCharAsString[] = { searchChar, L'\0' };
-            while (true)
+        const auto appendSegment = [&](const uint32_t end, const bool isHighlighted) {
+            if (end > nextOffsetToReport)
             {
-                if (currentOffset == commandName.size())
-                {
-                    // There are still unmatched filter characters but we finished scanning the name.
-                    // In this case we return the entire item name as unmatched
-                    auto entireNameSegment{ winrt::make<HighlightedTextSegment>(commandName, false) };
-                    segments.Clear();
-                    segments.Append(entireNameSegment);
-                    return winrt::make<HighlightedText>(segments);
-                }
-
-                // GH#9941: search should be locale-aware as well
-                // We use the same comparison method as upon sorting to guarantee consistent behavior
-                const WCHAR currentCharAsString[] = { commandName[currentOffset], L'\0' };
-                auto isCurrentCharMatched = lstrcmpi(searchCharAsString, currentCharAsString) == 0;
-                if (isProcessingMatchedSegment != isCurrentCharMatched)
-                {
-                    // We reached the end of the region (matched character came after a series of unmatched or vice versa).
-                    // Conclude the segment and add it to the list.
-                    // Skip segment if it is empty (might happen when the first character of the name is matched)
-                    auto sizeToReport = currentOffset - nextOffsetToReport;
-                    if (sizeToReport > 0)
-                    {
-                        winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                        auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, isProcessingMatchedSegment) };
-                        segments.Append(highlightedSegment);
-                        nextOffsetToReport = currentOffset;
-                    }
-                    isProcessingMatchedSegment = isCurrentCharMatched;
-                }
-
-                currentOffset++;
-
-                if (isCurrentCharMatched)
-                {
-                    // We have matched this filter character, let's move to matching the next filter char
-                    break;
-                }
+                winrt::hstring segment{ commandName.data() + nextOffsetToReport, end - nextOffsetToReport };
+                segments.Append(winrt::make<HighlightedTextSegment>(segment, isHighlighted));
+                nextOffsetToReport = end;
             }
-        }
+        };
 
-        // Either the filter or the item name were fully processed.
-        // If we were in the middle of the matched segment - add it.
-        if (isProcessingMatchedSegment)
-        {
-            auto sizeToReport = currentOffset - nextOffsetToReport;
-            if (sizeToReport > 0)
-            {
-                winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-                auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, true) };
-                segments.Append(highlightedSegment);
-                nextOffsetToReport = currentOffset;
-            }
-        }
+        _forEachMatchedRun([&](const uint32_t begin, const uint32_t end) {
+            appendSegment(begin, false);
+            appendSegment(end, true);
+        });
 
         // Now create a segment for all remaining characters.
-        // We will have remaining characters as long as the filter is shorter than the item name.
-        auto sizeToReport = commandName.size() - nextOffsetToReport;
-        if (sizeToReport > 0)
-        {
-            winrt::hstring segment{ commandName.data() + nextOffsetToReport, sizeToReport };
-            auto highlightedSegment{ winrt::make<HighlightedTextSegment>(segment, false) };
-            segments.Append(highlightedSegment);
-        }
+        appendSegment(commandName.size(), false);
 
         return winrt::make<HighlightedText>(segments);
     }
@@ -191,28 +244,21 @@ namespace winrt::TerminalApp::implementation
     // - the relative weight of this match
     int FilteredCommand::_computeWeight()
     {
+        _updateMatches();
+
         int result = 0;
-        bool isNextSegmentWordBeginning = true;
+        _forEachMatchedRun([&](const uint32_t begin, const uint32_t end) {
+            const auto segmentSize = gsl::narrow_cast<int>(end - begin);
 
-        for (const auto& segment : _HighlightedName.Segments())
-        {
-            const auto& segmentText = segment.TextSegment();
-            const auto segmentSize = segmentText.size();
+            // Give extra point for each consecutive match
+            result += (segmentSize <= 1) ? segmentSize : 1 + 2 * (segmentSize - 1);
 
-            if (segment.IsHighlighted())
+            // Give extra point if this segment is at the beginning of a word
+            if (begin == 0 || _foldedName[begin - 1] == L' ')
             {
-                // Give extra point for each consecutive match
-                result += (segmentSize <= 1) ? segmentSize : 1 + 2 * (segmentSize - 1);
-
-                // Give extra point if this segment is at the beginning of a word
-                if (isNextSegmentWordBeginning)
-                {
-                    result++;
-                }
+                result++;
             }
-
-            isNextSegmentWordBeginning = segmentSize > 0 && segmentText[segmentSize - 1] == L' ';
-        }
+        });
 
         return result;
     }
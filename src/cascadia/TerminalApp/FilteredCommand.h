@@ -22,15 +22,33 @@ namespace winrt::TerminalApp::implementation
 
         void UpdateFilter(winrt::hstring const& filter);
 
+        winrt::TerminalApp::HighlightedText HighlightedName();
+
         static int Compare(winrt::TerminalApp::FilteredCommand const& first, winrt::TerminalApp::FilteredCommand const& second);
 
         WINRT_CALLBACK(PropertyChanged, Windows::UI::Xaml::Data::PropertyChangedEventHandler);
         WINRT_OBSERVABLE_PROPERTY(winrt::TerminalApp::PaletteItem, Item, _PropertyChangedHandlers, nullptr);
         WINRT_OBSERVABLE_PROPERTY(winrt::hstring, Filter, _PropertyChangedHandlers);
-        WINRT_OBSERVABLE_PROPERTY(winrt::TerminalApp::HighlightedText, HighlightedName, _PropertyChangedHandlers);
         WINRT_OBSERVABLE_PROPERTY(int, Weight, _PropertyChangedHandlers);
 
     private:
+        // Built lazily by HighlightedName(), so that only the rows the list
+        // actually displays pay for their highlighting.
+        winrt::TerminalApp::HighlightedText _HighlightedName{ nullptr };
+
+        // The lowercase item name and a mask of the characters it contains.
+        std::wstring _foldedName;
+        uint64_t _nameMask{ 0 };
+
+        // The lowercase filter and the offsets in the name it matched.
+        std::wstring _foldedFilter;
+        std::vector<uint32_t> _matches;
+
+        void _updateNameIndex();
+        void _updateMatches();
+        void _invalidateHighlightedName();
+        template<typename F>
+        void _forEachMatchedRun(F&& func) const;
         winrt::TerminalApp::HighlightedText _computeHighlightedName();
         int _computeWeight();
         Windows::UI::Xaml::Data::INotifyPropertyChanged::PropertyChanged_revoker _itemChangedRevoker;
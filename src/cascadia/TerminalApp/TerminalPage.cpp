@@ -94,6 +94,7 @@ namespace winrt::TerminalApp::implementation
 
     winrt::fire_and_forget TerminalPage::SetSettings(CascadiaSettings settings, bool needRefreshUI)
     {
+        const auto previousSettings{ _settings };
         _settings = settings;
 
         auto weakThis{ get_weak() };
@@ -110,7 +111,7 @@ namespace winrt::TerminalApp::implementation
 
             if (needRefreshUI)
             {
-                _RefreshUIForSettingsReload();
+                _RefreshUIForSettingsReload(previousSettings);
             }
 
             // Upon settings update we reload the system settings for scrolling as well.
@@ -1812,18 +1813,20 @@ namespace winrt::TerminalApp::implementation
     //   This includes update the settings of all the tabs according
     //   to their profiles, update the title and icon of each tab, and
     //   finally create the tab flyout
-    winrt::fire_and_forget TerminalPage::_RefreshUIForSettingsReload()
+    // Arguments:
+    // - previousSettings: the settings we had before the reload, if any. Only
+    //   the controls of profiles that changed since then get new settings.
+    winrt::fire_and_forget TerminalPage::_RefreshUIForSettingsReload(const CascadiaSettings previousSettings)
     {
         // Re-wire the keybindings to their handlers, as we'll have created a
         // new AppKeyBindings object.
         _HookupKeyBindings(_settings.ActionMap());
 
-        // Refresh UI elements
-        auto profiles = _settings.ActiveProfiles();
-        for (const auto& profile : profiles)
+        // Refresh UI elements. Updating a control's settings may reload its
+        // font and redraw it, so we skip the profiles that haven't changed.
+        const auto changedProfiles = _settings.ChangedProfiles(previousSettings);
+        for (const auto& profileGuid : changedProfiles)
         {
-            const auto profileGuid = profile.Guid();
-
             try
             {
                 // This can throw an exception if the profileGuid does
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "RecordingConnection.h"
+
+#include <cpprest/json.h>
+
+#include "RecordingConnection.g.cpp"
+
+using namespace ::winrt::Windows::Foundation;
+
+// The recording is an asciicast v2 file (https://github.com/asciinema/asciinema/blob/develop/doc/asciicast-v2.md):
+// a header object on the first line, followed by one event per line, each an
+// array of the time in seconds since the recording started, the event type
+// and its data. We write "o" events for output and "r" events for resizes.
+// Input is deliberately never recorded, as it might contain passwords.
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    RecordingConnection::RecordingConnection(const ITerminalConnection& wrappedConnection,
+                                             const hstring& path,
+                                             const uint32_t rows,
+                                             const uint32_t columns) :
+        _wrappedConnection{ wrappedConnection },
+        _startTime{ std::chrono::steady_clock::now() }
+    {
+        _file.reset(CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr));
+        THROW_LAST_ERROR_IF(!_file);
+
+        _WriteLine(fmt::format(L"{{\"version\": 2, \"width\": {}, \"height\": {}, \"timestamp\": {}}}\n", columns, rows, std::time(nullptr)));
+
+        _outputRevoker = _wrappedConnection.TerminalOutput(winrt::auto_revoke, { this, &RecordingConnection::_OutputHandler });
+        _stateChangedRevoker = _wrappedConnection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*e*/) {
+            _StateChangedHandlers(*this, nullptr);
+        });
+    }
+
+    void RecordingConnection::Start()
+    {
+        _wrappedConnection.Start();
+    }
+
+    void RecordingConnection::WriteInput(hstring const& data)
+    {
+        _wrappedConnection.WriteInput(data);
+    }
+
+    void RecordingConnection::Resize(uint32_t rows, uint32_t columns)
+    {
+        _wrappedConnection.Resize(rows, columns);
+
+        try
+        {
+            _WriteEvent(L'r', fmt::format(L"{}x{}", columns, rows));
+        }
+        CATCH_LOG();
+    }
+
+    void RecordingConnection::Close()
+    {
+        _outputRevoker.revoke();
+        _wrappedConnection.Close();
+
+        std::lock_guard<std::mutex> lock{ _fileMutex };
+        _file.reset();
+    }
+
+    ConnectionState RecordingConnection::State() const noexcept
+    {
+        return _wrappedConnection.State();
+    }
+
+    // Method Description:
+    // - Records a chunk of output from the wrapped connection, and passes it on.
+    //   A failure to record must never get in the way of the output.
+    // Arguments:
+    // - str: the output of the wrapped connection
+    void RecordingConnection::_OutputHandler(const hstring& str)
+    {
+        try
+        {
+            _WriteEvent(L'o', str);
+        }
+        CATCH_LOG();
+
+        _TerminalOutputHandlers(str);
+    }
+
+    // Method Description:
+    // - Appends an event to the recording, stamped with the time since the
+    //   recording started.
+    // Arguments:
+    // - type: the asciicast event type
+    // - data: the data of the event. Escaped as a JSON string.
+    void RecordingConnection::_WriteEvent(const wchar_t type, const std::wstring_view data)
+    {
+        const auto escaped = web::json::value::string(std::wstring{ data }).serialize();
+
+        std::lock_guard<std::mutex> lock{ _fileMutex };
+        const std::chrono::duration<double> time = std::chrono::steady_clock::now() - _startTime;
+        _WriteLine(fmt::format(L"[{:.6f}, \"{}\", {}]\n", time.count(), type, escaped));
+    }
+
+    // Method Description:
+    // - Writes a line to the recording as UTF-8. The caller must hold
+    //   _fileMutex, unless it's the constructor.
+    // Arguments:
+    // - line: the line to write, including the newline
+    void RecordingConnection::_WriteLine(const std::wstring_view line)
+    {
+        if (!_file)
+        {
+            return;
+        }
+
+        THROW_IF_FAILED(til::u16u8(line, _buffer));
+
+        DWORD written = 0;
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(_file.get(), _buffer.data(), gsl::narrow<DWORD>(_buffer.size()), &written, nullptr));
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "RecordingConnection.g.h"
+
+#include "../inc/cppwinrt_utils.h"
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    struct RecordingConnection : RecordingConnectionT<RecordingConnection>
+    {
+        RecordingConnection(const ITerminalConnection& wrappedConnection,
+                            const hstring& path,
+                            const uint32_t rows,
+                            const uint32_t columns);
+
+        void Start();
+        void WriteInput(hstring const& data);
+        void Resize(uint32_t rows, uint32_t columns);
+        void Close();
+
+        ConnectionState State() const noexcept;
+
+        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
+        TYPED_EVENT(StateChanged, ITerminalConnection, IInspectable);
+
+    private:
+        void _OutputHandler(const hstring& str);
+        void _WriteEvent(const wchar_t type, const std::wstring_view data);
+        void _WriteLine(const std::wstring_view line);
+
+        ITerminalConnection _wrappedConnection;
+        ITerminalConnection::TerminalOutput_revoker _outputRevoker;
+        ITerminalConnection::StateChanged_revoker _stateChangedRevoker;
+
+        std::mutex _fileMutex;
+        wil::unique_hfile _file;
+        std::chrono::steady_clock::time_point _startTime;
+        std::string _buffer;
+    };
+}
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::factory_implementation
+{
+    struct RecordingConnection : RecordingConnectionT<RecordingConnection, implementation::RecordingConnection>
+    {
+    };
+}
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "pch.h"
+#include "ReplayConnection.h"
+
+#include <cpprest/json.h>
+#include <LibraryResources.h>
+
+#include "ReplayConnection.g.cpp"
+
+using namespace ::winrt::Windows::Foundation;
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    ReplayConnection::ReplayConnection(const hstring& path, const ReplaySpeed speed) :
+        _path{ path },
+        _speed{ speed }
+    {
+    }
+
+    // Method Description:
+    // - Loads the recording and starts playing it back on a thread of its own.
+    //   If the recording can't be loaded, we print an error and fail instead.
+    void ReplayConnection::Start()
+    try
+    {
+        _transitionToState(ConnectionState::Connecting);
+
+        _chunks = _LoadRecording(_path);
+
+        _hPlaybackThread.reset(CreateThread(
+            nullptr,
+            0,
+            [](LPVOID lpParameter) noexcept {
+                ReplayConnection* const pInstance = static_cast<ReplayConnection*>(lpParameter);
+                if (pInstance)
+                {
+                    return pInstance->_PlaybackThread();
+                }
+                return gsl::narrow_cast<DWORD>(E_INVALIDARG);
+            },
+            this,
+            0,
+            nullptr));
+
+        THROW_LAST_ERROR_IF_NULL(_hPlaybackThread);
+
+        LOG_IF_FAILED(SetThreadDescription(_hPlaybackThread.get(), L"ReplayConnection Playback Thread"));
+
+        _transitionToState(ConnectionState::Connected);
+    }
+    catch (...)
+    {
+        const auto hr = wil::ResultFromCaughtException();
+
+        winrt::hstring failureText{ fmt::format(std::wstring_view{ RS_(L"ReplayFailedToLoad") }, gsl::narrow_cast<unsigned long>(hr), _path) };
+        _TerminalOutputHandlers(failureText);
+        _transitionToState(ConnectionState::Failed);
+    }
+
+    // Method Description:
+    // - Nothing we play back depends on the input. In Step mode though, any
+    //   input plays back the next chunk, so stepping through a recording is as
+    //   easy as pressing a key.
+    void ReplayConnection::WriteInput(hstring const& /*data*/)
+    {
+        if (_speed == ReplaySpeed::Step)
+        {
+            Step();
+        }
+    }
+
+    // Method Description:
+    // - The recorded resizes are not played back, since a connection can't
+    //   resize its terminal. Make sure the terminal has the recorded size
+    //   (see the header of the recording) for a faithful replay.
+    void ReplayConnection::Resize(uint32_t /*rows*/, uint32_t /*columns*/) noexcept
+    {
+    }
+
+    void ReplayConnection::Close() noexcept
+    try
+    {
+        if (_transitionToState(ConnectionState::Closing))
+        {
+            _closeEvent.SetEvent();
+
+            // Don't wait on ourselves, if a handler of our output closed us.
+            if (_hPlaybackThread && GetThreadId(_hPlaybackThread.get()) != GetCurrentThreadId())
+            {
+                LOG_LAST_ERROR_IF(WAIT_FAILED == WaitForSingleObject(_hPlaybackThread.get(), INFINITE));
+            }
+            _hPlaybackThread.reset();
+
+            _transitionToState(ConnectionState::Closed);
+        }
+    }
+    CATCH_LOG()
+
+    // Method Description:
+    // - In Step mode, plays back the next chunk of output.
+    void ReplayConnection::Step() noexcept
+    {
+        _stepEvent.SetEvent();
+    }
+
+    // Method Description:
+    // - Reads all the output events from an asciicast v2 file. Every other
+    //   event type is skipped.
+    // Arguments:
+    // - path: the path of the recording
+    // Return Value:
+    // - The chunks of output, along with when they were recorded.
+    std::vector<ReplayConnection::Chunk> ReplayConnection::_LoadRecording(const hstring& path)
+    {
+        wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+
+        LARGE_INTEGER size{};
+        THROW_IF_WIN32_BOOL_FALSE(GetFileSizeEx(file.get(), &size));
+
+        std::string content(gsl::narrow<size_t>(size.QuadPart), '\0');
+        DWORD read = 0;
+        THROW_IF_WIN32_BOOL_FALSE(ReadFile(file.get(), content.data(), gsl::narrow<DWORD>(content.size()), &read, nullptr));
+        content.resize(read);
+
+        const auto text = til::u8u16(content);
+        const std::wstring_view remaining{ text };
+
+        std::vector<Chunk> chunks;
+        bool header = true;
+        for (size_t begin = 0; begin < remaining.size();)
+        {
+            const auto end = std::min(remaining.find(L'\n', begin), remaining.size());
+            const auto line = remaining.substr(begin, end - begin);
+            begin = end + 1;
+
+            if (line.find_first_not_of(L" \t\r") == std::wstring_view::npos)
+            {
+                continue;
+            }
+
+            const auto value = web::json::value::parse(std::wstring{ line });
+            if (header)
+            {
+                THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), !value.is_object() || !value.has_integer_field(L"version") || value.at(L"version").as_integer() != 2);
+                header = false;
+                continue;
+            }
+
+            THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), !value.is_array() || value.size() < 3);
+            if (value.at(1).as_string() == L"o")
+            {
+                const auto time = std::chrono::duration<double>(value.at(0).as_double());
+                chunks.push_back({ std::chrono::duration_cast<std::chrono::microseconds>(time), value.at(2).as_string() });
+            }
+        }
+
+        THROW_HR_IF(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), header);
+        return chunks;
+    }
+
+    // Method Description:
+    // - Plays back the recorded output at the requested speed, until we run
+    //   out of output or get closed. Once done, we stay connected, so that the
+    //   terminal sticks around to be inspected.
+    DWORD ReplayConnection::_PlaybackThread()
+    {
+        // Keep us alive until the playback thread terminates; the destructor
+        // won't wait for us.
+        auto strongThis{ get_strong() };
+
+        const auto start = std::chrono::steady_clock::now();
+        for (const auto& chunk : _chunks)
+        {
+            if (_speed == ReplaySpeed::Step)
+            {
+                const std::array<HANDLE, 2> events{ _closeEvent.get(), _stepEvent.get() };
+                if (WaitForMultipleObjects(gsl::narrow_cast<DWORD>(events.size()), events.data(), FALSE, INFINITE) != WAIT_OBJECT_0 + 1)
+                {
+                    break;
+                }
+            }
+            else if (_speed == ReplaySpeed::RealTime)
+            {
+                const auto due = start + chunk.time;
+                const auto now = std::chrono::steady_clock::now();
+                const auto delay = due > now ? std::chrono::ceil<std::chrono::milliseconds>(due - now) : std::chrono::milliseconds::zero();
+                if (_closeEvent.wait(gsl::narrow_cast<DWORD>(delay.count())))
+                {
+                    break;
+                }
+            }
+            else if (_closeEvent.is_signaled())
+            {
+                break;
+            }
+
+            _TerminalOutputHandlers(chunk.text);
+        }
+
+        return 0;
+    }
+}
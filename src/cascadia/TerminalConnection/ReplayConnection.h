@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#pragma once
+
+#include "ReplayConnection.g.h"
+#include "ConnectionStateHolder.h"
+#include "../inc/cppwinrt_utils.h"
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
+{
+    struct ReplayConnection : ReplayConnectionT<ReplayConnection>, ConnectionStateHolder<ReplayConnection>
+    {
+        ReplayConnection(const hstring& path, const ReplaySpeed speed);
+
+        void Start();
+        void WriteInput(hstring const& data);
+        void Resize(uint32_t rows, uint32_t columns) noexcept;
+        void Close() noexcept;
+
+        void Step() noexcept;
+
+        WINRT_CALLBACK(TerminalOutput, TerminalOutputHandler);
+
+    private:
+        struct Chunk
+        {
+            std::chrono::microseconds time;
+            std::wstring text;
+        };
+
+        static std::vector<Chunk> _LoadRecording(const hstring& path);
+
+        DWORD _PlaybackThread();
+
+        hstring _path;
+        ReplaySpeed _speed;
+        std::vector<Chunk> _chunks;
+
+        wil::unique_event _stepEvent{ wil::EventOptions::None };
+        wil::unique_event _closeEvent{ wil::EventOptions::ManualReset };
+        wil::unique_handle _hPlaybackThread;
+    };
+}
+
+namespace winrt::Microsoft::Terminal::TerminalConnection::factory_implementation
+{
+    struct ReplayConnection : ReplayConnectionT<ReplayConnection, implementation::ReplayConnection>
+    {
+    };
+}
@@ -837,11 +837,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const auto bufferData = _terminal->RetrieveSelectedTextFromBuffer(singleLine);
 
         // convert text: vector<string> --> string
-        std::wstring textData;
-        for (const auto& text : bufferData.text)
-        {
-            textData += text;
-        }
+        const auto textData = bufferData.JoinText();
 
         // convert text to HTML format
         // GH#5347 - Don't provide a title for the generated HTML, as many
@@ -918,6 +914,26 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return _terminal->IsXtermBracketedPasteModeEnabled();
     }
 
+    // Method Description:
+    // - Returns how much output this control received so far, and how long it
+    //   took to parse and render it. This can be called from any thread.
+    // Arguments:
+    // - <none>
+    // Return Value:
+    // - The running totals. See OutputStatistics in ICoreState.idl.
+    Control::OutputStatistics ControlCore::OutputStatistics() const noexcept
+    {
+        Control::OutputStatistics statistics{};
+        statistics.CharactersReceived = _charactersReceived.load(std::memory_order_relaxed);
+        statistics.ParseTime = std::chrono::duration_cast<Windows::Foundation::TimeSpan>(std::chrono::nanoseconds{ _parseTime.load(std::memory_order_relaxed) });
+        if (_renderer)
+        {
+            statistics.RenderTime = std::chrono::duration_cast<Windows::Foundation::TimeSpan>(_renderer->GetTotalPaintTime());
+        }
+        statistics.ThrottledFrames = _throttledFrames.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
     Windows::Foundation::IReference<winrt::Windows::UI::Color> ControlCore::TabColor() noexcept
     {
         auto coreColor = _terminal->GetTabColor();
@@ -1334,7 +1350,32 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     }
     void ControlCore::_connectionOutputHandler(const hstring& hstr)
     {
-        _terminal->Write(hstr);
+        const OutputBudget::Scope busy;
+
+        std::wstring_view remaining{ hstr };
+        while (!remaining.empty())
+        {
+            auto slice = remaining.substr(0, _outputSliceLength);
+            // Don't split a surrogate pair between two slices.
+            if (slice.size() < remaining.size() && IS_HIGH_SURROGATE(slice.back()))
+            {
+                slice.remove_suffix(1);
+            }
+
+            const auto start = std::chrono::steady_clock::now();
+            _terminal->Write(slice);
+            const auto parseTime = std::chrono::steady_clock::now() - start;
+
+            _parseTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(parseTime).count(), std::memory_order_relaxed);
+            if (_outputBudget.Consume(parseTime))
+            {
+                _throttledFrames.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            remaining.remove_prefix(slice.size());
+        }
+
+        _charactersReceived.fetch_add(hstr.size(), std::memory_order_relaxed);
 
         // NOTE: We're raising an event here to inform the TermControl that
         // output has been received, so it can queue up a throttled
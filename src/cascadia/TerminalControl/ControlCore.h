@@ -24,6 +24,7 @@
 #include "../buffer/out/search.h"
 #include "cppwinrt_utils.h"
 #include "ThrottledFunc.h"
+#include "OutputBudget.h"
 
 namespace ControlUnitTests
 {
@@ -92,6 +93,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         int BufferHeight() const;
 
         bool BracketedPasteEnabled() const noexcept;
+
+        Control::OutputStatistics OutputStatistics() const noexcept;
 #pragma endregion
 
 #pragma region ITerminalInput
@@ -194,6 +197,15 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
         bool _isReadOnly{ false };
 
+        // Output is parsed in slices of at most this many characters, so that
+        // the terminal is unlocked every now and then and _outputBudget gets a
+        // chance to throttle a pane that receives a flood of output.
+        static constexpr size_t _outputSliceLength{ 16 * 1024 };
+        OutputBudget _outputBudget;
+        std::atomic<uint64_t> _charactersReceived{ 0 };
+        std::atomic<int64_t> _parseTime{ 0 };
+        std::atomic<uint64_t> _throttledFrames{ 0 };
+
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _lastHoveredInterval{ std::nullopt };
 
         // These members represent the size of the surface that we should be
@@ -0,0 +1,102 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- OutputBudget.h
+
+Abstract:
+- Caps how long a single control may spend parsing connection output per
+  frame, so that one noisy pane can't monopolize the CPU at the expense of
+  every other pane in the process.
+- The parse time available per frame is shared fairly between all the
+  controls that are currently processing output: as long as there are at
+  least as many CPU cores as busy controls, nobody is throttled. Once there
+  are more, each control gets its share of the cores and is put to sleep until
+  the next frame when it has used it up. This applies back pressure to the
+  connection, and leaves the terminal unlocked for the renderer in between.
+--*/
+
+#pragma once
+#include "pch.h"
+
+class OutputBudget
+{
+public:
+    // Marks the owning control as busy processing output for its lifetime.
+    class Scope
+    {
+    public:
+        Scope() noexcept
+        {
+            s_busyCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ~Scope()
+        {
+            s_busyCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    static constexpr std::chrono::nanoseconds FrameLength{ std::chrono::milliseconds{ 16 } };
+
+    // Method Description:
+    // - Accounts for time spent parsing output. If this control has used up
+    //   its share of the current frame, this blocks until the next one starts.
+    // - Must only be called from the connection's output thread, while a
+    //   Scope is alive.
+    // Arguments:
+    // - parseTime: how long the last slice of output took to parse.
+    // Return Value:
+    // - true if the caller was put to sleep.
+    bool Consume(const std::chrono::nanoseconds parseTime)
+    {
+        auto now = std::chrono::steady_clock::now();
+        const auto sliceStart = now - parseTime;
+        if (sliceStart - _frameStart >= FrameLength)
+        {
+            _frameStart = sliceStart;
+            _spent = {};
+        }
+
+        _spent += parseTime;
+        if (_spent < Budget())
+        {
+            return false;
+        }
+
+        const auto frameEnd = _frameStart + FrameLength;
+        const auto throttled = frameEnd > now;
+        if (throttled)
+        {
+            std::this_thread::sleep_until(frameEnd);
+            now = std::chrono::steady_clock::now();
+        }
+
+        _frameStart = now;
+        _spent = {};
+        return throttled;
+    }
+
+    // Method Description:
+    // - Returns the parse time each busy control may use per frame.
+    static std::chrono::nanoseconds Budget() noexcept
+    {
+        static const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        const auto busy = s_busyCount.load(std::memory_order_relaxed);
+        if (busy <= cores)
+        {
+            return FrameLength;
+        }
+        return FrameLength * gsl::narrow_cast<int64_t>(cores) / gsl::narrow_cast<int64_t>(busy);
+    }
+
+private:
+    inline static std::atomic<size_t> s_busyCount{ 0 };
+
+    std::chrono::steady_clock::time_point _frameStart{};
+    std::chrono::nanoseconds _spent{};
+};
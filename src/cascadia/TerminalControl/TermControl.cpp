@@ -1686,6 +1686,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return _core->BracketedPasteEnabled();
     }
 
+    Control::OutputStatistics TermControl::OutputStatistics() const noexcept
+    {
+        return _core->OutputStatistics();
+    }
+
     // Method Description:
     // - Given a copy-able selection, get the selected text from the buffer and send it to the
     //     Windows Clipboard (CascadiaWin32:main.cpp).
@@ -54,6 +54,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         int BufferHeight() const;
 
         bool BracketedPasteEnabled() const noexcept;
+
+        Control::OutputStatistics OutputStatistics() const noexcept;
 #pragma endregion
 
         void ScrollViewport(int viewTop);
@@ -58,6 +58,7 @@ namespace Microsoft::Terminal::Core
         virtual bool EnableAnyEventMouseMode(const bool enabled) noexcept = 0;
         virtual bool EnableAlternateScrollMode(const bool enabled) noexcept = 0;
         virtual bool EnableXtermBracketedPasteMode(const bool enabled) noexcept = 0;
+        virtual bool EnableSynchronizedOutput(const bool enabled) noexcept = 0;
         virtual bool IsXtermBracketedPasteModeEnabled() const = 0;
 
         virtual bool IsVtInputEnabled() const = 0;
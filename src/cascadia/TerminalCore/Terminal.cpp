@@ -474,11 +474,10 @@ bool Terminal::IsTrackingMouseInput() const noexcept
 // - The position
 std::wstring Terminal::GetHyperlinkAtPosition(const COORD position)
 {
-    auto attr = _buffer->GetCellDataAt(_ConvertToBufferCell(position))->TextAttr();
+    const auto attr = _GetAttributeAtPosition(position);
     if (attr.IsHyperlink())
     {
-        auto uri = _buffer->GetHyperlinkUriFromId(attr.GetHyperlinkId());
-        return uri;
+        return _buffer->GetHyperlinkUriFromId(attr.GetHyperlinkId());
     }
     // also look through our known pattern locations in our pattern interval tree
     const auto result = GetHyperlinkIntervalFromPosition(position);
@@ -507,7 +506,22 @@ std::wstring Terminal::GetHyperlinkAtPosition(const COORD position)
 // - The hyperlink ID
 uint16_t Terminal::GetHyperlinkIdAtPosition(const COORD position)
 {
-    return _buffer->GetCellDataAt(_ConvertToBufferCell(position))->TextAttr().GetHyperlinkId();
+    return _GetAttributeAtPosition(position).GetHyperlinkId();
+}
+
+// Method Description:
+// - Reads the attribute of the cell at the given terminal position straight
+//   out of the row's attribute runs. This is called on every mouse move, so
+//   we avoid constructing a TextBufferCellIterator (and its OutputCellView)
+//   just to look at a single attribute.
+// Arguments:
+// - The position of the cell, relative to the viewport
+// Return value:
+// - The attribute of that cell
+TextAttribute Terminal::_GetAttributeAtPosition(const COORD position) const
+{
+    const auto bufferPos = _ConvertToBufferCell(position);
+    return _buffer->GetRowByOffset(bufferPos.Y).GetAttrRow().GetAttrByColumn(bufferPos.X);
 }
 
 // Method description:
@@ -518,18 +532,16 @@ uint16_t Terminal::GetHyperlinkIdAtPosition(const COORD position)
 // - The interval representing the start and end coordinates
 std::optional<PointTree::interval> Terminal::GetHyperlinkIntervalFromPosition(const COORD position)
 {
-    const auto results = _patternIntervalTree.findOverlapping(COORD{ position.X + 1, position.Y }, position);
-    if (results.size() > 0)
-    {
-        for (const auto& result : results)
+    // Visit the overlapping intervals in place rather than collecting them
+    // into a vector first - this runs for every hovered cell.
+    std::optional<PointTree::interval> found;
+    _patternIntervalTree.visit_overlapping(COORD{ position.X + 1, position.Y }, position, [&](const auto& interval) {
+        if (!found && interval.value == _hyperlinkPatternId)
         {
-            if (result.value == _hyperlinkPatternId)
-            {
-                return result;
-            }
+            found = interval;
         }
-    }
-    return std::nullopt;
+    });
+    return found;
 }
 
 // Method Description:
@@ -1003,6 +1015,7 @@ void Terminal::_AdjustCursorPosition(const COORD proposedPosition)
 
         // manually erase our pattern intervals since the locations have changed now
         _patternIntervalTree = {};
+        ++_patternGeneration;
     }
 
     // Update Cursor Position
@@ -1207,6 +1220,7 @@ void Terminal::UpdatePatterns() noexcept
     auto lock = LockForWriting();
     auto oldTree = _patternIntervalTree;
     _patternIntervalTree = _buffer->GetPatterns(_VisibleStartIndex(), _VisibleEndIndex());
+    ++_patternGeneration;
     _InvalidatePatternTree(oldTree);
     _InvalidatePatternTree(_patternIntervalTree);
 }
@@ -1219,6 +1233,7 @@ void Terminal::ClearPatternTree() noexcept
 {
     auto oldTree = _patternIntervalTree;
     _patternIntervalTree = {};
+    ++_patternGeneration;
     _InvalidatePatternTree(oldTree);
 }
 
@@ -118,6 +118,7 @@ public:
     bool EnableAnyEventMouseMode(const bool enabled) noexcept override;
     bool EnableAlternateScrollMode(const bool enabled) noexcept override;
     bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override;
+    bool EnableSynchronizedOutput(const bool enabled) noexcept override;
     bool IsXtermBracketedPasteModeEnabled() const noexcept override;
 
     bool IsVtInputEnabled() const noexcept override;
@@ -179,9 +180,10 @@ public:
     bool IsScreenReversed() const noexcept override;
     const std::vector<Microsoft::Console::Render::RenderOverlay> GetOverlays() const noexcept override;
     const bool IsGridLineDrawingAllowed() noexcept override;
-    const std::wstring GetHyperlinkUri(uint16_t id) const noexcept override;
-    const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept override;
+    std::wstring_view GetHyperlinkUri(uint16_t id) const noexcept override;
+    std::wstring_view GetHyperlinkCustomId(uint16_t id) const noexcept override;
     const std::vector<size_t> GetPatternId(const COORD location) const noexcept override;
+    uint64_t GetPatternGeneration() const noexcept override;
 #pragma endregion
 
 #pragma region IUiaData
@@ -317,6 +319,7 @@ private:
     //      Either way, we should make this behavior controlled by a setting.
 
     interval_tree::IntervalTree<til::point, size_t> _patternIntervalTree;
+    uint64_t _patternGeneration{ 0 };
     void _InvalidatePatternTree(interval_tree::IntervalTree<til::point, size_t>& tree);
     void _InvalidateFromCoords(const COORD start, const COORD end);
 
@@ -352,6 +355,8 @@ private:
 
     void _NotifyTerminalCursorPositionChanged() noexcept;
 
+    TextAttribute _GetAttributeAtPosition(const COORD position) const;
+
 #pragma region TextSelection
     // These methods are defined in TerminalSelection.cpp
     std::vector<SMALL_RECT> _GetSelectionRects() const noexcept;
@@ -558,6 +558,16 @@ bool Terminal::IsXtermBracketedPasteModeEnabled() const noexcept
     return _bracketedPasteMode;
 }
 
+bool Terminal::EnableSynchronizedOutput(const bool enabled) noexcept
+try
+{
+    // The renderer holds back frames while the connected application
+    // is in the middle of updating the screen.
+    _buffer->GetRenderTarget().SetSynchronizedOutput(enabled);
+    return true;
+}
+CATCH_LOG_RETURN_FALSE()
+
 bool Terminal::IsVtInputEnabled() const noexcept
 {
     // We should never be getting this call in Terminal.
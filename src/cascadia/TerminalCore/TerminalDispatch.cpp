@@ -452,6 +452,19 @@ bool TerminalDispatch::EnableXtermBracketedPasteMode(const bool enabled) noexcep
     return true;
 }
 
+//Routine Description:
+// Enable Synchronized Output Mode - While set, the application is in the
+//      middle of updating the screen, and the renderer holds back frames
+//      until it's reset again (or a timeout passes).
+//Arguments:
+// - enabled - true to enable, false to disable.
+// Return value:
+// True if handled successfully. False otherwise.
+bool TerminalDispatch::EnableSynchronizedOutput(const bool enabled) noexcept
+{
+    return _terminalApi.EnableSynchronizedOutput(enabled);
+}
+
 bool TerminalDispatch::SetMode(const DispatchTypes::ModeParams param) noexcept
 {
     return _ModeParamsHelper(param, true);
@@ -610,6 +623,9 @@ bool TerminalDispatch::_ModeParamsHelper(const DispatchTypes::ModeParams param,
     case DispatchTypes::ModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        success = EnableSynchronizedOutput(enable);
+        break;
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -730,6 +746,9 @@ bool TerminalDispatch::HardReset() noexcept
     // Set the DECSCNM screen mode back to normal.
     success = SetScreenMode(false) && success;
 
+    // Don't leave the renderer waiting for the end of an update that won't come.
+    success = EnableSynchronizedOutput(false) && success;
+
     // Cursor to 1,1 - the Soft Reset guarantees this is absolute
     success = CursorPosition(1, 1) && success;
 
@@ -2,6 +2,7 @@
 // Licensed under the MIT license.
 
 #include "../../terminal/adapter/termDispatch.hpp"
+#include "../../types/inc/sgrTransitionCache.hpp"
 #include "ITerminalApi.hpp"
 
 static constexpr size_t TaskbarMaxState{ 4 };
@@ -72,6 +73,7 @@ public:
     bool EnableAnyEventMouseMode(const bool enabled) noexcept override; // ?1003
     bool EnableAlternateScroll(const bool enabled) noexcept override; // ?1007
     bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
+    bool EnableSynchronizedOutput(const bool enabled) noexcept override; // ?2026
 
     bool SetMode(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::ModeParams /*param*/) noexcept override; // DECSET
     bool ResetMode(const ::Microsoft::Console::VirtualTerminal::DispatchTypes::ModeParams /*param*/) noexcept override; // DECRST
@@ -87,6 +89,8 @@ private:
     std::vector<bool> _tabStopColumns;
     bool _initDefaultTabStops = true;
 
+    ::Microsoft::Console::VirtualTerminal::SgrTransitionCache _sgrTransitions;
+
     size_t _SetRgbColorsHelper(const ::Microsoft::Console::VirtualTerminal::VTParameters options,
                                TextAttribute& attr,
                                const bool isForeground) noexcept;
@@ -94,6 +94,16 @@ bool TerminalDispatch::SetGraphicsRendition(const VTParameters options) noexcept
 {
     TextAttribute attr = _terminalApi.GetTextAttributes();
 
+    // Colorized output keeps switching between the same few renditions,
+    // so most of the time we already know what these options result in.
+    if (const auto cached = _sgrTransitions.Lookup(attr, options))
+    {
+        _terminalApi.SetTextAttributes(*cached);
+        return true;
+    }
+
+    const auto previousAttr = attr;
+
     // Run through the graphics options and apply them
     for (size_t i = 0; i < options.size(); i++)
     {
@@ -273,6 +283,7 @@ bool TerminalDispatch::SetGraphicsRendition(const VTParameters options) noexcept
         }
     }
 
+    _sgrTransitions.Store(previousAttr, options, attr);
     _terminalApi.SetTextAttributes(attr);
     return true;
 }
@@ -1042,6 +1042,103 @@ winrt::Microsoft::Terminal::Settings::Model::ColorScheme CascadiaSettings::GetCo
     return _globals->ColorSchemes().TryLookup(schemeName);
 }
 
+// Method Description:
+// - Finds the active profiles whose terminal settings might have changed since
+//   the given settings were loaded, so that a settings reload only has to
+//   reapply those. A profile counts as unchanged if it, every profile it
+//   inherits from and the color schemes it uses serialize the same way in both
+//   settings. Any change to the global settings changes every profile, since
+//   the terminal settings are created from those too.
+// Arguments:
+// - previous: the settings to compare against. If null, every profile changed.
+// Return Value:
+// - the GUIDs of the changed profiles, in the order of the active profiles.
+IVectorView<winrt::guid> CascadiaSettings::ChangedProfiles(const Model::CascadiaSettings& previous) const
+{
+    std::vector<winrt::guid> changedProfiles;
+
+    const auto previousImpl{ previous ? winrt::get_self<CascadiaSettings>(previous) : nullptr };
+    const bool globalsChanged{ !previousImpl || previousImpl->_globals->ToJson() != _globals->ToJson() };
+
+    std::map<winrt::guid, Model::Profile> previousProfiles;
+    if (!globalsChanged)
+    {
+        for (const auto& profile : previousImpl->_allProfiles)
+        {
+            previousProfiles.emplace(profile.Guid(), profile);
+        }
+    }
+
+    for (const auto& profile : _activeProfiles)
+    {
+        const auto guid{ profile.Guid() };
+        const auto previousProfile{ previousProfiles.find(guid) };
+        if (globalsChanged || previousProfile == previousProfiles.end())
+        {
+            changedProfiles.emplace_back(guid);
+            continue;
+        }
+
+        auto& profileImpl{ *winrt::get_self<Profile>(profile) };
+        auto& previousProfileImpl{ *winrt::get_self<Profile>(previousProfile->second) };
+        if (_ProfileLayersToJson(profileImpl) != _ProfileLayersToJson(previousProfileImpl))
+        {
+            changedProfiles.emplace_back(guid);
+            continue;
+        }
+
+        // The profiles are identical, so they refer to the same schemes.
+        // Those may still have been changed in the meantime though.
+        const auto unfocusedAppearance{ profile.UnfocusedAppearance() };
+        const auto previousGlobals{ previous.GlobalSettings() };
+        const auto globals{ GlobalSettings() };
+        if (!_IsSameColorScheme(previousGlobals, globals, profile.DefaultAppearance().ColorSchemeName()) ||
+            (unfocusedAppearance && !_IsSameColorScheme(previousGlobals, globals, unfocusedAppearance.ColorSchemeName())))
+        {
+            changedProfiles.emplace_back(guid);
+        }
+    }
+
+    return winrt::single_threaded_vector(std::move(changedProfiles)).GetView();
+}
+
+// Method Description:
+// - Serializes the given profile, along with every profile it inherits from.
+// Arguments:
+// - profile: the profile to serialize
+// Return Value:
+// - a json array with the profile first, followed by its parents' layers.
+Json::Value CascadiaSettings::_ProfileLayersToJson(Profile& profile)
+{
+    Json::Value json{ Json::ValueType::arrayValue };
+    json.append(profile.ToJson());
+    for (const auto& parent : profile.Parents())
+    {
+        json.append(_ProfileLayersToJson(*parent));
+    }
+    return json;
+}
+
+// Method Description:
+// - Checks whether the color scheme with the given name is the same in both
+//   global settings. A scheme missing from both counts as the same.
+// Arguments:
+// - previous: the global settings to compare against
+// - current: the global settings to compare
+// - schemeName: the name of the scheme to compare
+// Return Value:
+// - true if the scheme serializes the same way in both settings.
+bool CascadiaSettings::_IsSameColorScheme(const Model::GlobalAppSettings& previous, const Model::GlobalAppSettings& current, const hstring& schemeName)
+{
+    const auto previousScheme{ previous.ColorSchemes().TryLookup(schemeName) };
+    const auto currentScheme{ current.ColorSchemes().TryLookup(schemeName) };
+    if (!previousScheme || !currentScheme)
+    {
+        return !previousScheme && !currentScheme;
+    }
+    return winrt::get_self<ColorScheme>(previousScheme)->ToJson() == winrt::get_self<ColorScheme>(currentScheme)->ToJson();
+}
+
 // Method Description:
 // - updates all references to that color scheme with the new name
 // Arguments:
@@ -89,6 +89,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Model::Profile FindProfile(guid profileGuid) const noexcept;
         Model::ColorScheme GetColorSchemeForProfile(const guid profileGuid) const;
         void UpdateColorSchemeReferences(const hstring oldName, const hstring newName);
+        Windows::Foundation::Collections::IVectorView<guid> ChangedProfiles(const Model::CascadiaSettings& previous) const;
 
         Windows::Foundation::Collections::IVectorView<SettingsLoadWarnings> Warnings();
         void ClearWarnings();
@@ -124,6 +125,8 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         Json::Value _defaultSettings;
         winrt::com_ptr<Profile> _userDefaultProfileSettings{ nullptr };
 
+        static com_ptr<CascadiaSettings> _LoadDefaultsUncached();
+
         void _LayerOrCreateProfile(const Json::Value& profileJson);
         winrt::com_ptr<implementation::Profile> _FindMatchingProfile(const Json::Value& profileJson);
         std::optional<uint32_t> _FindMatchingProfileIndex(const Json::Value& profileJson);
@@ -170,6 +173,9 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
 
         bool _HasInvalidColorScheme(const Model::Command& command);
 
+        static Json::Value _ProfileLayersToJson(Profile& profile);
+        static bool _IsSameColorScheme(const Model::GlobalAppSettings& previous, const Model::GlobalAppSettings& current, const hstring& schemeName);
+
         friend class SettingsModelLocalTests::SerializationTests;
         friend class SettingsModelLocalTests::DeserializationTests;
         friend class SettingsModelLocalTests::ProfileTests;
@@ -307,11 +307,28 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
 // Function Description:
 // - Creates a new CascadiaSettings object initialized with settings from the
 //   hardcoded defaults.json.
+// - defaults.json is baked into the binary, so parsing and layering it yields
+//   the same result every time. We only do that once per process and hand
+//   out copies of the result, which skips the JSON parser entirely for every
+//   subsequent load (settings reloads, LoadAll, the settings UI, ...).
 // Arguments:
 // - <none>
 // Return Value:
 // - a unique_ptr to a CascadiaSettings with the settings from defaults.json
 winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::LoadDefaults()
+{
+    static const auto defaults{ _LoadDefaultsUncached() };
+    return defaults->Copy();
+}
+
+// Function Description:
+// - Parses and layers the hardcoded defaults.json into a new CascadiaSettings.
+//   See LoadDefaults, which caches the result of this.
+// Arguments:
+// - <none>
+// Return Value:
+// - a CascadiaSettings with the settings from defaults.json
+winrt::com_ptr<CascadiaSettings> CascadiaSettings::_LoadDefaultsUncached()
 {
     auto resultPtr{ winrt::make_self<CascadiaSettings>() };
 
@@ -330,7 +347,7 @@ winrt::Microsoft::Terminal::Settings::Model::CascadiaSettings CascadiaSettings::
         profileImpl->Origin(OriginTag::InBox);
     }
 
-    return *resultPtr;
+    return resultPtr;
 }
 
 // Method Description:
@@ -32,6 +32,8 @@ namespace ControlUnitTests
 
         TEST_METHOD(TestFontInitializedInCtor);
 
+        TEST_METHOD(TestOutputStatistics);
+
         TEST_CLASS_SETUP(ModuleSetup)
         {
             winrt::init_apartment(winrt::apartment_type::single_threaded);
@@ -197,4 +199,43 @@ namespace ControlUnitTests
         VERIFY_ARE_EQUAL(L"Impact", std::wstring_view{ core->_actualFont.GetFaceName() });
     }
 
+    void ControlCoreTests::TestOutputStatistics()
+    {
+        auto [settings, conn] = _createSettingsAndConnection();
+
+        Log::Comment(L"Create ControlCore object");
+        auto core = winrt::make_self<Control::implementation::ControlCore>(*settings, *conn);
+        VERIFY_IS_NOT_NULL(core);
+        core->Initialize(270, 380, 1.0);
+        VERIFY_IS_TRUE(core->_initializedTerminal);
+
+        auto statistics = core->OutputStatistics();
+        VERIFY_ARE_EQUAL(0u, statistics.CharactersReceived);
+        VERIFY_ARE_EQUAL(0, statistics.ParseTime.count());
+
+        Log::Comment(L"Write more than one slice of output, with a surrogate pair across the slice boundary");
+        // The CUP right before U+1F600 puts it at a known position, so that we can find it in the buffer.
+        const std::wstring_view cursorHome{ L"\x1b[1;1H" };
+        std::wstring output(core->_outputSliceLength - 1 - cursorHome.size(), L'a');
+        output.append(cursorHome);
+        output.append(L"\xD83D\xDE00");
+        VERIFY_ARE_EQUAL(L'\xD83D', output.at(core->_outputSliceLength - 1), L"The high surrogate is the last code unit of the first slice");
+        conn->WriteInput(winrt::hstring{ output });
+
+        statistics = core->OutputStatistics();
+        VERIFY_ARE_EQUAL(output.size(), statistics.CharactersReceived);
+        VERIFY_IS_GREATER_THAN(statistics.ParseTime.count(), 0);
+        VERIFY_ARE_EQUAL(0u, statistics.ThrottledFrames, L"A single busy control is never throttled");
+
+        Log::Comment(L"The surrogate pair arrives intact and in order, as a single wide character");
+        auto lock = core->_terminal->LockForReading();
+        const auto& textBuffer = core->_terminal->GetTextBuffer();
+        auto position = textBuffer.GetCursor().GetPosition();
+        VERIFY_ARE_EQUAL(2, position.X);
+        position.X = 0;
+        const auto chars = textBuffer.GetCellDataAt(position)->Chars();
+        VERIFY_ARE_EQUAL(2u, chars.size());
+        VERIFY_ARE_EQUAL(L'\xD83D', chars.at(0));
+        VERIFY_ARE_EQUAL(L'\xDE00', chars.at(1));
+    }
 }
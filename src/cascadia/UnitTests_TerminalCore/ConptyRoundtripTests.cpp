@@ -412,8 +412,10 @@ void ConptyRoundtripTests::WriteAFewSimpleLines()
     expectedOutput.push_back("\r\n");
     expectedOutput.push_back("BBB");
     // Jump down to the fourth line because emitting spaces didn't do anything
-    // and we will skip to emitting the CCC segment.
-    expectedOutput.push_back("\x1b[4;1H");
+    // and we will skip to emitting the CCC segment. A carriage return and a
+    // CUD are shorter than the equivalent CUP.
+    expectedOutput.push_back("\r");
+    expectedOutput.push_back("\x1b[2B");
     expectedOutput.push_back("CCC");
 
     // Cursor goes back on.
@@ -1421,9 +1423,10 @@ void ConptyRoundtripTests::ScrollWithChangesInMiddle()
     const auto wrappedLineLength = TerminalViewWidth + 20;
 
     // In the Terminal, we're going to expect:
-    expectedOutput.push_back("\x1b[15;1H"); // Move the cursor to row 14, col 0
+    expectedOutput.push_back("\x1b[17A"); // Move the cursor up to row 14, col 0
     expectedOutput.push_back("Y"); // Print a 'Y'
-    expectedOutput.push_back("\x1b[32;1H"); // Move the cursor to the last row
+    expectedOutput.push_back("\r"); // Move the cursor back down to the last row
+    expectedOutput.push_back("\x1b[17B");
     expectedOutput.push_back(std::string(TerminalViewWidth, 'A')); // Print the first 80 'A's
     // This is going to be the end of the first frame - b/c we moved the cursor
     // in the middle of the frame, we're going to hide/show the cursor during
@@ -1632,10 +1635,8 @@ void ConptyRoundtripTests::ScrollWithMargins()
     // This entire block is subject to change in the future with optimizations.
     {
         // Cursor gets redrawn in the bottom right of the scroll region with the repaint that is forced
-        // early while the screen is rotated.
-        std::stringstream ss;
-        ss << "\x1b[" << initialTermView.Height() - 1 << ";" << initialTermView.Width() << "H";
-        expectedOutput.push_back(ss.str());
+        // early while the screen is rotated. That's just one row up from the end of the mode line.
+        expectedOutput.push_back("\x1b[1A");
 
         expectedOutput.push_back("\x1b[?25h"); // turn the cursor back on too.
     }
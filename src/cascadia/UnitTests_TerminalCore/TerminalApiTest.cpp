@@ -38,6 +38,7 @@ namespace TerminalCoreUnitTests
         TEST_METHOD(AddHyperlink);
         TEST_METHOD(AddHyperlinkCustomId);
         TEST_METHOD(AddHyperlinkCustomIdDifferentUri);
+        TEST_METHOD(HyperlinkAtPosition);
 
         TEST_METHOD(SetTaskbarProgress);
         TEST_METHOD(SetWorkingDirectory);
@@ -343,6 +344,34 @@ void TerminalCoreUnitTests::TerminalApiTest::AddHyperlinkCustomIdDifferentUri()
     VERIFY_ARE_NOT_EQUAL(oldAttributes.GetHyperlinkId(), tbi.GetCurrentAttributes().GetHyperlinkId());
 }
 
+void TerminalCoreUnitTests::TerminalApiTest::HyperlinkAtPosition()
+{
+    Terminal term;
+    DummyRenderTarget emptyRT;
+    term.Create({ 100, 100 }, 0, emptyRT);
+
+    auto& tbi = *(term._buffer);
+    auto& stateMachine = *(term._stateMachine);
+
+    stateMachine.ProcessString(L"ab\x1b]8;id=myId;test.url\x9cHello\x1b]8;;\x9c cd");
+
+    // Neither the text before nor after the link is part of it
+    VERIFY_ARE_EQUAL(0u, term.GetHyperlinkIdAtPosition({ 1, 0 }));
+    VERIFY_ARE_EQUAL(0u, term.GetHyperlinkIdAtPosition({ 7, 0 }));
+    VERIFY_ARE_EQUAL(L"", term.GetHyperlinkAtPosition({ 8, 0 }));
+
+    const auto id = term.GetHyperlinkIdAtPosition({ 2, 0 });
+    VERIFY_ARE_NOT_EQUAL(0u, id);
+    VERIFY_ARE_EQUAL(id, term.GetHyperlinkIdAtPosition({ 6, 0 }));
+    VERIFY_ARE_EQUAL(L"test.url", term.GetHyperlinkAtPosition({ 4, 0 }));
+
+    // The render data accessors hand out views into the buffer's maps
+    VERIFY_IS_TRUE(term.GetHyperlinkUri(id) == L"test.url");
+    // (custom IDs are stored with the hash of their URI appended - GH#7698)
+    VERIFY_IS_TRUE(term.GetHyperlinkCustomId(id).substr(0, 5) == L"myId%");
+    VERIFY_IS_TRUE(tbi.GetCustomIdFromId(0).empty());
+}
+
 void TerminalCoreUnitTests::TerminalApiTest::SetTaskbarProgress()
 {
     Terminal term;
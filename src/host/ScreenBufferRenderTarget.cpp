@@ -110,3 +110,14 @@ void ScreenBufferRenderTarget::TriggerTitleChange()
         pRenderer->TriggerTitleChange();
     }
 }
+
+void ScreenBufferRenderTarget::SetSynchronizedOutput(const bool enabled)
+{
+    // Synchronized output applies to the renderer as a whole rather than to a
+    // particular buffer, so this is forwarded even if we aren't the active one.
+    auto* pRenderer = ServiceLocator::LocateGlobals().pRender;
+    if (pRenderer != nullptr)
+    {
+        pRenderer->SetSynchronizedOutput(enabled);
+    }
+}
@@ -39,6 +39,7 @@ public:
     void TriggerScroll(const COORD* const pcoordDelta) override;
     void TriggerCircling() override;
     void TriggerTitleChange() override;
+    void SetSynchronizedOutput(const bool enabled) override;
 
 private:
     SCREEN_INFORMATION& _owner;
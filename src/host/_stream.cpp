@@ -555,13 +555,18 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
             // line was wrapped if we're writing up to the end of the current row
             OutputCellIterator it(std::wstring_view(LocalBuffer, i), Attributes);
             const auto itEnd = screenInfo.Write(it);
+            const auto cellsWritten = itEnd.GetCellDistance(it);
 
-            // Notify accessibility
-            screenInfo.NotifyAccessibilityEventing(CursorPosition.X, CursorPosition.Y, CursorPosition.X + gsl::narrow<SHORT>(i - 1), CursorPosition.Y);
+            // Notify accessibility of the cells we wrote. Wide characters and surrogate
+            // pairs make that differ from the number of code units.
+            if (cellsWritten > 0)
+            {
+                screenInfo.NotifyAccessibilityEventing(CursorPosition.X, CursorPosition.Y, CursorPosition.X + gsl::narrow<SHORT>(cellsWritten - 1), CursorPosition.Y);
+            }
 
             // The number of "spaces" or "cells" we have consumed needs to be reported and stored for later
             // when/if we need to erase the command line.
-            TempNumSpaces += itEnd.GetCellDistance(it);
+            TempNumSpaces += cellsWritten;
             // WCL-NOTE: We are using the "estimated" X position delta instead of the actual delta from
             // WCL-NOTE: the iterator. It is not clear why. If they differ, the cursor ends up in the
             // WCL-NOTE: wrong place (typically inside another character).
@@ -905,6 +910,152 @@ constexpr unsigned int LOCAL_BUFFER_SIZE = 100;
     return STATUS_SUCCESS;
 }
 
+// Routine Description:
+// - This routine writes a run of printable characters to the screen. The VT state
+//   machine has already routed every control character elsewhere, so unlike
+//   WriteCharsLegacy there is nothing to interpret: as much of the run as fits
+//   onto the current line is written at once and the cursor is moved afterwards.
+// Arguments:
+// - screenInfo - reference to screen buffer information structure.
+// - string - the printable characters to write.
+// Return Value:
+// - STATUS_SUCCESS or the failure that occurred while writing or moving the cursor.
+[[nodiscard]] NTSTATUS WriteCharsVt(SCREEN_INFORMATION& screenInfo,
+                                    const std::wstring_view string)
+{
+    TextBuffer& textBuffer = screenInfo.GetTextBuffer();
+    Cursor& cursor = textBuffer.GetCursor();
+    const bool fWrapAtEOL = WI_IsFlagSet(screenInfo.OutputMode, ENABLE_WRAP_AT_EOL_OUTPUT);
+    const TextAttribute Attributes = screenInfo.GetAttributes();
+
+    auto remaining = string;
+    while (!remaining.empty())
+    {
+        COORD CursorPosition = cursor.GetPosition();
+
+        // correct for delayed EOL
+        if (cursor.IsDelayedEOLWrap() && fWrapAtEOL)
+        {
+            const COORD coordDelayedAt = cursor.GetDelayedAtPosition();
+            cursor.ResetDelayEOLWrap();
+            // Only act on a delayed EOL if we didn't move the cursor to a different position from where the EOL was marked.
+            if (coordDelayedAt.X == CursorPosition.X && coordDelayedAt.Y == CursorPosition.Y)
+            {
+                CursorPosition.X = 0;
+                CursorPosition.Y++;
+
+                const auto Status = AdjustCursorPosition(screenInfo, CursorPosition, FALSE, nullptr);
+                if (!NT_SUCCESS(Status))
+                {
+                    return Status;
+                }
+
+                CursorPosition = cursor.GetPosition();
+            }
+        }
+
+        // In VT mode, the width at which we wrap is determined by the line rendition attribute.
+        const SHORT lineWidth = textBuffer.GetLineWidth(CursorPosition.Y);
+
+        // Measure how much of the run fits onto the rest of this line.
+        // Like WriteCharsLegacy, this measures single code units.
+        SHORT XPosition = CursorPosition.X;
+        size_t length = 0;
+        while (length < remaining.size() && XPosition < lineWidth)
+        {
+            if (IsGlyphFullWidth(til::at(remaining, length)))
+            {
+                if (XPosition >= lineWidth - 1)
+                {
+                    break;
+                }
+                XPosition += 2;
+            }
+            else
+            {
+                XPosition++;
+            }
+            length++;
+        }
+
+        // If not even a single character fits, we're looking at a wide character in
+        // the last column (or a cursor beyond the end of a double-width line).
+        // Those rare cases are left to WriteCharsLegacy, one character at a time.
+        if (length == 0)
+        {
+            size_t cb = sizeof(wchar_t);
+            const auto Status = WriteCharsLegacy(screenInfo,
+                                                 remaining.data(),
+                                                 remaining.data(),
+                                                 remaining.data(),
+                                                 &cb,
+                                                 nullptr,
+                                                 CursorPosition.X,
+                                                 WC_LIMIT_BACKSPACE | WC_DELAY_EOL_WRAP,
+                                                 nullptr);
+            if (!NT_SUCCESS(Status))
+            {
+                return Status;
+            }
+            remaining = remaining.substr(1);
+            continue;
+        }
+
+        try
+        {
+            OutputCellIterator it(remaining.substr(0, length), Attributes);
+            screenInfo.Write(it);
+        }
+        catch (...)
+        {
+            return NTSTATUS_FROM_HRESULT(wil::ResultFromCaughtException());
+        }
+
+        // Notify accessibility of the columns the run covers, as measured above.
+        // Wide characters make that differ from the number of code units.
+        screenInfo.NotifyAccessibilityEventing(CursorPosition.X, CursorPosition.Y, gsl::narrow_cast<SHORT>(XPosition - 1), CursorPosition.Y);
+
+        remaining = remaining.substr(length);
+        CursorPosition.X = XPosition;
+
+        if (CursorPosition.X >= lineWidth && fWrapAtEOL)
+        {
+            // Our cursor position as of this time is going to remain on the last position in this column.
+            CursorPosition.X = lineWidth - 1;
+
+            if (remaining.empty())
+            {
+                // Delay the newline until the next character is printed, as that might never happen.
+                cursor.SetPosition(CursorPosition);
+                cursor.DelayEOLWrap(CursorPosition);
+            }
+            else
+            {
+                // There's more to print, so we'd resolve the delayed newline right away.
+                // Move straight to the next line instead of parking the cursor at the end of this one.
+                CursorPosition.X = 0;
+                CursorPosition.Y++;
+
+                const auto Status = AdjustCursorPosition(screenInfo, CursorPosition, FALSE, nullptr);
+                if (!NT_SUCCESS(Status))
+                {
+                    return Status;
+                }
+            }
+        }
+        else
+        {
+            const auto Status = AdjustCursorPosition(screenInfo, CursorPosition, FALSE, nullptr);
+            if (!NT_SUCCESS(Status))
+            {
+                return Status;
+            }
+        }
+    }
+
+    return STATUS_SUCCESS;
+}
+
 // Routine Description:
 // - This routine writes a string to the screen, processing any embedded
 //   unicode characters.  The string is also copied to the input buffer, if
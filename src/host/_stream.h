@@ -77,6 +77,23 @@ Note:
                                         const DWORD dwFlags,
                                         _Inout_opt_ PSHORT const psScrollY);
 
+/*++
+Routine Description:
+    This routine writes a run of printable characters, as separated from any
+    control characters by the VT state machine, to the screen. It behaves like
+    WriteCharsLegacy with WC_LIMIT_BACKSPACE | WC_DELAY_EOL_WRAP, but writes
+    as much of the run as fits onto each line at once, straight from the string.
+
+Arguments:
+    ScreenInfo - Pointer to screen buffer information structure.
+    string - The printable characters to write.
+
+Return Value:
+    STATUS_SUCCESS or the failure that occurred while writing or moving the cursor.
+--*/
+[[nodiscard]] NTSTATUS WriteCharsVt(SCREEN_INFORMATION& screenInfo,
+                                    const std::wstring_view string);
+
 // The new entry point for WriteChars to act as an intercept in case we place a Virtual Terminal processor in the way.
 [[nodiscard]] NTSTATUS WriteChars(SCREEN_INFORMATION& screenInfo,
                                   _In_range_(<=, pwchBuffer) const wchar_t* const pwchBufferBackupLimit,
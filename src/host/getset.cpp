@@ -1597,6 +1597,19 @@ void DoSrvPrivateEnableAlternateScroll(const bool fEnable)
     gci.GetActiveInputBuffer()->GetTerminalInput().EnableAlternateScroll(fEnable);
 }
 
+// Routine Description:
+// - A private API call for synchronized output mode. While enabled, the
+//   renderer holds back frames so that it doesn't paint a partial update.
+// Parameters:
+// - screenInfo - The screen buffer the application is writing to.
+// - fEnable - true to start a synchronized update, false to finish it.
+// Return value:
+// None
+void DoSrvPrivateEnableSynchronizedOutput(SCREEN_INFORMATION& screenInfo, const bool fEnable)
+{
+    screenInfo.GetRenderTarget().SetSynchronizedOutput(fEnable);
+}
+
 // Routine Description:
 // - A private API call for performing a VT-style erase all operation on the buffer.
 //      See SCREEN_INFORMATION::VtEraseAll's description for details.
@@ -2206,12 +2219,23 @@ void DoSrvPrivateMoveToBottom(SCREEN_INFORMATION& screenInfo)
             fillAttrs.SetStandardErase();
         }
 
-        const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
-        screenInfo.Write(fillData, startPosition, false);
+        // Clearing everything from the start of a row to the end of the
+        // buffer (like ED 3 does for the scrollback) doesn't need to visit
+        // every cell. The text buffer can discard the rows instead.
+        const auto bufferSize = screenInfo.GetBufferSize();
+        const auto cellsToEnd = gsl::narrow_cast<size_t>(bufferSize.Width()) * (bufferSize.Height() - startPosition.Y);
+        if (fillChar == UNICODE_SPACE && startPosition.X == 0 && startPosition.Y >= 0 && fillLength == cellsToEnd)
+        {
+            screenInfo.GetTextBuffer().ClearRowsFrom(startPosition.Y, fillAttrs);
+        }
+        else
+        {
+            const auto fillData = OutputCellIterator{ fillChar, fillAttrs, fillLength };
+            screenInfo.Write(fillData, startPosition, false);
+        }
 
         // Notify accessibility
         auto endPosition = startPosition;
-        const auto bufferSize = screenInfo.GetBufferSize();
         bufferSize.MoveInBounds(fillLength - 1, endPosition);
         screenInfo.NotifyAccessibilityEventing(startPosition.X, startPosition.Y, endPosition.X, endPosition.Y);
         return S_OK;
@@ -30,7 +30,7 @@ WriteBuffer::WriteBuffer(_In_ Microsoft::Console::IIoProvider& io) :
 // - <none>
 void WriteBuffer::Print(const wchar_t wch)
 {
-    _DefaultCase(wch);
+    PrintString({ &wch, 1 });
 }
 
 // Routine Description:
@@ -41,7 +41,19 @@ void WriteBuffer::Print(const wchar_t wch)
 // - <none>
 void WriteBuffer::PrintString(const std::wstring_view string)
 {
-    _DefaultStringCase(string);
+    auto& screenInfo = _io.GetActiveOutputBuffer();
+
+    // The state machine only hands us printable characters here, so in VT mode
+    // they can skip the control character handling of WriteCharsLegacy.
+    if (WI_IsFlagSet(screenInfo.OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING))
+    {
+        screenInfo.GetTextBuffer().GetCursor().SetIsOn(true);
+        _ntstatus = WriteCharsVt(screenInfo, string);
+    }
+    else
+    {
+        _DefaultStringCase(string);
+    }
 }
 
 // Routine Description:
@@ -515,6 +527,20 @@ bool ConhostInternalGetSet::PrivateEnableAlternateScroll(const bool enabled)
     return true;
 }
 
+// Routine Description:
+// - Connects the PrivateEnableSynchronizedOutput call directly into our Driver Message servicing call inside Conhost.exe
+//   PrivateEnableSynchronizedOutput is an internal-only "API" call that the vt commands can execute,
+//     but it is not represented as a function call on out public API surface.
+// Arguments:
+// - enabled - set to true to hold back frames until the update is finished, false to resume painting
+// Return Value:
+// - true if successful (see DoSrvPrivateEnableSynchronizedOutput). false otherwise.
+bool ConhostInternalGetSet::PrivateEnableSynchronizedOutput(const bool enabled)
+{
+    DoSrvPrivateEnableSynchronizedOutput(_io.GetActiveOutputBuffer(), enabled);
+    return true;
+}
+
 // Routine Description:
 // - Connects the PrivateEraseAll call directly into our Driver Message servicing call inside Conhost.exe
 //   PrivateEraseAll is an internal-only "API" call that the vt commands can execute,
@@ -103,6 +103,7 @@ public:
     bool PrivateEnableButtonEventMouseMode(const bool enabled) override;
     bool PrivateEnableAnyEventMouseMode(const bool enabled) override;
     bool PrivateEnableAlternateScroll(const bool enabled) override;
+    bool PrivateEnableSynchronizedOutput(const bool enabled) override;
     bool PrivateEraseAll() override;
 
     bool GetUserDefaultCursorStyle(CursorType& style) override;
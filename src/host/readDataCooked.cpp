@@ -66,6 +66,7 @@ COOKED_READ_DATA::COOKED_READ_DATA(_In_ InputBuffer* const pInputBuffer,
     _controlKeyState{ 0 },
     _ctrlWakeupMask{ CtrlWakeupMask },
     _visibleCharCount{ 0 },
+    _pendingEchoCount{ 0 },
     _originalCursorPosition{ -1, -1 },
     _beforeDialogCursorPosition{ 0, 0 },
 
@@ -955,6 +956,8 @@ void COOKED_READ_DATA::SavePendingInput(const size_t index, const bool multiline
 
         if (commandLineEditingKeys)
         {
+            _flushPendingEcho();
+
             // TODO: this is super weird for command line popups only
             _unicode = isUnicode;
 
@@ -978,8 +981,18 @@ void COOKED_READ_DATA::SavePendingInput(const size_t index, const bool multiline
                 break;
             }
         }
+        else if (_canBatchEcho(wch))
+        {
+            // Pastes arrive as a long run of printable characters. Echoing
+            // them one at a time renders the line once per character, so we
+            // store them right away and echo the whole run at once, as soon
+            // as we run out of input or get anything else.
+            _storeBatchedChar(wch);
+        }
         else
         {
+            _flushPendingEcho();
+
             if (ProcessInput(wch, keyState, Status))
             {
                 CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -988,9 +1001,82 @@ void COOKED_READ_DATA::SavePendingInput(const size_t index, const bool multiline
             }
         }
     }
+
+    _flushPendingEcho();
+
     return Status;
 }
 
+// Routine Description:
+// - Determines whether the given character can be stored without being echoed
+//   right away. That is the case for printable characters at the end of the
+//   line, where ProcessInput would do nothing but store and echo them.
+// Arguments:
+// - wch - The character retrieved from the input buffer
+// Return Value:
+// - true if the character can be stored with _storeBatchedChar.
+bool COOKED_READ_DATA::_canBatchEcho(const wchar_t wch) const noexcept
+{
+    return _echoInput &&
+           AtEol() &&
+           wch >= UNICODE_SPACE &&
+           wch != UNICODE_BACKSPACE2 &&
+           wch != EXTKEY_ERASE_PREV_WORD &&
+           _bytesRead < (_bufferSize - (2 * sizeof(WCHAR)));
+}
+
+// Routine Description:
+// - Stores a character at the end of the line like ProcessInput would, but
+//   leaves echoing it to the next call to _flushPendingEcho.
+// Arguments:
+// - wch - The character to store
+void COOKED_READ_DATA::_storeBatchedChar(const wchar_t wch) noexcept
+{
+    *_bufPtr = wch;
+    _bytesRead += sizeof(WCHAR);
+    _bufPtr += 1;
+    _currentPosition += 1;
+    _pendingEchoCount += 1;
+}
+
+// Routine Description:
+// - Echoes all the characters stored by _storeBatchedChar with a single call
+//   to WriteCharsLegacy. This must happen before anything else touches the
+//   edit line, so that the screen and our bookkeeping agree again.
+void COOKED_READ_DATA::_flushPendingEcho() noexcept
+{
+    if (_pendingEchoCount == 0)
+    {
+        return;
+    }
+
+    const wchar_t* const pending = _bufPtr - _pendingEchoCount;
+    size_t NumToWrite = _pendingEchoCount * sizeof(WCHAR);
+    size_t NumSpaces = 0;
+    SHORT ScrollY = 0;
+    _pendingEchoCount = 0;
+
+    const auto status = WriteCharsLegacy(_screenInfo,
+                                         _backupLimit,
+                                         pending,
+                                         pending,
+                                         &NumToWrite,
+                                         &NumSpaces,
+                                         _originalCursorPosition.X,
+                                         WC_DESTRUCTIVE_BACKSPACE | WC_KEEP_CURSOR_VISIBLE | WC_PRINTABLE_CONTROL_CHARS,
+                                         &ScrollY);
+    if (NT_SUCCESS(status))
+    {
+        _originalCursorPosition.Y += ScrollY;
+    }
+    else
+    {
+        RIPMSG1(RIP_WARNING, "WriteCharsLegacy failed %x", status);
+    }
+
+    _visibleCharCount += NumSpaces;
+}
+
 // Routine Description:
 // - handles any tasks that need to be completed after the read input loop finishes
 // Arguments:
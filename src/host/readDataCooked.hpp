@@ -144,6 +144,7 @@ private:
     ULONG _controlKeyState;
     ULONG _ctrlWakeupMask;
     size_t _visibleCharCount; // TODO MSFT:11285829 is this cells or glyphs? ie. is a wide char counted as 1 or 2?
+    size_t _pendingEchoCount; // chars at the end of the line that are stored but not echoed yet
     SCREEN_INFORMATION& _screenInfo;
 
     // Note that cookedReadData's _originalCursorPosition is the position before ANY text was entered on the edit line.
@@ -158,5 +159,9 @@ private:
 
     [[nodiscard]] NTSTATUS _readCharInputLoop(const bool isUnicode, size_t& numBytes) noexcept;
 
+    bool _canBatchEcho(const wchar_t wch) const noexcept;
+    void _storeBatchedChar(const wchar_t wch) noexcept;
+    void _flushPendingEcho() noexcept;
+
     [[nodiscard]] NTSTATUS _handlePostCharInputLoop(const bool isUnicode, size_t& numBytes, ULONG& controlKeyState) noexcept;
 };
@@ -56,10 +56,11 @@ public:
 
     const std::wstring_view GetConsoleTitle() const noexcept override;
 
-    const std::wstring GetHyperlinkUri(uint16_t id) const noexcept override;
-    const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept override;
+    std::wstring_view GetHyperlinkUri(uint16_t id) const noexcept override;
+    std::wstring_view GetHyperlinkCustomId(uint16_t id) const noexcept override;
 
     const std::vector<size_t> GetPatternId(const COORD location) const noexcept override;
+    uint64_t GetPatternGeneration() const noexcept override;
 #pragma endregion
 
 #pragma region IUiaData
@@ -198,13 +198,28 @@ void SCREEN_INFORMATION::s_InsertScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
 }
 
 // Routine Description:
-// - This routine removes the screen buffer pointer from the console's list of screen buffers.
+// - This routine removes the screen buffer pointer from the console's list of screen buffers
+//   and frees the screen buffer.
 // Arguments:
 // - ScreenInfo - Pointer to screen information structure.
 // Return Value:
 // Note:
 // - The console lock must be held when calling this routine.
 void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
+{
+    s_DetachScreenBuffer(pScreenInfo);
+    delete pScreenInfo;
+}
+
+// Routine Description:
+// - This routine removes the screen buffer pointer from the console's list of screen buffers,
+//   but leaves the screen buffer itself alive. The caller takes ownership of it.
+// Arguments:
+// - ScreenInfo - Pointer to screen information structure.
+// Return Value:
+// Note:
+// - The console lock must be held when calling this routine.
+void SCREEN_INFORMATION::s_DetachScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo)
 {
     CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
     if (pScreenInfo == gci.ScreenBuffers)
@@ -243,7 +258,7 @@ void SCREEN_INFORMATION::s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pSc
         }
     }
 
-    delete pScreenInfo;
+    pScreenInfo->Next = nullptr;
 }
 
 #pragma endregion
@@ -284,6 +299,8 @@ void SCREEN_INFORMATION::_FreeOutputStateMachine()
             s_RemoveScreenBuffer(_psiAlternateBuffer);
         }
 
+        // The pooled buffer shares our state machine, so it has to go first.
+        _psiPooledAltBuffer.reset();
         _stateMachine.reset();
     }
 }
@@ -1860,6 +1877,8 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
 // - STATUS_SUCCESS if handled successfully. Otherwise, an appropriate status code indicating the error.
 [[nodiscard]] NTSTATUS SCREEN_INFORMATION::_CreateAltBuffer(_Out_ SCREEN_INFORMATION** const ppsiNewScreenBuffer)
 {
+    *ppsiNewScreenBuffer = nullptr;
+
     // Create new screen buffer.
     COORD WindowSize = _viewport.Dimensions();
 
@@ -1870,13 +1889,45 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
     auto initAttributes = GetAttributes();
     initAttributes.SetStandardErase();
 
-    NTSTATUS Status = SCREEN_INFORMATION::CreateInstance(WindowSize,
-                                                         existingFont,
-                                                         WindowSize,
-                                                         initAttributes,
-                                                         GetPopupAttributes(),
-                                                         Cursor::CURSOR_SMALL_SIZE,
-                                                         ppsiNewScreenBuffer);
+    NTSTATUS Status = STATUS_SUCCESS;
+
+    // Applications like less or fzf switch to the alternate buffer and back
+    // all the time. If the buffer we left last time still has the right size,
+    // reset it in place instead of allocating a new one row by row.
+    std::unique_ptr<SCREEN_INFORMATION> pooledBuffer{ std::move(GetMainBuffer()._psiPooledAltBuffer) };
+    if (pooledBuffer && pooledBuffer->GetBufferSize().Dimensions() == WindowSize)
+    {
+        try
+        {
+            pooledBuffer->_ReinitializeAltBuffer(WindowSize, existingFont, initAttributes, GetPopupAttributes());
+            *ppsiNewScreenBuffer = pooledBuffer.release();
+        }
+        CATCH_LOG();
+    }
+    pooledBuffer.reset();
+
+    if (*ppsiNewScreenBuffer == nullptr)
+    {
+        Status = SCREEN_INFORMATION::CreateInstance(WindowSize,
+                                                    existingFont,
+                                                    WindowSize,
+                                                    initAttributes,
+                                                    GetPopupAttributes(),
+                                                    Cursor::CURSOR_SMALL_SIZE,
+                                                    ppsiNewScreenBuffer);
+        if (NT_SUCCESS(Status))
+        {
+            auto* const createdBuffer = *ppsiNewScreenBuffer;
+
+            // delete the alt buffer's state machine. We don't want it.
+            createdBuffer->_FreeOutputStateMachine(); // this has to be done before we give it a main buffer
+            // we'll attach the GetSet, etc once we successfully make this buffer the active buffer.
+
+            // Set up the new buffers references to our current state machine, dispatcher, getset, etc.
+            createdBuffer->_stateMachine = _stateMachine;
+        }
+    }
+
     if (NT_SUCCESS(Status))
     {
         // Update the alt buffer's cursor style to match our own.
@@ -1885,21 +1936,78 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
         createdBuffer->GetTextBuffer().GetCursor().SetStyle(myCursor.GetSize(), myCursor.GetColor(), myCursor.GetType());
 
         s_InsertScreenBuffer(createdBuffer);
+    }
+    return Status;
+}
 
-        // delete the alt buffer's state machine. We don't want it.
-        createdBuffer->_FreeOutputStateMachine(); // this has to be done before we give it a main buffer
-        // we'll attach the GetSet, etc once we successfully make this buffer the active buffer.
+// Routine Description:
+// - Returns a retired alternate buffer to the state that CreateInstance would
+//     have created it in, so that it can be used as a new alternate buffer.
+//     The text buffer is reused, and only the rows that were written to are cleared.
+// Parameters:
+// - coordWindowSize - the size of the window. This must match the size of the buffer.
+// - fontInfo - the font of the main buffer.
+// - defaultAttributes - the attributes to fill the buffer with.
+// - popupAttributes - the popup attributes of the main buffer.
+// Return value:
+// - <none>
+// Note:
+// - May throw. The buffer must not be used if it does.
+void SCREEN_INFORMATION::_ReinitializeAltBuffer(const COORD coordWindowSize,
+                                                const FontInfo& fontInfo,
+                                                const TextAttribute defaultAttributes,
+                                                const TextAttribute popupAttributes)
+{
+    _textBuffer->Reinitialize(defaultAttributes, Cursor::CURSOR_SMALL_SIZE);
+
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    _textBuffer->GetCursor().SetColor(gci.GetCursorColor());
+    _textBuffer->GetCursor().SetType(gci.GetCursorType());
 
-        // Set up the new buffers references to our current state machine, dispatcher, getset, etc.
-        createdBuffer->_stateMachine = _stateMachine;
+    // The remaining state is reset to the values assigned by the constructor.
+    OutputMode = ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT;
+    if (gci.GetVirtTermLevel() != 0)
+    {
+        OutputMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
     }
-    return Status;
+    ResizingWindow = 0;
+    WheelDelta = 0;
+    HWheelDelta = 0;
+    WriteConsoleDbcsLeadByte[0] = 0;
+    WriteConsoleDbcsLeadByte[1] = 0;
+    FillOutDbcsLeadChar = 0;
+    ScrollScale = 1ul;
+    _scrollMargins = Viewport::FromCoord({ 0 });
+    _rcAltSavedClientNew = { 0 };
+    _rcAltSavedClientOld = { 0 };
+    _fAltWindowChanged = false;
+    _PopupAttributes = popupAttributes;
+    _currentFont = fontInfo;
+    _desiredFont = FontInfoDesired{ fontInfo };
+    _ignoreLegacyEquivalentVTAttributes = false;
+
+    _viewport = Viewport::FromDimensions({ 0, 0 }, coordWindowSize);
+    UpdateBottom();
+}
+
+// Routine Description:
+// - Removes an alternate buffer of this main buffer from the console's list of
+//     screen buffers and keeps it around for the next call to
+//     UseAlternateScreenBuffer. A previously retired buffer is freed.
+// Parameters:
+// - psiAltBuffer - the alternate buffer to retire.
+// Return value:
+// - <none>
+void SCREEN_INFORMATION::_RetireAltBuffer(_In_ SCREEN_INFORMATION* const psiAltBuffer)
+{
+    s_DetachScreenBuffer(psiAltBuffer);
+    _psiPooledAltBuffer.reset(psiAltBuffer);
 }
 
 // Routine Description:
 // - Creates an "alternate" screen buffer for this buffer. In virtual terminals, there exists both a "main"
 //     screen buffer and an alternate. ASBSET creates a new alternate, and switches to it. If there is an already
-//     existing alternate, it is discarded. This allows applications to retain one HANDLE, and switch which buffer it points to seamlessly.
+//     existing alternate, it is retired. The last retired alternate is reset and reused by the next ASBSET. This allows applications to retain one HANDLE, and switch which buffer it points to seamlessly.
 // Parameters:
 // - None
 // Return value:
@@ -1929,7 +2037,7 @@ const SCREEN_INFORMATION& SCREEN_INFORMATION::GetMainBuffer() const
 
         if (psiOldAltBuffer != nullptr)
         {
-            s_RemoveScreenBuffer(psiOldAltBuffer); // this will also delete the old alt buffer
+            siMain._RetireAltBuffer(psiOldAltBuffer); // this keeps the old alt buffer for reuse
         }
 
         ::SetActiveScreenBuffer(*psiNewAltBuffer);
@@ -1970,8 +2078,7 @@ void SCREEN_INFORMATION::UseMainScreenBuffer()
 
         SCREEN_INFORMATION* psiAlt = psiMain->_psiAlternateBuffer;
         psiMain->_psiAlternateBuffer = nullptr;
-        s_RemoveScreenBuffer(psiAlt); // this will also delete the alt buffer
-        // deleting the alt buffer will give the GetSet back to its main
+        psiMain->_RetireAltBuffer(psiAlt); // this keeps the alt buffer for reuse
 
         // Tell the VT MouseInput handler that we're in the main buffer now
         gci.GetActiveInputBuffer()->GetTerminalInput().UseMainScreenBuffer();
@@ -124,6 +124,7 @@ public:
     // TODO: MSFT 9355062 these methods should probably be a part of construction/destruction. http://osgvsowi/9355062
     static void s_InsertScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
     static void s_RemoveScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
+    static void s_DetachScreenBuffer(_In_ SCREEN_INFORMATION* const pScreenInfo);
 
     OutputCellRect ReadRect(const Microsoft::Console::Types::Viewport location) const;
 
@@ -270,6 +271,11 @@ private:
     void _FreeOutputStateMachine();
 
     [[nodiscard]] NTSTATUS _CreateAltBuffer(_Out_ SCREEN_INFORMATION** const ppsiNewScreenBuffer);
+    void _ReinitializeAltBuffer(const COORD coordWindowSize,
+                                const FontInfo& fontInfo,
+                                const TextAttribute defaultAttributes,
+                                const TextAttribute popupAttributes);
+    void _RetireAltBuffer(_In_ SCREEN_INFORMATION* const psiAltBuffer);
 
     bool _IsAltBuffer() const;
     bool _IsInPtyMode() const;
@@ -285,6 +291,7 @@ private:
 
     SCREEN_INFORMATION* _psiAlternateBuffer; // The VT "Alternate" screen buffer.
     SCREEN_INFORMATION* _psiMainBuffer; // A pointer to the main buffer, if this is the alternate buffer.
+    std::unique_ptr<SCREEN_INFORMATION> _psiPooledAltBuffer; // The last alternate buffer we left, kept for reuse.
 
     RECT _rcAltSavedClientNew;
     RECT _rcAltSavedClientOld;
@@ -29,7 +29,7 @@ DEFINE_ENUM_FLAG_OPERATORS(TraceKeywords);
 // Arguments:
 // - onExit - Function to process when the object is destroyed (on exit)
 Tracing::Tracing(std::function<void()> onExit) :
-    _onExit(onExit)
+    _onExit(std::move(onExit))
 {
 }
 
@@ -54,8 +54,17 @@ Tracing::~Tracing()
 // Return Value:
 // - An object for the caller to hold until the API call is complete.
 //   Then destroy it to signal that the call is over so the stop trace can be written.
+// Note:
+// - This runs for every single message the IO thread services. When nobody is
+//   listening for API events (the common case), we skip both events and
+//   don't bother setting up the stop callback at all.
 Tracing Tracing::s_TraceApiCall(const NTSTATUS& result, PCSTR traceName)
 {
+    if (!TraceLoggingProviderEnabled(g_hConhostV2EventTraceProvider, WINEVENT_LEVEL_VERBOSE, TraceKeywords::API))
+    {
+        return Tracing{ nullptr };
+    }
+
     // clang-format off
     TraceLoggingWrite(
         g_hConhostV2EventTraceProvider,
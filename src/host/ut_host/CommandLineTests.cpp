@@ -405,6 +405,54 @@ class CommandLineTests
         VerifyPromptText(cookedReadData, L"\x1a"); // ctrl-z
     }
 
+    TEST_METHOD(EchoesQueuedInputAtOnce)
+    {
+        auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
+        VERIFY_IS_NOT_NULL(buffer.get());
+
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& screenInfo = gci.GetActiveOutputBuffer();
+        auto& cookedReadData = gci.CookedReadData();
+        InitCookedReadData(cookedReadData, nullptr, buffer.get(), PROMPT_SIZE);
+        const auto cursorBefore = screenInfo.GetTextBuffer().GetCursor().GetPosition();
+        cookedReadData.OriginalCursorPosition() = cursorBefore;
+
+        Log::Comment(L"Queue up a line of input, as if it was pasted, but don't press enter.");
+        const std::wstring text{ L"echo Hello, world!" };
+        std::deque<std::unique_ptr<IInputEvent>> events;
+        for (const auto wch : text)
+        {
+            events.push_back(std::make_unique<KeyEvent>(true, 1ui16, 0ui16, 0ui16, wch, 0));
+        }
+        gci.pInputBuffer->Write(events);
+
+        Log::Comment(L"The read consumes all of it, then waits for more.");
+        size_t numBytes = 0;
+        VERIFY_ARE_EQUAL(CONSOLE_STATUS_WAIT, cookedReadData._readCharInputLoop(true, numBytes));
+        VerifyPromptText(cookedReadData, text);
+        VERIFY_ARE_EQUAL(text.size(), cookedReadData._currentPosition);
+
+        Log::Comment(L"Everything we stored has been echoed before we started waiting.");
+        VERIFY_ARE_EQUAL(0u, cookedReadData._pendingEchoCount);
+        VERIFY_ARE_EQUAL(text.size(), cookedReadData.VisibleCharCount());
+
+        auto cursorAfterExpected = cursorBefore;
+        cursorAfterExpected.X += gsl::narrow<SHORT>(text.size());
+        VERIFY_ARE_EQUAL(cursorAfterExpected, screenInfo.GetTextBuffer().GetCursor().GetPosition());
+
+        auto cellIterator = screenInfo.GetCellDataAt(cursorBefore);
+        for (const auto wch : text)
+        {
+            const String expectedText(&wch, 1);
+
+            const auto actualTextValue = cellIterator->Chars();
+            const String actualText(actualTextValue.data(), gsl::narrow<int>(actualTextValue.size()));
+
+            VERIFY_ARE_EQUAL(expectedText, actualText);
+            cellIterator++;
+        }
+    }
+
     TEST_METHOD(CanDeleteCommandHistory)
     {
         auto buffer = std::make_unique<wchar_t[]>(PROMPT_SIZE);
@@ -307,8 +307,10 @@ void ConptyOutputTests::WriteAFewSimpleLines()
     expectedOutput.push_back("\r\n");
     expectedOutput.push_back("BBB");
     // Jump down to the fourth line because emitting spaces didn't do anything
-    // and we will skip to emitting the CCC segment.
-    expectedOutput.push_back("\x1b[4;1H");
+    // and we will skip to emitting the CCC segment. A carriage return and a
+    // CUD are shorter than the equivalent CUP.
+    expectedOutput.push_back("\r");
+    expectedOutput.push_back("\x1b[2B");
     expectedOutput.push_back("CCC");
 
     // Cursor goes back on.
@@ -16,6 +16,7 @@
 #include "../interactivity/inc/ServiceLocator.hpp"
 #include "../../inc/conattrs.hpp"
 #include "../../types/inc/Viewport.hpp"
+#include "../../renderer/base/Renderer.hpp"
 
 #include <sstream>
 
@@ -26,6 +27,18 @@ using namespace Microsoft::Console::Types;
 using namespace Microsoft::Console::Interactivity;
 using namespace Microsoft::Console::VirtualTerminal;
 
+// A render thread that doesn't paint, but records how often a frame was requested.
+class CountingRenderThread final : public Microsoft::Console::Render::IRenderThread
+{
+public:
+    void NotifyPaint() override { ++notifyCount; }
+    void EnablePainting() override {}
+    void DisablePainting() override {}
+    void WaitForPaintCompletionAndDisable(const DWORD /*dwTimeoutMs*/) override {}
+
+    size_t notifyCount = 0;
+};
+
 class ScreenBufferTests
 {
     CommonState* m_state;
@@ -140,6 +153,7 @@ class ScreenBufferTests
     TEST_METHOD(TestAltBufferCursorState);
     TEST_METHOD(TestAltBufferVtDispatching);
     TEST_METHOD(TestAltBufferRIS);
+    TEST_METHOD(TestAltBufferReuse);
 
     TEST_METHOD(SetDefaultsIndividuallyBothDefault);
     TEST_METHOD(SetDefaultsTogether);
@@ -185,8 +199,10 @@ class ScreenBufferTests
     TEST_METHOD(SetScreenMode);
     TEST_METHOD(SetOriginMode);
     TEST_METHOD(SetAutoWrapMode);
+    TEST_METHOD(PrintRunsAcrossLines);
 
     TEST_METHOD(HardResetBuffer);
+    TEST_METHOD(SynchronizedOutputHoldsBackFrames);
 
     TEST_METHOD(RestoreDownAltBufferWithTerminalScrolling);
 
@@ -213,6 +229,7 @@ class ScreenBufferTests
     TEST_METHOD(TestAddHyperlink);
     TEST_METHOD(TestAddHyperlinkCustomId);
     TEST_METHOD(TestAddHyperlinkCustomIdDifferentUri);
+    TEST_METHOD(TestPruneHyperlinks);
 
     TEST_METHOD(UpdateVirtualBottomWhenCursorMovesBelowIt);
     TEST_METHOD(RetainHorizontalOffsetWhenMovingToBottom);
@@ -2173,6 +2190,66 @@ void ScreenBufferTests::TestAltBufferRIS()
     VERIFY_IS_FALSE(gci.GetActiveOutputBuffer()._IsAltBuffer());
 }
 
+void ScreenBufferTests::TestAltBufferReuse()
+{
+    CONSOLE_INFORMATION& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    gci.LockConsole(); // Lock must be taken to manipulate buffer.
+    auto unlock = wil::scope_exit([&] { gci.UnlockConsole(); });
+
+    SCREEN_INFORMATION& siMain = gci.GetActiveOutputBuffer();
+    StateMachine& stateMachine = siMain.GetStateMachine();
+
+    Log::Comment(L"Switch to alt buffer and dirty it");
+    stateMachine.ProcessString(L"\x1b[?1049h");
+    SCREEN_INFORMATION* const psiAlt = &gci.GetActiveOutputBuffer();
+    VERIFY_IS_TRUE(psiAlt->_IsAltBuffer());
+    stateMachine.ProcessString(L"\x1b[31m\x1b]8;;http://example.com\x1b\\abc\x1b]8;;\x1b\\");
+    stateMachine.ProcessString(L"\x1b[5;7H\x1b[1;3r");
+    VERIFY_ARE_EQUAL(COORD({ 6, 4 }), psiAlt->GetTextBuffer().GetCursor().GetPosition());
+
+    Log::Comment(L"Return to the main buffer, which retires the alt buffer");
+    stateMachine.ProcessString(L"\x1b[?1049l");
+    VERIFY_ARE_EQUAL(&siMain, &gci.GetActiveOutputBuffer());
+    VERIFY_IS_NULL(siMain._psiAlternateBuffer);
+    VERIFY_ARE_EQUAL(psiAlt, siMain._psiPooledAltBuffer.get());
+    for (auto psi = gci.ScreenBuffers; psi != nullptr; psi = psi->Next)
+    {
+        VERIFY_ARE_NOT_EQUAL(psiAlt, psi);
+    }
+
+    Log::Comment(L"Switch to the alt buffer again, which reuses the retired one");
+    stateMachine.ProcessString(L"\x1b[?1049h");
+    VERIFY_ARE_EQUAL(psiAlt, &gci.GetActiveOutputBuffer());
+    VERIFY_IS_NULL(siMain._psiPooledAltBuffer.get());
+    VERIFY_ARE_EQUAL(psiAlt, siMain._psiAlternateBuffer);
+
+    Log::Comment(L"The reused buffer is indistinguishable from a new one");
+    const auto& textBuffer = psiAlt->GetTextBuffer();
+    const auto& cursor = textBuffer.GetCursor();
+    auto expectedAttributes = siMain.GetAttributes();
+    expectedAttributes.SetStandardErase();
+    VERIFY_ARE_EQUAL(COORD({ 0, 0 }), cursor.GetPosition());
+    VERIFY_IS_FALSE(psiAlt->AreMarginsSet());
+    VERIFY_ARE_EQUAL(L" ", textBuffer.GetCellDataAt({ 0, 0 })->Chars());
+    VERIFY_ARE_EQUAL(expectedAttributes, textBuffer.GetCellDataAt({ 0, 0 })->TextAttr());
+    VERIFY_ARE_EQUAL(expectedAttributes, textBuffer.GetCurrentAttributes());
+    VERIFY_THROWS(textBuffer.GetHyperlinkUriFromId(1), std::out_of_range);
+    VERIFY_ARE_EQUAL(0, psiAlt->GetViewport().Top());
+    VERIFY_ARE_EQUAL(siMain.GetViewport().Dimensions(), psiAlt->GetBufferSize().Dimensions());
+
+    Log::Comment(L"Repeated switches keep reusing the same buffer");
+    for (auto i = 0; i < 100; ++i)
+    {
+        stateMachine.ProcessString(L"\x1b[?1049lX\x1b[?1049hY");
+        VERIFY_ARE_EQUAL(psiAlt, &gci.GetActiveOutputBuffer());
+        VERIFY_ARE_EQUAL(L"Y", textBuffer.GetCellDataAt({ 0, 0 })->Chars());
+        VERIFY_ARE_EQUAL(L" ", textBuffer.GetCellDataAt({ 1, 0 })->Chars());
+    }
+
+    stateMachine.ProcessString(L"\x1b[?1049l");
+    VERIFY_IS_FALSE(gci.GetActiveOutputBuffer()._IsAltBuffer());
+}
+
 void ScreenBufferTests::SetDefaultsIndividuallyBothDefault()
 {
     // Tests MSFT:19828103
@@ -4690,6 +4767,53 @@ void ScreenBufferTests::SetAutoWrapMode()
     VERIFY_ARE_EQUAL(COORD({ 3, startLine + 1 }), cursor.GetPosition());
 }
 
+void ScreenBufferTests::PrintRunsAcrossLines()
+{
+    auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer();
+    auto& stateMachine = si.GetStateMachine();
+    auto& cursor = si.GetTextBuffer().GetCursor();
+    const auto attributes = si.GetAttributes();
+    WI_SetFlag(si.OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+    const auto view = Viewport::FromDimensions({ 0, 0 }, { 80, 25 });
+    si.SetViewport(view, true);
+
+    Log::Comment(L"A run longer than a line is written across several lines in one go.");
+    std::wstring run;
+    for (auto i = 0; i < 200; ++i)
+    {
+        run += gsl::narrow_cast<wchar_t>(L'A' + i % 26);
+    }
+    cursor.SetPosition({ 10, 0 });
+    stateMachine.ProcessString(run);
+    VERIFY_IS_TRUE(_ValidateLineContains({ 10, 0 }, std::wstring_view{ run }.substr(0, 70), attributes));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 1 }, std::wstring_view{ run }.substr(70, 80), attributes));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 2 }, std::wstring_view{ run }.substr(150), attributes));
+    VERIFY_IS_TRUE(si.GetTextBuffer().GetRowByOffset(0).WasWrapForced());
+    VERIFY_IS_TRUE(si.GetTextBuffer().GetRowByOffset(1).WasWrapForced());
+    VERIFY_IS_FALSE(si.GetTextBuffer().GetRowByOffset(2).WasWrapForced());
+    VERIFY_ARE_EQUAL(COORD({ 50, 2 }), cursor.GetPosition());
+
+    Log::Comment(L"A run that ends in the last column delays the wrap until the next character.");
+    cursor.SetPosition({ 77, 4 });
+    stateMachine.ProcessString(L"abc");
+    VERIFY_ARE_EQUAL(COORD({ 79, 4 }), cursor.GetPosition());
+    VERIFY_IS_TRUE(cursor.IsDelayedEOLWrap());
+    stateMachine.ProcessString(L"d");
+    VERIFY_IS_TRUE(_ValidateLineContains({ 77, 4 }, L"abc", attributes));
+    VERIFY_IS_TRUE(_ValidateLineContains({ 0, 5 }, L"d", attributes));
+    VERIFY_ARE_EQUAL(COORD({ 1, 5 }), cursor.GetPosition());
+
+    Log::Comment(L"A wide character that doesn't fit into the last column is moved to the next line.");
+    cursor.SetPosition({ 78, 7 });
+    stateMachine.ProcessString(L"a\x3042" L"b");
+    VERIFY_IS_TRUE(_ValidateLineContains({ 78, 7 }, L"a", attributes));
+    VERIFY_IS_TRUE(si.GetTextBuffer().GetRowByOffset(7).WasDoubleBytePadded());
+    VERIFY_IS_TRUE(_ValidateLineContains({ 2, 8 }, L"b", attributes));
+    VERIFY_ARE_EQUAL(COORD({ 3, 8 }), cursor.GetPosition());
+}
+
 void ScreenBufferTests::HardResetBuffer()
 {
     auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
@@ -4754,6 +4878,62 @@ void ScreenBufferTests::HardResetBuffer()
     VERIFY_ARE_EQUAL(TextAttribute{}, si.GetAttributes());
 }
 
+void ScreenBufferTests::SynchronizedOutputHoldsBackFrames()
+{
+    using namespace Microsoft::Console::Render;
+
+    auto& g = ServiceLocator::LocateGlobals();
+    auto& gci = g.getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer().GetActiveBuffer();
+    auto& stateMachine = si.GetStateMachine();
+    WI_SetFlag(si.OutputMode, ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+
+    auto thread = std::make_unique<CountingRenderThread>();
+    auto& renderThread = *thread;
+    Renderer renderer{ &gci.renderData, nullptr, 0, std::move(thread) };
+
+    auto* const previousRenderer = g.pRender;
+    g.pRender = &renderer;
+    auto restoreRenderer = wil::scope_exit([&] { g.pRender = previousRenderer; });
+
+    // PaintFrame has no engines to paint, so the time it takes is the time
+    // it spent waiting for the synchronized update to finish.
+    const auto timePaintFrame = [&]() {
+        const auto start = std::chrono::steady_clock::now();
+        VERIFY_SUCCEEDED(renderer.PaintFrame());
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    };
+    const auto timeout = static_cast<long long>(Renderer::s_synchronizedOutputTimeoutMs);
+
+    Log::Comment(L"Frames aren't held back by default");
+    VERIFY_IS_FALSE(renderer._isSynchronizingOutput.load());
+    VERIFY_IS_TRUE(renderer._synchronizedOutputEnded.is_signaled());
+    VERIFY_IS_LESS_THAN(timePaintFrame(), timeout / 2);
+
+    Log::Comment(L"DECSET 2026 starts a synchronized update");
+    stateMachine.ProcessString(L"\x1b[?2026h");
+    VERIFY_IS_TRUE(renderer._isSynchronizingOutput.load());
+    VERIFY_IS_FALSE(renderer._synchronizedOutputEnded.is_signaled());
+
+    Log::Comment(L"A frame is held back until the timeout passes");
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(timePaintFrame(), timeout / 2);
+
+    Log::Comment(L"DECRST 2026 finishes the update and requests the deferred frame");
+    renderThread.notifyCount = 0;
+    stateMachine.ProcessString(L"\x1b[?2026l");
+    VERIFY_IS_FALSE(renderer._isSynchronizingOutput.load());
+    VERIFY_IS_TRUE(renderer._synchronizedOutputEnded.is_signaled());
+    VERIFY_IS_GREATER_THAN(renderThread.notifyCount, 0u);
+    VERIFY_IS_LESS_THAN(timePaintFrame(), timeout / 2);
+
+    Log::Comment(L"RIS finishes an update that's in progress");
+    stateMachine.ProcessString(L"\x1b[?2026h");
+    VERIFY_IS_TRUE(renderer._isSynchronizingOutput.load());
+    stateMachine.ProcessString(L"\033c");
+    VERIFY_IS_FALSE(renderer._isSynchronizingOutput.load());
+    VERIFY_IS_TRUE(renderer._synchronizedOutputEnded.is_signaled());
+}
+
 void ScreenBufferTests::RestoreDownAltBufferWithTerminalScrolling()
 {
     // This is a test for microsoft/terminal#1206. Refer to that issue for more
@@ -5974,6 +6154,43 @@ void ScreenBufferTests::TestAddHyperlinkCustomIdDifferentUri()
     VERIFY_ARE_NOT_EQUAL(oldAttributes.GetHyperlinkId(), tbi.GetCurrentAttributes().GetHyperlinkId());
 }
 
+void ScreenBufferTests::TestPruneHyperlinks()
+{
+    auto& g = ServiceLocator::LocateGlobals();
+    auto& gci = g.getConsoleInformation();
+    auto& si = gci.GetActiveOutputBuffer();
+    auto& tbi = si.GetTextBuffer();
+    const auto& refCounts = tbi.GetHyperlinkRefCounts();
+
+    const auto firstId = tbi.GetHyperlinkId(L"first.url", L"");
+    tbi.AddHyperlinkToMap(L"first.url", firstId);
+    TextAttribute firstAttributes{};
+    firstAttributes.SetHyperlinkId(firstId);
+
+    const auto secondId = tbi.GetHyperlinkId(L"second.url", L"");
+    tbi.AddHyperlinkToMap(L"second.url", secondId);
+    TextAttribute secondAttributes{};
+    secondAttributes.SetHyperlinkId(secondId);
+
+    Log::Comment(L"The first row references both hyperlinks, the second row only the second one");
+    tbi.Write(OutputCellIterator{ L"first", firstAttributes }, { 0, 0 });
+    tbi.Write(OutputCellIterator{ L"second", secondAttributes }, { 10, 0 });
+    tbi.Write(OutputCellIterator{ L"second", secondAttributes }, { 0, 1 });
+    VERIFY_IS_TRUE(refCounts.IsReferenced(firstId));
+    VERIFY_IS_TRUE(refCounts.IsReferenced(secondId));
+
+    Log::Comment(L"Recycling the first row only prunes the hyperlink that isn't used anywhere else");
+    VERIFY_IS_TRUE(tbi.IncrementCircularBuffer());
+    VERIFY_IS_FALSE(refCounts.IsReferenced(firstId));
+    VERIFY_THROWS(tbi.GetHyperlinkUriFromId(firstId), std::out_of_range);
+    VERIFY_IS_TRUE(refCounts.IsReferenced(secondId));
+    VERIFY_ARE_EQUAL(tbi.GetHyperlinkUriFromId(secondId), L"second.url");
+
+    Log::Comment(L"Overwriting the last run of the second hyperlink releases its reference");
+    tbi.Write(OutputCellIterator{ L"plain!", TextAttribute{} }, { 0, 0 });
+    VERIFY_IS_FALSE(refCounts.IsReferenced(secondId));
+}
+
 void ScreenBufferTests::UpdateVirtualBottomWhenCursorMovesBelowIt()
 {
     auto& g = ServiceLocator::LocateGlobals();
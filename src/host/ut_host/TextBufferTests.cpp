@@ -150,12 +150,18 @@ class TextBufferTests
     TEST_METHOD(GetWordBoundaries);
     TEST_METHOD(MoveByWord);
     TEST_METHOD(GetGlyphBoundaries);
+    TEST_METHOD(MoveByGlyphs);
 
     TEST_METHOD(GetTextRects);
     TEST_METHOD(GetText);
+    TEST_METHOD(GetTextColorRuns);
 
     TEST_METHOD(HyperlinkTrim);
     TEST_METHOD(NoHyperlinkTrim);
+
+    TEST_METHOD(RowRevision);
+    TEST_METHOD(RowsAreMaterializedLazily);
+    TEST_METHOD(RowViewMatchesCellIterator);
 };
 
 void TextBufferTests::TestBufferCreate()
@@ -1840,7 +1846,7 @@ void TextBufferTests::ResizeTraditionalRotationPreservesHighUnicode()
 
     // Get a position inside the buffer
     const COORD pos{ 2, 1 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the negative squared latin capital letter B emoji: 🅱
@@ -1882,7 +1888,7 @@ void TextBufferTests::ScrollBufferRotationPreservesHighUnicode()
 
     // Get a position inside the buffer
     const COORD pos{ 2, 1 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the fire emoji: 🔥
@@ -1922,7 +1928,7 @@ void TextBufferTests::ResizeTraditionalHighUnicodeRowRemoval()
 
     // Get a position inside the buffer in the bottom row
     const COORD pos{ 0, bufferSize.Y - 1 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the eggplant emoji: 🍆
@@ -1957,7 +1963,7 @@ void TextBufferTests::ResizeTraditionalHighUnicodeColumnRemoval()
 
     // Get a position inside the buffer in the last column
     const COORD pos{ bufferSize.X - 1, 0 };
-    auto position = _buffer->_storage[pos.Y].GetCharRow().GlyphAt(pos.X);
+    auto position = _buffer->GetRowByOffset(pos.Y).GetCharRow().GlyphAt(pos.X);
 
     // Fill it up with a sequence that will have to hit the high unicode storage.
     // This is the peach emoji: 🍑
@@ -2267,6 +2273,57 @@ void TextBufferTests::GetGlyphBoundaries()
     }
 }
 
+void TextBufferTests::MoveByGlyphs()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"Data:allowBottomExclusive", L"{false, true}")
+    END_TEST_METHOD_PROPERTIES();
+
+    bool allowBottomExclusive;
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"allowBottomExclusive", allowBottomExclusive), L"Get allowBottomExclusive variant");
+
+    COORD bufferSize{ 10, 5 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    // This is the burrito emoji: 🌯
+    // It's encoded in UTF-16, as needed by the buffer.
+    const auto burrito = std::wstring{ L"\xD83C\xDF2F" };
+    const std::vector<std::wstring> bufferText = { L"a" + burrito + L"b" + burrito,
+                                                   burrito + burrito + burrito,
+                                                   L"",
+                                                   L"abc" + burrito,
+                                                   burrito };
+    WriteLinesToBuffer(bufferText, *_buffer);
+
+    // MoveByGlyphs must land exactly where repeatedly calling
+    // MoveToNextGlyph/MoveToPreviousGlyph would, for every start and count.
+    const auto bufferEnd = til::point{ _buffer->GetSize().EndExclusive() };
+    for (til::point start; start != bufferEnd; _buffer->MoveToNextGlyph(start, true))
+    {
+        for (const auto count : { -60, -11, -3, -1, 1, 3, 11, 60 })
+        {
+            auto expected = start;
+            int expectedMoved = 0;
+            while (std::abs(expectedMoved) < std::abs(count))
+            {
+                if (count > 0 ? !_buffer->MoveToNextGlyph(expected, allowBottomExclusive) : !_buffer->MoveToPreviousGlyph(expected))
+                {
+                    break;
+                }
+                expectedMoved += count > 0 ? 1 : -1;
+            }
+
+            auto actual = start;
+            const auto actualMoved = _buffer->MoveByGlyphs(actual, count, allowBottomExclusive);
+
+            VERIFY_ARE_EQUAL(expected, actual);
+            VERIFY_ARE_EQUAL(expectedMoved, actualMoved);
+        }
+    }
+}
+
 void TextBufferTests::GetTextRects()
 {
     // GetTextRects() is used to...
@@ -2580,6 +2637,49 @@ void TextBufferTests::GetText()
     }
 }
 
+void TextBufferTests::GetTextColorRuns()
+{
+    // GetText() returns the colors of the selection as runs, which GenHTML()
+    // and GenRTF() consume. Adjacent cells (and rows) with identical colors
+    // should share a single run, and trimmed whitespace shouldn't leave any.
+    COORD bufferSize{ 10, 20 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const TextAttribute red{ FOREGROUND_RED | FOREGROUND_INTENSITY };
+    _buffer->WriteLine(OutputCellIterator{ L"ab", red }, { 0, 0 });
+    _buffer->WriteLine(OutputCellIterator{ L"cd", attr }, { 2, 0 });
+    _buffer->WriteLine(OutputCellIterator{ L"ef", attr }, { 0, 1 });
+
+    const auto getAttributeColors = [](const TextAttribute& textAttr) {
+        const auto legacy = textAttr.GetLegacyAttributes();
+        return std::pair<COLORREF, COLORREF>{ legacy & FG_ATTRS, (legacy & BG_ATTRS) >> 4 };
+    };
+
+    const auto textRects = _buffer->GetTextRects({ 0, 0 }, { 4, 1 }, false, false);
+    const auto textData = _buffer->GetText(true, true, textRects, getAttributeColors);
+
+    VERIFY_ARE_EQUAL(2u, textData.text.size());
+    VERIFY_ARE_EQUAL(L"abcd\r\n", textData.text.at(0));
+    VERIFY_ARE_EQUAL(L"ef", textData.text.at(1));
+
+    VERIFY_ARE_EQUAL(2u, textData.colorRuns.size());
+    VERIFY_ARE_EQUAL(2u, textData.colorRuns.at(0).length);
+    VERIFY_ARE_EQUAL(static_cast<COLORREF>(0xC), textData.colorRuns.at(0).fg);
+    VERIFY_ARE_EQUAL(static_cast<COLORREF>(0x0), textData.colorRuns.at(0).bk);
+    VERIFY_ARE_EQUAL(6u, textData.colorRuns.at(1).length);
+    VERIFY_ARE_EQUAL(static_cast<COLORREF>(0xF), textData.colorRuns.at(1).fg);
+    VERIFY_ARE_EQUAL(static_cast<COLORREF>(0x7), textData.colorRuns.at(1).bk);
+
+    const auto html = TextBuffer::GenHTML(textData, 12, L"Consolas", 0x7);
+    VERIFY_ARE_NOT_EQUAL(std::string::npos, html.find(R"(<SPAN STYLE="color:#0C0000;background-color:#000000;">ab</SPAN>)"));
+    VERIFY_ARE_NOT_EQUAL(std::string::npos, html.find(R"(<SPAN STYLE="color:#0F0000;background-color:#070000;">cd<BR>ef</SPAN>)"));
+
+    const auto rtf = TextBuffer::GenRTF(textData, 12, L"Consolas", 0x7);
+    VERIFY_ARE_NOT_EQUAL(std::string::npos, rtf.find(R"(\highlight2\cf3 ab\highlight1\cf4 cd\line ef})"));
+}
+
 // This tests that when we increment the circular buffer, obsolete hyperlink references
 // are removed from the hyperlink map
 void TextBufferTests::HyperlinkTrim()
@@ -2660,3 +2760,138 @@ void TextBufferTests::NoHyperlinkTrim()
     VERIFY_ARE_EQUAL(_buffer->GetHyperlinkUriFromId(id), url);
     VERIFY_ARE_EQUAL(_buffer->_hyperlinkCustomIdMap[finalCustomId], id);
 }
+
+// This tests that the renderer can rely on a row's revision to know whether it changed
+void TextBufferTests::RowRevision()
+{
+    const COORD bufferSize{ 80, 10 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+    const auto& constBuffer = *_buffer;
+
+    Log::Comment(L"Every row starts out with a unique revision");
+    const auto revision0 = constBuffer.GetRowByOffset(0).GetRevision();
+    const auto revision1 = constBuffer.GetRowByOffset(1).GetRevision();
+    VERIFY_ARE_NOT_EQUAL(revision0, revision1);
+
+    Log::Comment(L"Reading a row doesn't change its revision");
+    for (auto it = constBuffer.GetCellDataAt({ 0, 0 }, Viewport::FromDimensions({ 0, 0 }, { bufferSize.X, 1 })); it; ++it)
+    {
+    }
+    VERIFY_ARE_EQUAL(std::wstring(bufferSize.X, L' '), constBuffer.GetRowByOffset(0).GetText());
+    VERIFY_ARE_EQUAL(revision0, constBuffer.GetRowByOffset(0).GetRevision());
+
+    Log::Comment(L"Writing to a row gives it a new revision, which no other row has had");
+    _buffer->WriteLine(OutputCellIterator{ L"abc" }, { 0, 0 });
+    const auto revision2 = constBuffer.GetRowByOffset(0).GetRevision();
+    VERIFY_ARE_NOT_EQUAL(revision0, revision2);
+    VERIFY_ARE_NOT_EQUAL(revision1, revision2);
+    VERIFY_ARE_EQUAL(revision1, constBuffer.GetRowByOffset(1).GetRevision());
+
+    Log::Comment(L"Changing only the attributes or flags of a row counts as well");
+    _buffer->GetRowByOffset(0).GetAttrRow().SetAttrToEnd(1, TextAttribute{ 0x1f });
+    const auto revision3 = constBuffer.GetRowByOffset(0).GetRevision();
+    VERIFY_ARE_NOT_EQUAL(revision2, revision3);
+
+    _buffer->GetRowByOffset(0).SetWrapForced(true);
+    VERIFY_ARE_NOT_EQUAL(revision3, constBuffer.GetRowByOffset(0).GetRevision());
+}
+
+void TextBufferTests::RowsAreMaterializedLazily()
+{
+    const COORD bufferSize{ 80, 9001 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    Log::Comment(L"No rows are constructed up front");
+    VERIFY_ARE_EQUAL(9001u, _buffer->TotalRowCount());
+    VERIFY_ARE_EQUAL(0u, _buffer->_storage.size());
+    VERIFY_ARE_EQUAL(COORD({ 0, 0 }), _buffer->GetLastNonSpaceCharacter());
+    VERIFY_ARE_EQUAL(LineRendition::SingleWidth, _buffer->GetLineRendition(9000));
+    VERIFY_ARE_EQUAL(0u, _buffer->_storage.size());
+
+    Log::Comment(L"Writing to a row constructs it and the ones before it");
+    _buffer->WriteLine(OutputCellIterator{ L"abc" }, { 0, 2 });
+    VERIFY_ARE_EQUAL(3u, _buffer->_storage.size());
+    VERIFY_ARE_EQUAL(COORD({ 2, 2 }), _buffer->GetLastNonSpaceCharacter());
+    VERIFY_ARE_EQUAL(3u, _buffer->_storage.size());
+
+    Log::Comment(L"Placeholder rows read as blank rows with the fill attributes");
+    const auto& constBuffer = *_buffer;
+    VERIFY_ARE_EQUAL(std::wstring(bufferSize.X, L' '), constBuffer.GetRowByOffset(5).GetText());
+    VERIFY_ARE_EQUAL(attr, constBuffer.GetRowByOffset(5).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(5, constBuffer.GetRowByOffset(5).GetId());
+
+    Log::Comment(L"Clearing the scrollback from a row discards the rows after it");
+    const TextAttribute clearAttr{ 0x1f };
+    _buffer->ClearRowsFrom(1, clearAttr);
+    VERIFY_ARE_EQUAL(1u, _buffer->_storage.size());
+    VERIFY_ARE_EQUAL(std::wstring(bufferSize.X, L' '), constBuffer.GetRowByOffset(2).GetText());
+    VERIFY_ARE_EQUAL(clearAttr, constBuffer.GetRowByOffset(2).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(attr, constBuffer.GetRowByOffset(0).GetAttrRow().GetAttrByColumn(0));
+
+    Log::Comment(L"Clearing after the last row in use keeps the attributes of the rows before");
+    _buffer->ClearRowsFrom(100, attr);
+    VERIFY_ARE_EQUAL(100u, _buffer->_storage.size());
+    VERIFY_ARE_EQUAL(clearAttr, constBuffer.GetRowByOffset(99).GetAttrRow().GetAttrByColumn(0));
+    VERIFY_ARE_EQUAL(attr, constBuffer.GetRowByOffset(100).GetAttrRow().GetAttrByColumn(0));
+
+    Log::Comment(L"Resetting the buffer discards all rows");
+    _buffer->Reset();
+    VERIFY_ARE_EQUAL(0u, _buffer->_storage.size());
+    VERIFY_ARE_EQUAL(9001u, _buffer->TotalRowCount());
+
+    Log::Comment(L"Growing the buffer doesn't construct the new rows");
+    VERIFY_NT_SUCCESS(_buffer->ResizeTraditional({ 100, 10000 }));
+    VERIFY_ARE_EQUAL(0u, _buffer->_storage.size());
+    VERIFY_ARE_EQUAL(10000u, _buffer->TotalRowCount());
+    VERIFY_ARE_EQUAL(100u, constBuffer.GetRowByOffset(9999).size());
+}
+
+void TextBufferTests::RowViewMatchesCellIterator()
+{
+    const COORD bufferSize{ 20, 3 };
+    const UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, _renderTarget);
+
+    const TextAttribute red{ FOREGROUND_RED };
+    const TextAttribute blue{ BACKGROUND_BLUE };
+    _buffer->WriteLine(OutputCellIterator{ L"a\x3042\xD83D\xDE00", red }, { 1, 1 });
+    _buffer->WriteLine(OutputCellIterator{ L"bc", blue }, { 10, 1 });
+
+    const auto row = _buffer->GetRowViewByOffset(1);
+    VERIFY_ARE_EQUAL(static_cast<size_t>(bufferSize.X), row.size());
+    VERIFY_ARE_EQUAL(row.size(), row.Cells().size());
+
+    size_t runColumns = 0;
+    for (const auto& run : row.AttrRuns())
+    {
+        runColumns += run.GetLength();
+    }
+    VERIFY_ARE_EQUAL(row.size(), runColumns, L"The attribute runs cover the whole row");
+
+    Log::Comment(L"Every column reads the same as through the cell iterator");
+    auto attrs = row.Attrs();
+    auto it = _buffer->GetCellLineDataAt({ 0, 1 });
+    for (size_t column = 0; column < row.size(); ++column, ++it)
+    {
+        VERIFY_ARE_EQUAL(it->Chars(), row.GlyphAt(column));
+        VERIFY_ARE_EQUAL(it->DbcsAttr(), row.DbcsAttrAt(column));
+        VERIFY_ARE_EQUAL(it->Columns(), row.ColumnsAt(column));
+        VERIFY_ARE_EQUAL(it->TextAttr(), attrs.At(column));
+    }
+
+    Log::Comment(L"The surrogate pair is stored out of line, but read back as a single glyph");
+    VERIFY_IS_TRUE(row.DbcsAttrAt(4).IsGlyphStored());
+    const std::wstring_view emoji{ L"\xD83D\xDE00" };
+    VERIFY_ARE_EQUAL(emoji, row.GlyphAt(4));
+    VERIFY_ARE_EQUAL(emoji, row.GlyphAt(5));
+
+    Log::Comment(L"Looking up earlier columns restarts from the first run");
+    VERIFY_ARE_EQUAL(blue, attrs.At(10));
+    VERIFY_ARE_EQUAL(attr, attrs.At(0));
+    VERIFY_ARE_EQUAL(red, attrs.At(1));
+}
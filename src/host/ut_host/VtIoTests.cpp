@@ -392,12 +392,12 @@ public:
     {
     }
 
-    const std::wstring GetHyperlinkUri(uint16_t /*id*/) const noexcept
+    std::wstring_view GetHyperlinkUri(uint16_t /*id*/) const noexcept
     {
         return {};
     }
 
-    const std::wstring GetHyperlinkCustomId(uint16_t /*id*/) const noexcept
+    std::wstring_view GetHyperlinkCustomId(uint16_t /*id*/) const noexcept
     {
         return {};
     }
@@ -406,6 +406,11 @@ public:
     {
         return {};
     }
+
+    uint64_t GetPatternGeneration() const noexcept
+    {
+        return 0;
+    }
 };
 
 void VtIoTests::RendererDtorAndThread()
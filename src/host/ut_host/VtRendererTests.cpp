@@ -67,6 +67,7 @@ class Microsoft::Console::Render::VtRendererTest
     TEST_METHOD(Xterm256TestInvalidate);
     TEST_METHOD(Xterm256TestColors);
     TEST_METHOD(Xterm256TestCursor);
+    TEST_METHOD(Xterm256TestReprintKnownCells);
     TEST_METHOD(Xterm256TestExtendedAttributes);
     TEST_METHOD(Xterm256TestAttributesAcrossReset);
 
@@ -293,7 +294,7 @@ void VtRendererTest::Xterm256TestInvalidate()
         VERIFY_ARE_EQUAL(1u, runs.size());
         VERIFY_ARE_EQUAL(til::rectangle{ Viewport::FromExclusive(invalid).ToInclusive() }, runs.front());
 
-        qExpectedInput.push_back("\x1b[32;1H"); // Bottom of buffer
+        qExpectedInput.push_back("\x1b[31B"); // Bottom of buffer
         qExpectedInput.push_back("\n"); // Scroll down once
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
@@ -416,8 +417,7 @@ void VtRendererTest::Xterm256TestColors()
     Log::Comment(NoThrowString().Format(
         L"Begin by setting some test values - FG,BG = (1,2,3), (4,5,6) to start"
         L"These values were picked for ease of formatting raw COLORREF values."));
-    qExpectedInput.push_back("\x1b[38;2;1;2;3m");
-    qExpectedInput.push_back("\x1b[48;2;5;6;7m");
+    qExpectedInput.push_back("\x1b[38;2;1;2;3;48;2;5;6;7m");
     VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes({ 0x00030201, 0x00070605 },
                                                   &renderData,
                                                   false));
@@ -564,14 +564,14 @@ void VtRendererTest::Xterm256TestCursor()
     Viewport view = SetUpViewport();
 
     Log::Comment(NoThrowString().Format(
-        L"Test moving the cursor around. Every sequence should have both params to CUP explicitly."));
+        L"Test moving the cursor around. Every CUP should have both params explicitly, but relative moves are used where they're shorter."));
     TestPaint(*engine, [&]() {
         qExpectedInput.push_back("\x1b[2;2H");
         VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 1 }));
 
         Log::Comment(NoThrowString().Format(
             L"----Only move Y coord----"));
-        qExpectedInput.push_back("\x1b[31;2H");
+        qExpectedInput.push_back("\x1b[29B");
         VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 30 }));
 
         Log::Comment(NoThrowString().Format(
@@ -656,6 +656,61 @@ void VtRendererTest::Xterm256TestCursor()
     });
 }
 
+void VtRendererTest::Xterm256TestReprintKnownCells()
+{
+    wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
+    std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
+    auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
+    engine->SetTestCallback(pfn);
+    RenderData renderData;
+
+    // Verify the first paint emits a clear and go home
+    qExpectedInput.push_back("\x1b[2J");
+    VERIFY_IS_TRUE(engine->_firstPaint);
+    TestPaint(*engine, [&]() {
+        VERIFY_IS_FALSE(engine->_firstPaint);
+    });
+
+    TestPaint(*engine, [&]() {
+        Log::Comment(NoThrowString().Format(
+            L"Paint some text at 0,1, so the engine knows what's in those cells."));
+        qExpectedInput.push_back("\x1b[2;1H");
+        qExpectedInput.push_back("asdfghjkl");
+
+        const wchar_t* const line = L"asdfghjkl";
+        std::vector<Cluster> clusters;
+        for (size_t i = 0; i < wcslen(line); i++)
+        {
+            clusters.emplace_back(std::wstring_view{ &line[i], 1 }, 1u);
+        }
+        VERIFY_SUCCEEDED(engine->PaintBufferLine({ clusters.data(), clusters.size() }, { 0, 1 }, false, false));
+
+        Log::Comment(NoThrowString().Format(
+            L"----Moving to the second cell reprints the first one after a CR----"));
+        qExpectedInput.push_back("\r");
+        qExpectedInput.push_back("a");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 1 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----Moving forward over a few cells reprints them----"));
+        qExpectedInput.push_back("sdf");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 4, 1 }));
+
+        Log::Comment(NoThrowString().Format(
+            L"----Once the attributes change, the cells can't be reprinted----"));
+        qExpectedInput.push_back("\x1b[38;2;1;2;3;48;2;5;6;7m");
+        VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes({ 0x00030201, 0x00070605 },
+                                                      &renderData,
+                                                      false));
+        qExpectedInput.push_back("\x1b[3D");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 1 }));
+        qExpectedInput.push_back("\x1b[3C");
+        VERIFY_SUCCEEDED(engine->_MoveCursor({ 4, 1 }));
+    });
+
+    VerifyExpectedInputsDrained();
+}
+
 void VtRendererTest::Xterm256TestExtendedAttributes()
 {
     // Run this test for each and every possible combination of states.
@@ -784,6 +839,10 @@ void VtRendererTest::Xterm256TestAttributesAcrossReset()
     std::stringstream renditionSequence;
     renditionSequence << "\x1b[" << renditionAttribute << "m";
 
+    // The reset and the rendition that is retained go out as a single SGR.
+    std::stringstream resetRenditionSequence;
+    resetRenditionSequence << "\x1b[0;" << renditionAttribute << "m";
+
     wil::unique_hfile hFile = wil::unique_hfile(INVALID_HANDLE_VALUE);
     std::unique_ptr<Xterm256Engine> engine = std::make_unique<Xterm256Engine>(std::move(hFile), SetUpViewport());
     auto pfn = std::bind(&VtRendererTest::WriteCallback, this, std::placeholders::_1, std::placeholders::_2);
@@ -850,8 +909,7 @@ void VtRendererTest::Xterm256TestAttributesAcrossReset()
 
     Log::Comment(L"----Reset Default Foreground and Retain Rendition----");
     textAttributes.SetDefaultForeground();
-    qExpectedInput.push_back("\x1b[m");
-    qExpectedInput.push_back(renditionSequence.str());
+    qExpectedInput.push_back(resetRenditionSequence.str());
     VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(textAttributes, &renderData, false));
 
     Log::Comment(L"----Set Green Background----");
@@ -861,8 +919,7 @@ void VtRendererTest::Xterm256TestAttributesAcrossReset()
 
     Log::Comment(L"----Reset Default Background and Retain Rendition----");
     textAttributes.SetDefaultBackground();
-    qExpectedInput.push_back("\x1b[m");
-    qExpectedInput.push_back(renditionSequence.str());
+    qExpectedInput.push_back(resetRenditionSequence.str());
     VERIFY_SUCCEEDED(engine->UpdateDrawingBrushes(textAttributes, &renderData, false));
 
     VerifyExpectedInputsDrained();
@@ -955,7 +1012,7 @@ void VtRendererTest::XtermTestInvalidate()
         VERIFY_ARE_EQUAL(1u, runs.size());
         VERIFY_ARE_EQUAL(til::rectangle{ Viewport::FromExclusive(invalid).ToInclusive() }, runs.front());
 
-        qExpectedInput.push_back("\x1b[32;1H"); // Bottom of buffer
+        qExpectedInput.push_back("\x1b[31B"); // Bottom of buffer
         qExpectedInput.push_back("\n"); // Scroll down once
         VERIFY_SUCCEEDED(engine->ScrollFrame());
     });
@@ -1189,14 +1246,14 @@ void VtRendererTest::XtermTestCursor()
     Viewport view = SetUpViewport();
 
     Log::Comment(NoThrowString().Format(
-        L"Test moving the cursor around. Every sequence should have both params to CUP explicitly."));
+        L"Test moving the cursor around. Every CUP should have both params explicitly, but relative moves are used where they're shorter."));
     TestPaint(*engine, [&]() {
         qExpectedInput.push_back("\x1b[2;2H");
         VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 1 }));
 
         Log::Comment(NoThrowString().Format(
             L"----Only move Y coord----"));
-        qExpectedInput.push_back("\x1b[31;2H");
+        qExpectedInput.push_back("\x1b[29B");
         VERIFY_SUCCEEDED(engine->_MoveCursor({ 1, 30 }));
 
         Log::Comment(NoThrowString().Format(
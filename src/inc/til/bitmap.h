@@ -11,6 +11,37 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 {
     namespace details
     {
+        // A half-open range [left, right) of set bits within a single row of a bitmap.
+        struct _bitmap_interval
+        {
+            ptrdiff_t left;
+            ptrdiff_t right;
+
+            constexpr ptrdiff_t width() const noexcept
+            {
+                return right - left;
+            }
+
+            constexpr bool operator==(const _bitmap_interval& other) const noexcept
+            {
+                return left == other.left && right == other.right;
+            }
+
+            constexpr bool operator!=(const _bitmap_interval& other) const noexcept
+            {
+                return !(*this == other);
+            }
+        };
+
+        // Each row holds its set bits as a list of intervals sorted by their position.
+        // The intervals never overlap or touch each other, which makes the representation
+        // of a given set of bits unique and allows rows to be compared directly.
+        template<typename Allocator>
+        using _bitmap_row = std::vector<_bitmap_interval, typename std::allocator_traits<Allocator>::template rebind_alloc<_bitmap_interval>>;
+
+        template<typename Allocator>
+        using _bitmap_rows = std::vector<_bitmap_row<Allocator>, typename std::allocator_traits<Allocator>::template rebind_alloc<_bitmap_row<Allocator>>>;
+
         template<typename Allocator>
         class _bitmap_const_iterator
         {
@@ -21,18 +52,18 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             using pointer = typename const til::rectangle*;
             using reference = typename const til::rectangle&;
 
-            _bitmap_const_iterator(const dynamic_bitset<unsigned long long, Allocator>& values, til::rectangle rc, ptrdiff_t pos) :
-                _values(values),
-                _rc(rc),
-                _pos(pos),
-                _end(rc.size().area())
+            _bitmap_const_iterator(const _bitmap_rows<Allocator>& rows, ptrdiff_t y) :
+                _rows(rows),
+                _y(y),
+                _x(0),
+                _end(static_cast<ptrdiff_t>(rows.size()))
             {
                 _calculateArea();
             }
 
             _bitmap_const_iterator& operator++()
             {
-                _pos = _nextPos;
+                ++_x;
                 _calculateArea();
                 return (*this);
             }
@@ -46,7 +77,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             constexpr bool operator==(const _bitmap_const_iterator& other) const noexcept
             {
-                return _pos == other._pos && _values == other._values;
+                return _y == other._y && _x == other._x && &_rows == &other._rows;
             }
 
             constexpr bool operator!=(const _bitmap_const_iterator& other) const noexcept
@@ -56,12 +87,12 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             constexpr bool operator<(const _bitmap_const_iterator& other) const noexcept
             {
-                return _pos < other._pos;
+                return _y < other._y || (_y == other._y && _x < other._x);
             }
 
             constexpr bool operator>(const _bitmap_const_iterator& other) const noexcept
             {
-                return _pos > other._pos;
+                return other < *this;
             }
 
             constexpr reference operator*() const noexcept
@@ -75,58 +106,36 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             }
 
         private:
-            const dynamic_bitset<unsigned long long, Allocator>& _values;
-            const til::rectangle _rc;
-            ptrdiff_t _pos;
-            ptrdiff_t _nextPos;
+            const _bitmap_rows<Allocator>& _rows;
+            ptrdiff_t _y;
+            ptrdiff_t _x;
             const ptrdiff_t _end;
             til::rectangle _run;
 
-            // Update _run to contain the next rectangle of consecutively set bits within this bitmap.
+            // Update _run to contain the next interval of set bits within this bitmap.
             // _calculateArea may be called repeatedly to yield all those rectangles.
             void _calculateArea()
             {
-                // The following logic first finds the next set bit in this bitmap and the next unset bit past that.
-                // The area in between those positions are thus all set bits and will end up being the next _run.
-
-                // dynamic_bitset allows you to quickly find the next set bit using find_next(prev),
-                // where "prev" is the position _past_ which should be searched (i.e. excluding position "prev").
-                // If _pos is still 0, we thus need to use the counterpart find_first().
-                const auto nextPos = _pos == 0 ? _values.find_first() : _values.find_next(_pos - 1);
-                // If no next set bit can be found, npos is returned, which is SIZE_T_MAX.
-                // saturated_cast can ensure that this will be converted to PTRDIFF_T_MAX (which is greater than _end).
-                _nextPos = base::saturated_cast<ptrdiff_t>(nextPos);
+                // _x is the index of the next interval within row _y.
+                // Skip past the end of the current row and any empty rows following it.
+                while (_y < _end && _x >= static_cast<ptrdiff_t>(til::at(_rows, static_cast<size_t>(_y)).size()))
+                {
+                    ++_y;
+                    _x = 0;
+                }
 
                 // If we haven't reached the end yet...
-                if (_nextPos < _end)
+                if (_y < _end)
                 {
-                    // pos is now at the first on bit.
-                    const auto runStart = _rc.point_at(_nextPos);
-
-                    // We'll only count up until the end of this row.
-                    // a run can be a max of one row tall.
-                    const ptrdiff_t rowEndIndex = _rc.index_of(til::point(_rc.right() - 1, runStart.y())) + 1;
-
-                    // Find the length for the rectangle.
-                    ptrdiff_t runLength = 0;
-
-                    // We have at least 1 so start with a do/while.
-                    do
-                    {
-                        ++_nextPos;
-                        ++runLength;
-                    } while (_nextPos < rowEndIndex && _values[_nextPos]);
-                    // Keep going until we reach end of row, end of the buffer, or the next bit is off.
-
-                    // Assemble and store that run.
-                    _run = til::rectangle{ runStart, til::size{ runLength, static_cast<ptrdiff_t>(1) } };
+                    // ...the interval is the run. A run can be a max of one row tall.
+                    const auto& interval = til::at(til::at(_rows, static_cast<size_t>(_y)), static_cast<size_t>(_x));
+                    _run = til::rectangle{ til::point{ interval.left, _y }, til::size{ interval.width(), static_cast<ptrdiff_t>(1) } };
                 }
                 else
                 {
-                    // If we reached the end _nextPos may be >= _end (potentially even PTRDIFF_T_MAX).
                     // ---> Mark the end of the iterator by updating the state with _end.
-                    _pos = _end;
-                    _nextPos = _end;
+                    _y = _end;
+                    _x = 0;
                     _run = til::rectangle{};
                 }
             }
@@ -140,6 +149,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             using const_iterator = details::_bitmap_const_iterator<allocator_type>;
 
         private:
+            using row_type = _bitmap_row<allocator_type>;
+            using rows_type = _bitmap_rows<allocator_type>;
             using run_allocator_type = typename std::allocator_traits<allocator_type>::template rebind_alloc<til::rectangle>;
 
         public:
@@ -147,7 +158,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 _alloc{ allocator },
                 _sz{},
                 _rc{},
-                _bits{ _alloc },
+                _count{ 0 },
+                _rows{ _alloc },
                 _runs{ _alloc }
             {
             }
@@ -171,9 +183,14 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 _alloc{ allocator },
                 _sz(sz),
                 _rc(sz),
-                _bits(_sz.area(), fill ? std::numeric_limits<unsigned long long>::max() : 0, _alloc),
+                _count{ 0 },
+                _rows(sz.height<size_t>(), _alloc),
                 _runs{ _alloc }
             {
+                if (fill)
+                {
+                    set_all();
+                }
             }
 
             bitmap(til::size sz, bool fill) :
@@ -185,7 +202,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 _alloc{ std::allocator_traits<allocator_type>::select_on_container_copy_construction(other._alloc) },
                 _sz{ other._sz },
                 _rc{ other._rc },
-                _bits{ other._bits },
+                _count{ other._count },
+                _rows{ other._rows },
                 _runs{ other._runs }
             {
                 // copy constructor is required to call select_on_container_copy
@@ -199,7 +217,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 }
                 _sz = other._sz;
                 _rc = other._rc;
-                _bits = other._bits;
+                _count = other._count;
+                _rows = other._rows;
                 _runs = other._runs;
                 return *this;
             }
@@ -208,7 +227,8 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 _alloc{ std::move(other._alloc) },
                 _sz{ std::move(other._sz) },
                 _rc{ std::move(other._rc) },
-                _bits{ std::move(other._bits) },
+                _count{ std::move(other._count) },
+                _rows{ std::move(other._rows) },
                 _runs{ std::move(other._runs) }
             {
             }
@@ -219,10 +239,11 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 {
                     _alloc = std::move(other._alloc);
                 }
-                _bits = std::move(other._bits);
+                _rows = std::move(other._rows);
                 _runs = std::move(other._runs);
                 _sz = std::move(other._sz);
                 _rc = std::move(other._rc);
+                _count = std::move(other._count);
                 return *this;
             }
 
@@ -234,33 +255,35 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 {
                     std::swap(_alloc, other._alloc);
                 }
-                std::swap(_bits, other._bits);
+                std::swap(_rows, other._rows);
                 std::swap(_runs, other._runs);
                 std::swap(_sz, other._sz);
                 std::swap(_rc, other._rc);
+                std::swap(_count, other._count);
             }
 
-            constexpr bool operator==(const bitmap& other) const noexcept
+            bool operator==(const bitmap& other) const noexcept
             {
                 return _sz == other._sz &&
                        _rc == other._rc &&
-                       _bits == other._bits;
+                       _count == other._count &&
+                       _rows == other._rows;
                 // _runs excluded because it's a cache of generated state.
             }
 
-            constexpr bool operator!=(const bitmap& other) const noexcept
+            bool operator!=(const bitmap& other) const noexcept
             {
                 return !(*this == other);
             }
 
             const_iterator begin() const
             {
-                return const_iterator(_bits, _sz, 0);
+                return const_iterator(_rows, 0);
             }
 
             const_iterator end() const
             {
-                return const_iterator(_bits, _sz, _sz.area());
+                return const_iterator(_rows, _sz.height());
             }
 
             const gsl::span<const til::rectangle> runs() const
@@ -278,74 +301,40 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // optional fill the uncovered area with bits.
             void translate(const til::point delta, bool fill = false)
             {
-                if (delta.x() == 0)
+                if (delta == til::point{ 0, 0 })
                 {
-                    // fast path by using bit shifting
-                    translate_y(delta.y(), fill);
                     return;
                 }
 
-                // FUTURE: PERF: GH #4015: This could use in-place walk semantics instead of a temporary.
-                bitmap<allocator_type> other{ _sz, _alloc };
-
-                for (auto run : *this)
-                {
-                    // Offset by the delta
-                    run += delta;
-
-                    // Intersect with the bounds of our bitmap area
-                    // as part of it could have slid out of bounds.
-                    run &= _rc;
-
-                    // Set it into the new bitmap.
-                    other.set(run);
-                }
+                _runs.reset(); // reset cached runs on any non-const method
 
-                // If we were asked to fill... find the uncovered region.
-                if (fill)
+                // Moving vertically swaps whole rows, filling the ones that scrolled into view.
+                translate_y(delta.y(), fill);
+
+                // Moving horizontally shifts the intervals within each row, filling the
+                // columns that scrolled into view. Together that fills the same area as
+                // subtracting the translated rectangle from the original one:
+                //
+                // X <-- origin
+                // A A A A                     1 1 1 1
+                // A A A A                     1 1 1 1
+                // A A C C B B     subtract    2 2
+                // A A C C B B    --------->   2 2
+                //     B B B B      A - B
+                //     B B B B
+                if (delta.x() != 0)
                 {
-                    // Original Rect of As.
-                    //
-                    // X <-- origin
-                    // A A A A
-                    // A A A A
-                    // A A A A
-                    // A A A A
-                    const auto originalRect = _rc;
-
-                    // If Delta = (2, 2)
-                    // Translated Rect of Bs.
-                    //
-                    // X <-- origin
-                    //
-                    //
-                    //     B B B B
-                    //     B B B B
-                    //     B B B B
-                    //     B B B B
-                    const auto translatedRect = _rc + delta;
-
-                    // Subtract the B from the A one to see what wasn't filled by the move.
-                    // C is the overlap of A and B:
-                    //
-                    // X <-- origin
-                    // A A A A                     1 1 1 1
-                    // A A A A                     1 1 1 1
-                    // A A C C B B     subtract    2 2
-                    // A A C C B B    --------->   2 2
-                    //     B B B B      A - B
-                    //     B B B B
-                    //
-                    // 1 and 2 are the spaces to fill that are "uncovered".
-                    const auto fillRects = originalRect - translatedRect;
-                    for (const auto& f : fillRects)
+                    for (auto& row : _rows)
                     {
-                        other.set(f);
+                        translate_x(row, delta.x(), fill);
                     }
                 }
 
-                // Swap us with the temporary one.
-                std::swap(other, *this);
+                _count = 0;
+                for (const auto& row : _rows)
+                {
+                    _count += _row_count(row);
+                }
             }
 
             void set(const til::point pt)
@@ -353,7 +342,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 THROW_HR_IF(E_INVALIDARG, !_rc.contains(pt));
                 _runs.reset(); // reset cached runs on any non-const method
 
-                _bits.set(_rc.index_of(pt));
+                _count += _set_row(_row_at(pt.y()), pt.x(), pt.x() + 1);
             }
 
             void set(const til::rectangle rc)
@@ -361,22 +350,35 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                 THROW_HR_IF(E_INVALIDARG, !_rc.contains(rc));
                 _runs.reset(); // reset cached runs on any non-const method
 
+                if (rc.empty())
+                {
+                    return;
+                }
+
                 for (auto row = rc.top(); row < rc.bottom(); ++row)
                 {
-                    _bits.set(_rc.index_of(til::point{ rc.left(), row }), rc.width(), true);
+                    _count += _set_row(_row_at(row), rc.left(), rc.right());
                 }
             }
 
-            void set_all() noexcept
+            void set_all()
             {
                 _runs.reset(); // reset cached runs on any non-const method
-                _bits.set();
+                for (auto& row : _rows)
+                {
+                    _assign_row(row, true);
+                }
+                _count = _sz.width() * _sz.height();
             }
 
             void reset_all() noexcept
             {
                 _runs.reset(); // reset cached runs on any non-const method
-                _bits.reset();
+                for (auto& row : _rows)
+                {
+                    row.clear();
+                }
+                _count = 0;
             }
 
             // True if we resized. False if it was the same size as before.
@@ -391,19 +393,21 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                     // Make a new bitmap for the other side, empty initially.
                     bitmap<allocator_type> newMap{ size, false, _alloc };
 
-                    // Copy any regions that overlap from this map to the new one.
-                    // Just iterate our runs...
-                    for (const auto& run : *this)
+                    // Copy any intervals of the rows that exist in both maps,
+                    // cut down to the new width so we don't attempt to set
+                    // bits that fit outside the new one.
+                    const auto height = std::min(_sz.height(), size.height());
+                    for (ptrdiff_t y = 0; y < height; ++y)
                     {
-                        // intersect them with the new map
-                        // so we don't attempt to set bits that fit outside
-                        // the new one.
-                        const auto intersect = run & newMap._rc;
-
-                        // and if there is still anything left, set them.
-                        if (!intersect.empty())
+                        auto& newRow = newMap._row_at(y);
+                        for (const auto& interval : _row_at(y))
                         {
-                            newMap.set(intersect);
+                            const auto right = std::min(interval.right, size.width());
+                            if (interval.left < right)
+                            {
+                                newRow.push_back(_bitmap_interval{ interval.left, right });
+                                newMap._count += right - interval.left;
+                            }
                         }
                     }
 
@@ -434,7 +438,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             constexpr bool one() const noexcept
             {
-                return _bits.count() == 1;
+                return _count == 1;
             }
 
             constexpr bool any() const noexcept
@@ -444,12 +448,12 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             constexpr bool none() const noexcept
             {
-                return _bits.none();
+                return _count == 0;
             }
 
             constexpr bool all() const noexcept
             {
-                return _bits.all();
+                return _count == _sz.width() * _sz.height();
             }
 
             constexpr til::size size() const noexcept
@@ -480,58 +484,136 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
                     return;
                 }
 
-                const auto bitShift = delta_y * _sz.width();
-
-#pragma warning(push)
-                // we can't depend on GSL here, so we use static_cast for explicit narrowing
-#pragma warning(disable : 26472)
-                const auto newBits = static_cast<size_t>(std::abs(bitShift));
-#pragma warning(pop)
-                const bool isLeftShift = bitShift > 0;
+                const auto distance = std::abs(delta_y);
 
-                if (newBits >= _bits.size())
+                if (distance >= _sz.height())
                 {
-                    if (fill)
+                    for (auto& row : _rows)
                     {
-                        set_all();
-                    }
-                    else
-                    {
-                        reset_all();
+                        _assign_row(row, fill);
                     }
                     return;
                 }
 
-                if (isLeftShift)
+                // Rotating only swaps the rows' storage, so this costs O(rows) no matter
+                // how many bits are set. The rows that wrap around are the uncovered ones.
+                auto uncoveredBegin = _rows.begin();
+                if (delta_y > 0)
                 {
-                    // This operator doesn't modify the size of `_bits`: the
-                    // new bits are set to 0.
-                    _bits <<= newBits;
+                    std::rotate(_rows.begin(), _rows.end() - distance, _rows.end());
                 }
                 else
                 {
-                    _bits >>= newBits;
+                    std::rotate(_rows.begin(), _rows.begin() + distance, _rows.end());
+                    uncoveredBegin = _rows.end() - distance;
+                }
+
+                std::for_each(uncoveredBegin, uncoveredBegin + distance, [&](auto& row) {
+                    _assign_row(row, fill);
+                });
+            }
+
+            void translate_x(row_type& row, ptrdiff_t delta_x, bool fill)
+            {
+                const auto width = _sz.width();
+
+                // Offset every interval and intersect it with the bounds of our
+                // bitmap area, as part of it could have slid out of bounds.
+                auto out = row.begin();
+                for (const auto& interval : row)
+                {
+                    const auto left = std::max<ptrdiff_t>(interval.left + delta_x, 0);
+                    const auto right = std::min(interval.right + delta_x, width);
+                    if (left < right)
+                    {
+                        *out = _bitmap_interval{ left, right };
+                        ++out;
+                    }
                 }
+                row.erase(out, row.end());
 
                 if (fill)
                 {
-                    if (isLeftShift)
+                    if (delta_x > 0)
                     {
-                        _bits.set(0, newBits, true);
+                        _set_row(row, 0, std::min(delta_x, width));
                     }
                     else
                     {
-                        _bits.set(_bits.size() - newBits, newBits, true);
+                        _set_row(row, std::max<ptrdiff_t>(width + delta_x, 0), width);
                     }
                 }
+            }
 
-                _runs.reset(); // reset cached runs on any non-const method
+            row_type& _row_at(const ptrdiff_t y) noexcept
+            {
+                return til::at(_rows, static_cast<size_t>(y));
+            }
+
+            const row_type& _row_at(const ptrdiff_t y) const noexcept
+            {
+                return til::at(_rows, static_cast<size_t>(y));
+            }
+
+            void _assign_row(row_type& row, bool fill)
+            {
+                row.clear();
+                if (fill && _sz.width() > 0)
+                {
+                    row.push_back(_bitmap_interval{ 0, _sz.width() });
+                }
+            }
+
+            // Sets the bits [left, right) in the given row and returns how many of them weren't set before.
+            static ptrdiff_t _set_row(row_type& row, const ptrdiff_t left, const ptrdiff_t right)
+            {
+                // The intervals are sorted and never touch, so their left and right edges are
+                // both strictly increasing. The first interval we need to merge with is the
+                // first one that ends at or past our left edge...
+                const auto first = std::lower_bound(row.begin(), row.end(), left, [](const _bitmap_interval& interval, const ptrdiff_t value) {
+                    return interval.right < value;
+                });
+                // ...and the first one we don't merge with starts past our right edge.
+                const auto last = std::upper_bound(first, row.end(), right, [](const ptrdiff_t value, const _bitmap_interval& interval) {
+                    return value < interval.left;
+                });
+
+                if (first == last)
+                {
+                    row.insert(first, _bitmap_interval{ left, right });
+                    return right - left;
+                }
+
+                const _bitmap_interval merged{ std::min(left, first->left), std::max(right, (last - 1)->right) };
+                const auto previous = _row_count(first, last);
+
+                *first = merged;
+                row.erase(first + 1, last);
+
+                return merged.width() - previous;
+            }
+
+            template<typename It>
+            static ptrdiff_t _row_count(It first, It last) noexcept
+            {
+                ptrdiff_t count = 0;
+                for (; first != last; ++first)
+                {
+                    count += first->width();
+                }
+                return count;
+            }
+
+            static ptrdiff_t _row_count(const row_type& row) noexcept
+            {
+                return _row_count(row.begin(), row.end());
             }
 
             allocator_type _alloc;
             til::size _sz;
             til::rectangle _rc;
-            dynamic_bitset<unsigned long long, allocator_type> _bits;
+            ptrdiff_t _count;
+            rows_type _rows;
 
             mutable std::optional<std::vector<til::rectangle, run_allocator_type>> _runs;
 
@@ -54,8 +54,13 @@ static CodepointWidth GetQuickCharWidthLegacyForNumpadEventSynthesis(const wchar
     return CodepointWidth::Invalid;
 }
 
-std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::CharToKeyEvents(const wchar_t wch,
-                                                                                         const unsigned int codepage)
+// Routine Description:
+// - determines the VkKeyScanW key state that typing the given character results in
+// Arguments:
+// - wch - the character that is typed
+// Return Value:
+// - the key state, or nullopt if the character must be typed using Alt + numpad
+static std::optional<short> _KeyStateFromChar(const wchar_t wch)
 {
     const short invalidKey = -1;
     short keyState = VkKeyScanW(wch);
@@ -75,31 +80,34 @@ std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::CharToK
                 // It wasn't alphanumeric or determined to be wide by the old algorithm
                 // if VkKeyScanW fails (char is not in kbd layout), we must
                 // emulate the key being input through the numpad
-                return SynthesizeNumpadEvents(wch, codepage);
+                return std::nullopt;
             }
         }
         keyState = 0; // SynthesizeKeyboardEvents would rather get 0 than -1
     }
 
-    return SynthesizeKeyboardEvents(wch, keyState);
+    return keyState;
 }
 
 // Routine Description:
-// - converts a wchar_t into a series of KeyEvents as if it was typed
-// using the keyboard
+// - appends the KeyEvents for typing a wchar_t using the keyboard to keyEvents
 // Arguments:
 // - wch - the wchar_t to convert
-// Return Value:
-// - deque of KeyEvents that represent the wchar_t being typed
+// - keyState - the key state of the wchar_t, as returned by VkKeyScanW
+// - virtualScanCode - the scan code of the virtual key in keyState
+// - keyEvents - the deque to append the KeyEvents to
 // Note:
 // - will throw exception on error
-std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeKeyboardEvents(const wchar_t wch, const short keyState)
+template<typename T>
+static void _AppendKeyboardEvents(const wchar_t wch,
+                                  const short keyState,
+                                  const WORD virtualScanCode,
+                                  std::deque<std::unique_ptr<T>>& keyEvents)
 {
     const byte modifierState = HIBYTE(keyState);
 
     bool altGrSet = false;
     bool shiftSet = false;
-    std::deque<std::unique_ptr<KeyEvent>> keyEvents;
 
     // add modifier key event if necessary
     if (WI_AreAllFlagsSet(modifierState, VkKeyScanModState::CtrlAndAltPressed))
@@ -123,8 +131,6 @@ std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::Synthes
                                                        SHIFT_PRESSED));
     }
 
-    const auto vk = LOBYTE(keyState);
-    const WORD virtualScanCode = gsl::narrow<WORD>(MapVirtualKeyW(vk, MAPVK_VK_TO_VSC));
     KeyEvent keyEvent{ true, 1, LOBYTE(keyState), virtualScanCode, wch, 0 };
 
     // add modifier flags if necessary
@@ -165,7 +171,94 @@ std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::Synthes
                                                        UNICODE_NULL,
                                                        0));
     }
+}
+
+static WORD _VirtualScanCodeFromKeyState(const short keyState)
+{
+    return gsl::narrow<WORD>(MapVirtualKeyW(LOBYTE(keyState), MAPVK_VK_TO_VSC));
+}
 
+std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::CharToKeyEvents(const wchar_t wch,
+                                                                                         const unsigned int codepage)
+{
+    const auto keyState = _KeyStateFromChar(wch);
+    if (!keyState)
+    {
+        return SynthesizeNumpadEvents(wch, codepage);
+    }
+
+    return SynthesizeKeyboardEvents(wch, *keyState);
+}
+
+// Routine Description:
+// - converts a string into the KeyEvents of typing it, just like calling
+//   CharToKeyEvents for every character, but without creating a deque per character.
+// - Texts like pastes consist mostly of the same few ASCII characters over and over,
+//   so their keyboard layout lookups are only done once per call.
+// Arguments:
+// - text - the string to convert
+// - codepage - the codepage to use for characters that are typed using Alt + numpad
+// - keyEvents - the deque to append the KeyEvents to
+// Note:
+// - will throw exception on error
+void Microsoft::Console::Interactivity::CharsToKeyEvents(const std::wstring_view text,
+                                                         const unsigned int codepage,
+                                                         std::deque<std::unique_ptr<IInputEvent>>& keyEvents)
+{
+    struct AsciiKey
+    {
+        bool valid;
+        bool numpad;
+        short keyState;
+        WORD virtualScanCode;
+    };
+    std::array<AsciiKey, 128> asciiKeys{};
+
+    for (const auto wch : text)
+    {
+        AsciiKey key{};
+        if (wch < asciiKeys.size() && til::at(asciiKeys, wch).valid)
+        {
+            key = til::at(asciiKeys, wch);
+        }
+        else
+        {
+            const auto keyState = _KeyStateFromChar(wch);
+            key.valid = true;
+            key.numpad = !keyState;
+            key.keyState = keyState.value_or(0);
+            key.virtualScanCode = keyState ? _VirtualScanCodeFromKeyState(*keyState) : 0;
+            if (wch < asciiKeys.size())
+            {
+                til::at(asciiKeys, wch) = key;
+            }
+        }
+
+        if (key.numpad)
+        {
+            auto numpadEvents = SynthesizeNumpadEvents(wch, codepage);
+            std::move(numpadEvents.begin(), numpadEvents.end(), std::back_inserter(keyEvents));
+        }
+        else
+        {
+            _AppendKeyboardEvents(wch, key.keyState, key.virtualScanCode, keyEvents);
+        }
+    }
+}
+
+// Routine Description:
+// - converts a wchar_t into a series of KeyEvents as if it was typed
+// using the keyboard
+// Arguments:
+// - wch - the wchar_t to convert
+// Return Value:
+// - deque of KeyEvents that represent the wchar_t being typed
+// Note:
+// - will throw exception on error
+std::deque<std::unique_ptr<KeyEvent>> Microsoft::Console::Interactivity::SynthesizeKeyboardEvents(const wchar_t wch, const short keyState)
+{
+    std::deque<std::unique_ptr<KeyEvent>> keyEvents;
+    _AppendKeyboardEvents(wch, keyState, _VirtualScanCodeFromKeyState(keyState), keyEvents);
     return keyEvents;
 }
 
@@ -22,6 +22,10 @@ namespace Microsoft::Console::Interactivity
 {
     std::deque<std::unique_ptr<KeyEvent>> CharToKeyEvents(const wchar_t wch, const unsigned int codepage);
 
+    void CharsToKeyEvents(const std::wstring_view text,
+                          const unsigned int codepage,
+                          std::deque<std::unique_ptr<IInputEvent>>& keyEvents);
+
     std::deque<std::unique_ptr<KeyEvent>> SynthesizeKeyboardEvents(const wchar_t wch,
                                                                    const short keyState);
 
@@ -236,13 +236,8 @@ void Clipboard::StoreSelectionToClipboard(bool const copyFormatting)
 // - fAlsoCopyFormatting - true if the color and formatting should also be copied, false otherwise
 void Clipboard::CopyTextToSystemClipboard(const TextBuffer::TextAndColor& rows, bool const fAlsoCopyFormatting)
 {
-    std::wstring finalString;
-
     // Concatenate strings into one giant string to put onto the clipboard.
-    for (const auto& str : rows.text)
-    {
-        finalString += str;
-    }
+    const auto finalString = rows.JoinText();
 
     // allocate the final clipboard data
     const size_t cchNeeded = finalString.size() + 1;
@@ -31,7 +31,6 @@ Renderer::Renderer(IRenderData* pData,
     _pData(THROW_HR_IF_NULL(E_INVALIDARG, pData)),
     _pThread{ std::move(thread) },
     _destructing{ false },
-    _clusterBuffer{},
     _viewport{ pData->GetViewport() }
 {
     for (size_t i = 0; i < cEngines; i++)
@@ -51,9 +50,24 @@ Renderer::Renderer(IRenderData* pData,
 Renderer::~Renderer()
 {
     _destructing = true;
+    // Don't let the final frame wait for an update that won't be finished.
+    _synchronizedOutputEnded.SetEvent();
     _pThread.reset();
 }
 
+// Routine Description:
+// - Returns the total time spent painting frames, across all engines, since
+//   this renderer was created. Frames without anything to paint aren't counted.
+// - This can be called from any thread.
+// Arguments:
+// - <none>
+// Return Value:
+// - The accumulated paint time.
+std::chrono::nanoseconds Renderer::GetTotalPaintTime() const noexcept
+{
+    return std::chrono::nanoseconds{ _totalPaintTime.load(std::memory_order_relaxed) };
+}
+
 // Routine Description:
 // - Walks through the console data structures to compose a new frame based on the data that has changed since last call and outputs it to the connected rendering engine.
 // Arguments:
@@ -67,6 +81,8 @@ Renderer::~Renderer()
         return S_FALSE;
     }
 
+    _WaitForSynchronizedOutput();
+
     for (IRenderEngine* const pEngine : _rgpEngines)
     {
         auto tries = maxRetriesForRenderEngine;
@@ -131,6 +147,13 @@ try
         return S_OK;
     }
 
+    // Account for everything from here up to and including Present().
+    const auto paintStart = std::chrono::steady_clock::now();
+    auto accountPaintTime = wil::scope_exit([&]() {
+        const auto paintTime = std::chrono::steady_clock::now() - paintStart;
+        _totalPaintTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(paintTime).count(), std::memory_order_relaxed);
+    });
+
     auto endPaint = wil::scope_exit([&]() {
         LOG_IF_FAILED(pEngine->EndPaint());
 
@@ -194,6 +217,24 @@ void Renderer::_NotifyPaintFrame()
     }
 }
 
+// Routine Description:
+// - Blocks the caller while an application is in the middle of a synchronized
+//   update, so that we don't paint the screen in a half-updated state.
+// - The wait is limited to s_synchronizedOutputTimeoutMs, so that an application
+//   which never finishes its update (e.g. because it crashed) can't freeze the screen.
+//   It must not be called with the console lock held, as that would block the update.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::_WaitForSynchronizedOutput() noexcept
+{
+    if (_isSynchronizingOutput.load(std::memory_order_acquire))
+    {
+        _synchronizedOutputEnded.wait(s_synchronizedOutputTimeoutMs);
+    }
+}
+
 // Routine Description:
 // - Called when the system has requested we redraw a portion of the console.
 // Arguments:
@@ -405,7 +446,7 @@ bool Renderer::_CheckViewportAndScroll()
     // so they can prepare the buffers for changes to either preallocate memory at once
     // (instead of growing naturally) or shrink down to reduce usage as appropriate.
     const size_t lineLength = gsl::narrow_cast<size_t>(til::rectangle{ srNewViewport }.width());
-    til::manage_vector(_clusterBuffer, lineLength, _shrinkThreshold);
+    til::manage_vector(_clusterSizes, lineLength, _shrinkThreshold);
 
     if (coordDelta.X != 0 || coordDelta.Y != 0)
     {
@@ -496,6 +537,35 @@ void Renderer::TriggerTitleChange()
     _NotifyPaintFrame();
 }
 
+// Routine Description:
+// - Called when an application starts or finishes a synchronized update
+//   (DECSET/DECRST 2026). Until it's finished, PaintFrame holds back the next frame.
+// Arguments:
+// - enabled - true when the update starts, false when it's finished.
+// Return Value:
+// - <none>
+void Renderer::SetSynchronizedOutput(const bool enabled)
+{
+    if (_isSynchronizingOutput.load(std::memory_order_relaxed) == enabled)
+    {
+        return;
+    }
+
+    if (enabled)
+    {
+        _synchronizedOutputEnded.ResetEvent();
+        _isSynchronizingOutput.store(true, std::memory_order_release);
+    }
+    else
+    {
+        _isSynchronizingOutput.store(false, std::memory_order_release);
+        _synchronizedOutputEnded.SetEvent();
+
+        // Everything that was written during the update has been waiting for this frame.
+        _NotifyPaintFrame();
+    }
+}
+
 // Routine Description:
 // - Update the title for a particular engine.
 // Arguments:
@@ -651,6 +721,18 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
     gsl::span<const til::rectangle> dirtyAreas;
     LOG_IF_FAILED(pEngine->GetDirtyArea(dirtyAreas));
 
+    // Every line of the viewport remembers how it was split into runs the last time it was painted.
+    // The clusters point into the cache entries, so they mustn't be moved around.
+    const auto height = gsl::narrow_cast<size_t>(view.Height());
+    if (_bufferLineCache.size() != height)
+    {
+        _bufferLineCache.clear();
+        _bufferLineCache.resize(height);
+    }
+
+    const auto globalInvert = _pData->IsScreenReversed();
+    const auto patternGeneration = _pData->GetPatternGeneration();
+
     // This is to make sure any transforms are reset when this paint is finished.
     auto resetLineTransform = wil::scope_exit([&]() {
         LOG_IF_FAILED(pEngine->ResetLineTransform());
@@ -694,21 +776,44 @@ void Renderer::_PaintBufferOutput(_In_ IRenderEngine* const pEngine)
                 // of the backing buffer to fill in line 1 of the screen.
                 const auto screenPosition = bufferLine.Origin() - COORD{ 0, view.Top() };
 
-                // Retrieve the cell information iterator limited to just this line we want to redraw.
-                auto it = buffer.GetCellDataAt(bufferLine.Origin(), bufferLine);
+                const auto& bufferRow = buffer.GetRowByOffset(bufferLine.Origin().Y);
 
                 // Calculate if two things are true:
                 // 1. this row wrapped
                 // 2. We're painting the last col of the row.
-                // In that case, set lineWrapped=true for the _PaintBufferOutputHelper call.
-                const auto lineWrapped = (buffer.GetRowByOffset(bufferLine.Origin().Y).WasWrapForced()) &&
+                // In that case, set lineWrapped=true for the _PaintBufferLineRuns call.
+                const auto lineWrapped = bufferRow.WasWrapForced() &&
                                          (bufferLine.RightExclusive() == buffer.GetSize().Width());
 
+                // If neither the row nor anything else that affects how it is split into runs
+                // has changed since we last painted this part of it, we can reuse those runs.
+                // That's usually the case if only the cursor or the selection changed.
+                auto& line = til::at(_bufferLineCache, gsl::narrow_cast<size_t>(screenPosition.Y));
+                const BufferLineCacheKey key{ bufferRow.GetRevision(),
+                                              patternGeneration,
+                                              bufferLine.Left(),
+                                              bufferLine.RightInclusive(),
+                                              screenPosition,
+                                              globalInvert };
+                if (line.key != key)
+                {
+                    // Reset the key first, in case we fail to fill in the line.
+                    line.key.reset();
+
+                    _SegmentBufferLine(RowView{ bufferRow },
+                                       gsl::narrow_cast<size_t>(bufferLine.Left()),
+                                       gsl::narrow_cast<size_t>(bufferLine.RightExclusive()),
+                                       screenPosition,
+                                       line);
+
+                    line.key = key;
+                }
+
                 // Prepare the appropriate line transform for the current row and viewport offset.
                 LOG_IF_FAILED(pEngine->PrepareLineTransform(lineRendition, screenPosition.Y, view.Left()));
 
-                // Ask the helper to paint through this specific line.
-                _PaintBufferOutputHelper(pEngine, it, screenPosition, lineWrapped);
+                // Paint through this specific line.
+                _PaintBufferLineRuns(pEngine, line, lineWrapped);
             }
         }
     }
@@ -720,24 +825,78 @@ static bool _IsAllSpaces(const std::wstring_view v)
     return v.find_first_not_of(L" ") == decltype(v)::npos;
 }
 
+bool Renderer::BufferLineCacheKey::operator==(const BufferLineCacheKey& other) const noexcept
+{
+    return rowRevision == other.rowRevision &&
+           patternGeneration == other.patternGeneration &&
+           left == other.left &&
+           right == other.right &&
+           target == other.target &&
+           globalInvert == other.globalInvert;
+}
+
+// Routine Description:
+// - Paints a single line of an arbitrary buffer, without caching how it was split into runs.
+// - See also: _PaintBufferOutput, which caches the runs of the lines of the text buffer.
+// Arguments:
+// - pEngine - The engine to paint with.
+// - row - The row containing the line.
+// - columnBegin - The first column of the row to paint.
+// - columnEnd - The column after the last one to paint.
+// - target - The position on the screen where the line should be painted.
+// - lineWrapped - Whether the line was forced to wrap and we're painting its last column.
+// Return Value:
+// - <none>
 void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                        TextBufferCellIterator it,
+                                        const RowView& row,
+                                        const size_t columnBegin,
+                                        const size_t columnEnd,
                                         const COORD target,
                                         const bool lineWrapped)
 {
+    _SegmentBufferLine(row, columnBegin, columnEnd, target, _uncachedLine);
+    _PaintBufferLineRuns(pEngine, _uncachedLine, lineWrapped);
+}
+
+// Routine Description:
+// - Splits a line of cells into runs that can each be painted with a single
+//   set of drawing brushes and turns their text into rendering clusters.
+// - The text is copied into the line, so that the result can be painted again
+//   later without having to walk the cells of the buffer.
+// Arguments:
+// - row - The row containing the line.
+// - columnBegin - The first column of the row to segment.
+// - columnEnd - The column after the last one to segment.
+// - target - The position on the screen where the line should be painted.
+// - line - Receives the runs, clusters and attributes of the line.
+// Return Value:
+// - <none>
+void Renderer::_SegmentBufferLine(const RowView& row,
+                                  const size_t columnBegin,
+                                  const size_t columnEnd,
+                                  const COORD target,
+                                  BufferLineCache& line)
+{
+    line.text.clear();
+    line.clusters.clear();
+    line.columnAttributes.clear();
+    line.runs.clear();
+
+    // The clusters can only be created once all of the text has been copied,
+    // as appending to it may reallocate it. Until then we hold onto their sizes.
+    _clusterSizes.clear();
+
     auto globalInvert{ _pData->IsScreenReversed() };
 
     // If we have valid data, let's figure out how to draw it.
-    if (it)
+    if (columnBegin < columnEnd && columnEnd <= row.size())
     {
-        // TODO: MSFT: 20961091 -  This is a perf issue. Instead of rebuilding this and allocing memory to hold the reinterpretation,
-        // we should have an iterator/view adapter for the rendering.
-        // That would probably also eliminate the RenderData needing to give us the entire TextBuffer as well...
-        // Retrieve the iterator for one line of information.
+        auto attrs = row.Attrs();
+        auto column = columnBegin;
         size_t cols = 0;
 
         // Retrieve the first color.
-        auto color = it->TextAttr();
+        auto color = attrs.At(column);
         // Retrieve the first pattern id
         auto patternIds = _pData->GetPatternId(target);
 
@@ -745,7 +904,7 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
         auto screenPoint = target;
 
         // This outer loop will continue until we reach the end of the text we are trying to draw.
-        while (it)
+        while (column < columnEnd)
         {
             // Hold onto the current run color right here for the length of the outer loop.
             // We'll be changing the persistent one as we run through the inner loops to detect
@@ -753,23 +912,17 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             // when we go to draw gridlines for the length of the run.
             const auto currentRunColor = color;
 
-            // Hold onto the current pattern id as well
-            const auto currentPatternId = patternIds;
-
-            // Update the drawing brushes with our color.
-            THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, currentRunColor, false));
-
             // Advance the point by however many columns we've just outputted and reset the accumulator.
             screenPoint.X += gsl::narrow<SHORT>(cols);
             cols = 0;
 
-            // Hold onto the start of this run iterator and the target location where we started
+            // Hold onto the start of this run and the target location where we started
             // in case we need to do some special work to paint the line drawing characters.
-            const auto currentRunItStart = it;
+            const auto currentRunColumnStart = column;
             const auto currentRunTargetStart = screenPoint;
 
-            // Ensure that our cluster vector is clear.
-            _clusterBuffer.clear();
+            // Remember where this run's clusters start.
+            const auto clusterBegin = _clusterSizes.size();
 
             // Reset our flag to know when we're in the special circumstance
             // of attempting to draw only the right-half of a two-column character
@@ -786,12 +939,13 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
             {
                 COORD thisPoint{ screenPoint.X + gsl::narrow<SHORT>(cols), screenPoint.Y };
                 const auto thisPointPatterns = _pData->GetPatternId(thisPoint);
-                if (color != it->TextAttr() || patternIds != thisPointPatterns)
+                const auto& newAttr = attrs.At(column);
+                const auto chars = row.GlyphAt(column);
+                if (color != newAttr || patternIds != thisPointPatterns)
                 {
-                    auto newAttr{ it->TextAttr() };
                     // foreground doesn't matter for runs of spaces (!)
                     // if we trick it . . . we call Paint far fewer times for cmatrix
-                    if (!_IsAllSpaces(it->Chars()) || !newAttr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || patternIds != thisPointPatterns)
+                    if (!_IsAllSpaces(chars) || !newAttr.HasIdenticalVisualRepresentationForBlankSpace(color, globalInvert) || patternIds != thisPointPatterns)
                     {
                         color = newAttr;
                         patternIds = thisPointPatterns;
@@ -802,73 +956,122 @@ void Renderer::_PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
                 // Walk through the text data and turn it into rendering clusters.
                 // Keep the columnCount as we go to improve performance over digging it out of the vector at the end.
                 size_t columnCount = 0;
+                const auto cellColumns = row.ColumnsAt(column);
 
                 // If we're on the first cluster to be added and it's marked as "trailing"
                 // (a.k.a. the right half of a two column character), then we need some special handling.
-                if (_clusterBuffer.empty() && it->DbcsAttr().IsTrailing())
+                if (_clusterSizes.size() == clusterBegin && row.DbcsAttrAt(column).IsTrailing())
                 {
                     // Move left to the one so the whole character can be struck correctly.
                     --screenPoint.X;
                     // And tell the next function to trim off the left half of it.
                     trimLeft = true;
                     // And add one to the number of columns we expect it to take as we insert it.
-                    columnCount = it->Columns() + 1;
-                    _clusterBuffer.emplace_back(it->Chars(), columnCount);
+                    columnCount = cellColumns + 1;
                 }
                 // Otherwise if it's not a special case, just insert it as is.
                 else
                 {
-                    columnCount = it->Columns();
-                    _clusterBuffer.emplace_back(it->Chars(), columnCount);
+                    columnCount = cellColumns;
                 }
 
+                line.text.append(chars);
+                _clusterSizes.emplace_back(chars.size(), columnCount);
+
                 if (columnCount > 1)
                 {
                     containsWideCharacter = true;
                 }
 
                 // Advance the cluster and column counts.
-                it += std::max<size_t>(it->Columns(), 1); // prevent infinite loop for no visible columns
+                column += cellColumns;
                 cols += columnCount;
 
-            } while (it);
+            } while (column < columnEnd);
 
-            // Do the painting.
-            THROW_IF_FAILED(pEngine->PaintBufferLine({ _clusterBuffer.data(), _clusterBuffer.size() }, screenPoint, trimLeft, lineWrapped));
+            const auto columnAttributesBegin = line.columnAttributes.size();
 
-            // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
-            // We're only allowed to draw the grid lines under certain circumstances.
-            if (_pData->IsGridLineDrawingAllowed())
+            // See GH: 803
+            // If we found a wide character while we looped above, it's possible we skipped over the right half
+            // attribute that could have contained different line information than the left half.
+            if (containsWideCharacter)
             {
-                // See GH: 803
-                // If we found a wide character while we looped above, it's possible we skipped over the right half
-                // attribute that could have contained different line information than the left half.
-                if (containsWideCharacter)
+                // We need to go through the columns again to ensure we get the lines associated with each
+                // exact column. The code above will condense two-column characters into one, but it is possible
+                // (like with the IME) that the line drawing characters will vary from the left to right half
+                // of a wider character. Columns past the end of the line repeat its last column.
+                auto lineAttrs = row.Attrs();
+                for (auto colsPainted = 0u; colsPainted < cols; ++colsPainted)
                 {
-                    // Start from the original position in this run.
-                    auto lineIt = currentRunItStart;
-                    // Start from the original target in this run.
-                    auto lineTarget = currentRunTargetStart;
-
-                    // We need to go through the iterators again to ensure we get the lines associated with each
-                    // exact column. The code above will condense two-column characters into one, but it is possible
-                    // (like with the IME) that the line drawing characters will vary from the left to right half
-                    // of a wider character.
-                    // We could theoretically pre-pass for this in the loop above to be more efficient about walking
-                    // the iterator, but I fear it would make the code even more confusing than it already is.
-                    // Do that in the future if some WPR trace points you to this spot as super bad.
-                    for (auto colsPainted = 0u; colsPainted < cols; ++colsPainted, ++lineIt, ++lineTarget.X)
-                    {
-                        auto lines = lineIt->TextAttr();
-                        _PaintBufferOutputGridLineHelper(pEngine, lines, 1, lineTarget);
-                    }
+                    const auto lineColumn = std::min(currentRunColumnStart + colsPainted, columnEnd - 1);
+                    line.columnAttributes.emplace_back(lineAttrs.At(lineColumn));
                 }
-                else
+            }
+
+            line.runs.push_back({ currentRunColor,
+                                  screenPoint,
+                                  currentRunTargetStart,
+                                  clusterBegin,
+                                  _clusterSizes.size(),
+                                  columnAttributesBegin,
+                                  cols,
+                                  trimLeft,
+                                  containsWideCharacter });
+        }
+    }
+
+    // Now that the text won't be reallocated anymore, create the clusters from our copy of it.
+    std::wstring_view remaining{ line.text };
+    for (const auto& [length, columns] : _clusterSizes)
+    {
+        line.clusters.emplace_back(remaining.substr(0, length), columns);
+        remaining.remove_prefix(length);
+    }
+}
+
+// Routine Description:
+// - Paints the runs of a line that were produced by _SegmentBufferLine.
+// Arguments:
+// - pEngine - The engine to paint with.
+// - line - The runs, clusters and attributes of the line.
+// - lineWrapped - Whether the line was forced to wrap and we're painting its last column.
+// Return Value:
+// - <none>
+void Renderer::_PaintBufferLineRuns(_In_ IRenderEngine* const pEngine,
+                                    const BufferLineCache& line,
+                                    const bool lineWrapped)
+{
+    const gsl::span<const Cluster> clusters{ line.clusters };
+    const auto isGridLineDrawingAllowed = _pData->IsGridLineDrawingAllowed();
+
+    for (const auto& run : line.runs)
+    {
+        // Update the drawing brushes with our color.
+        THROW_IF_FAILED(_UpdateDrawingBrushes(pEngine, run.attributes, false));
+
+        // Do the painting.
+        THROW_IF_FAILED(pEngine->PaintBufferLine(clusters.subspan(run.clusterBegin, run.clusterEnd - run.clusterBegin), run.target, run.trimLeft, lineWrapped));
+
+        // If we're allowed to do grid drawing, draw that now too (since it will be coupled with the color data)
+        // We're only allowed to draw the grid lines under certain circumstances.
+        if (isGridLineDrawingAllowed)
+        {
+            if (run.containsWideCharacter)
+            {
+                // Wide characters may have different line information for each of their halves,
+                // so we draw the lines column by column, starting from the original target in this run.
+                auto lineTarget = run.gridLineTarget;
+                for (auto colsPainted = 0u; colsPainted < run.columns; ++colsPainted, ++lineTarget.X)
                 {
-                    // If nothing exciting is going on, draw the lines in bulk.
-                    _PaintBufferOutputGridLineHelper(pEngine, currentRunColor, cols, screenPoint);
+                    const auto& lines = til::at(line.columnAttributes, run.columnAttributesBegin + colsPainted);
+                    _PaintBufferOutputGridLineHelper(pEngine, lines, 1, lineTarget);
                 }
             }
+            else
+            {
+                // If nothing exciting is going on, draw the lines in bulk.
+                _PaintBufferOutputGridLineHelper(pEngine, run.attributes, run.columns, run.target);
+            }
         }
     }
 }
@@ -1113,9 +1316,9 @@ void Renderer::_PaintOverlay(IRenderEngine& engine,
                     const COORD target{ viewDirty.Left(), iRow };
                     const auto source = target - overlay.origin;
 
-                    auto it = overlay.buffer.GetCellLineDataAt(source);
+                    const auto row = overlay.buffer.GetRowViewByOffset(source.Y);
 
-                    _PaintBufferOutputHelper(&engine, it, target, false);
+                    _PaintBufferOutputHelper(&engine, row, gsl::narrow_cast<size_t>(source.X), row.size(), target, false);
                 }
             }
         }
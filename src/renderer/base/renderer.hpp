@@ -46,6 +46,7 @@ namespace Microsoft::Console::Render
         virtual ~Renderer() override;
 
         [[nodiscard]] HRESULT PaintFrame();
+        std::chrono::nanoseconds GetTotalPaintTime() const noexcept;
 
         void TriggerSystemRedraw(const RECT* const prcDirtyClient) override;
         void TriggerRedraw(const Microsoft::Console::Types::Viewport& region) override;
@@ -60,6 +61,7 @@ namespace Microsoft::Console::Render
 
         void TriggerCircling() override;
         void TriggerTitleChange() override;
+        void SetSynchronizedOutput(const bool enabled) override;
 
         void TriggerFontChange(const int iDpi,
                                const FontInfoDesired& FontInfoDesired,
@@ -89,10 +91,18 @@ namespace Microsoft::Console::Render
 
         std::unique_ptr<IRenderThread> _pThread;
         bool _destructing = false;
+        std::atomic<int64_t> _totalPaintTime{ 0 };
 
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _hoveredInterval;
 
+        // Synchronized output (DECSET 2026): while an application is in the middle of
+        // updating the screen, frames are held back until it's done or the timeout passes.
+        static constexpr DWORD s_synchronizedOutputTimeoutMs = 100;
+        std::atomic<bool> _isSynchronizingOutput{ false };
+        wil::unique_event _synchronizedOutputEnded{ wil::EventOptions::ManualReset | wil::EventOptions::Signaled };
+
         void _NotifyPaintFrame();
+        void _WaitForSynchronizedOutput() noexcept;
 
         [[nodiscard]] HRESULT _PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept;
 
@@ -102,11 +112,60 @@ namespace Microsoft::Console::Render
 
         void _PaintBufferOutput(_In_ IRenderEngine* const pEngine);
 
+        struct BufferLineRun
+        {
+            TextAttribute attributes;
+            COORD target;
+            COORD gridLineTarget;
+            size_t clusterBegin;
+            size_t clusterEnd;
+            size_t columnAttributesBegin;
+            size_t columns;
+            bool trimLeft;
+            bool containsWideCharacter;
+        };
+
+        struct BufferLineCacheKey
+        {
+            uint64_t rowRevision;
+            uint64_t patternGeneration;
+            SHORT left;
+            SHORT right;
+            COORD target;
+            bool globalInvert;
+
+            bool operator==(const BufferLineCacheKey& other) const noexcept;
+            bool operator!=(const BufferLineCacheKey& other) const noexcept { return !(*this == other); }
+        };
+
+        // A line of text split into the runs that get handed to the engines.
+        // The clusters point into the line's own copy of the text, so it mustn't be copied.
+        struct BufferLineCache
+        {
+            std::optional<BufferLineCacheKey> key;
+            std::wstring text;
+            std::vector<Cluster> clusters;
+            std::vector<TextAttribute> columnAttributes;
+            std::vector<BufferLineRun> runs;
+        };
+
         void _PaintBufferOutputHelper(_In_ IRenderEngine* const pEngine,
-                                      TextBufferCellIterator it,
+                                      const RowView& row,
+                                      const size_t columnBegin,
+                                      const size_t columnEnd,
                                       const COORD target,
                                       const bool lineWrapped);
 
+        void _SegmentBufferLine(const RowView& row,
+                                const size_t columnBegin,
+                                const size_t columnEnd,
+                                const COORD target,
+                                BufferLineCache& line);
+
+        void _PaintBufferLineRuns(_In_ IRenderEngine* const pEngine,
+                                  const BufferLineCache& line,
+                                  const bool lineWrapped);
+
         static IRenderEngine::GridLines s_GetGridlines(const TextAttribute& textAttribute) noexcept;
 
         void _PaintBufferOutputGridLineHelper(_In_ IRenderEngine* const pEngine,
@@ -127,7 +186,9 @@ namespace Microsoft::Console::Render
         Microsoft::Console::Types::Viewport _viewport;
 
         static constexpr float _shrinkThreshold = 0.8f;
-        std::vector<Cluster> _clusterBuffer;
+        std::vector<std::pair<size_t, size_t>> _clusterSizes;
+        std::vector<BufferLineCache> _bufferLineCache;
+        BufferLineCache _uncachedLine;
 
         std::vector<SMALL_RECT> _GetSelectionRects() const;
         void _ScrollPreviousSelection(const til::point delta);
@@ -146,6 +207,7 @@ namespace Microsoft::Console::Render
 
 #ifdef UNIT_TESTING
         friend class ConptyOutputTests;
+        friend class ScreenBufferTests;
 #endif
     };
 }
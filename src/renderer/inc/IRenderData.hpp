@@ -66,10 +66,11 @@ namespace Microsoft::Console::Render
         virtual const bool IsGridLineDrawingAllowed() noexcept = 0;
         virtual const std::wstring_view GetConsoleTitle() const noexcept = 0;
 
-        virtual const std::wstring GetHyperlinkUri(uint16_t id) const noexcept = 0;
-        virtual const std::wstring GetHyperlinkCustomId(uint16_t id) const noexcept = 0;
+        virtual std::wstring_view GetHyperlinkUri(uint16_t id) const noexcept = 0;
+        virtual std::wstring_view GetHyperlinkCustomId(uint16_t id) const noexcept = 0;
 
         virtual const std::vector<size_t> GetPatternId(const COORD location) const noexcept = 0;
+        virtual uint64_t GetPatternGeneration() const noexcept = 0;
 
     protected:
         IRenderData() = default;
@@ -0,0 +1,977 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+
+#include "SoftwareRenderer.hpp"
+
+#include "../../types/inc/Viewport.hpp"
+
+#pragma hdrstop
+
+using namespace Microsoft::Console::Render;
+using namespace Microsoft::Console::Types;
+
+// 3x5 pixel hex digits for the fallback glyphs, one bit per pixel,
+// with the top left pixel in bit 14 and the bottom right one in bit 0.
+static constexpr std::array<uint16_t, 16> s_hexDigits{
+    0x7B6F, 0x2C97, 0x73E7, 0x73CF, 0x5BC9, 0x79CF, 0x79EF, 0x7249,
+    0x7BEF, 0x7BCF, 0x7BED, 0x6BAE, 0x7927, 0x6B6E, 0x79E7, 0x79E4
+};
+
+// Routine Description:
+// - Constructs a software rendering engine.
+// Arguments:
+// - cellSize - The size of a single character cell in pixels.
+SoftwareEngine::SoftwareEngine(const til::size cellSize) :
+    RenderEngineBase(),
+    _cellSize{ cellSize },
+    _frameSize{},
+    _invalidMap{ &_pool },
+    _invalidScroll{},
+    _presentAll{ false },
+    _isPainting{ false },
+    _rasterizer{ &SoftwareEngine::s_RasterizeCodepointBox },
+    _lookupKey{},
+    _foregroundColor{ s_ToPixel(RGB(0xff, 0xff, 0xff)) },
+    _backgroundColor{ s_ToPixel(RGB(0, 0, 0)) },
+    _defaultBackgroundColor{ s_ToPixel(RGB(0, 0, 0)) },
+    _bold{ false },
+    _italic{ false },
+    _statistics{}
+{
+    THROW_HR_IF(E_INVALIDARG, cellSize.width() <= 0 || cellSize.height() <= 0);
+}
+
+// Routine Description:
+// - Replaces the function used to turn clusters into glyph coverage masks.
+//   By default every cluster is drawn as a box containing its codepoint in
+//   hex, which needs no font at all and is perfectly deterministic.
+// - Drops all glyphs that were cached so far and schedules a full repaint.
+// Arguments:
+// - rasterizer - The new glyph rasterizer.
+// Return Value:
+// - <none>
+void SoftwareEngine::SetGlyphRasterizer(GlyphRasterizer rasterizer)
+{
+    THROW_HR_IF(E_INVALIDARG, !rasterizer);
+    _rasterizer = std::move(rasterizer);
+    _glyphs.clear();
+    _atlas.clear();
+    _invalidMap.set_all();
+}
+
+// Routine Description:
+// - Gets the size of the presented frame in pixels.
+til::size SoftwareEngine::GetFrameSize() const noexcept
+{
+    return _frameSize;
+}
+
+// Routine Description:
+// - Gets the pixels of the last presented frame, top row first.
+//   Each pixel is stored in RGBA byte order with an opaque alpha.
+gsl::span<const uint32_t> SoftwareEngine::GetFrame() const noexcept
+{
+    return _frontBuffer;
+}
+
+// Routine Description:
+// - Gets the counters this engine accumulated since it was constructed.
+//   Divide paintTime by rowsPresented for the cost per dirty row.
+const SoftwareEngine::Statistics& SoftwareEngine::GetStatistics() const noexcept
+{
+    return _statistics;
+}
+
+// Routine Description:
+// - Notifies us that the console has changed the character region specified.
+// Arguments:
+// - psrRegion - Character region (SMALL_RECT) that has been changed
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::Invalidate(const SMALL_RECT* const psrRegion) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, psrRegion);
+
+    const til::rectangle rect{ Viewport::FromExclusive(*psrRegion).ToInclusive() };
+    _invalidMap.set(rect & til::rectangle{ _invalidMap.size() });
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Invalidates the cells of the cursor
+// Arguments:
+// - psrRegion - the region covered by the cursor
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept
+{
+    return Invalidate(psrRegion);
+}
+
+// Routine Description:
+// - Invalidates a rectangle describing a pixel area of the frame
+// Arguments:
+// - prcDirtyClient - pixel rectangle
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::InvalidateSystem(const RECT* const prcDirtyClient) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, prcDirtyClient);
+
+    const auto rect = til::rectangle{ *prcDirtyClient }.scale_down(_cellSize);
+    _invalidMap.set(rect & til::rectangle{ _invalidMap.size() });
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Invalidates a series of character rectangles
+// Arguments:
+// - rectangles - One or more rectangles describing character positions on the grid
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept
+{
+    for (const auto& rect : rectangles)
+    {
+        RETURN_IF_FAILED(Invalidate(&rect));
+    }
+    return S_OK;
+}
+
+// Routine Description:
+// - Scrolls the existing dirty region and invalidates the area that is
+//   uncovered. The pixels themselves are moved in ScrollFrame.
+// Arguments:
+// - pcoordDelta - The number of characters to move and uncover.
+//               - -Y is up, Y is down, -X is left, X is right.
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::InvalidateScroll(const COORD* const pcoordDelta) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pcoordDelta);
+
+    const til::point delta{ *pcoordDelta };
+    if (delta != til::point{ 0, 0 })
+    {
+        _invalidMap.translate(delta, true);
+        _invalidScroll += delta;
+    }
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Invalidates the entire frame
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::InvalidateAll() noexcept
+try
+{
+    _invalidMap.set_all();
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - This currently has no effect in this renderer.
+// Arguments:
+// - pForcePaint - Always filled with false
+// Return Value:
+// - S_FALSE because we don't use this.
+[[nodiscard]] HRESULT SoftwareEngine::InvalidateCircling(_Out_ bool* const pForcePaint) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pForcePaint);
+
+    *pForcePaint = false;
+    return S_FALSE;
+}
+
+// Routine Description:
+// - This currently has no effect in this renderer.
+// Arguments:
+// - pForcePaint - Always filled with false
+// Return Value:
+// - S_FALSE because we don't use this.
+[[nodiscard]] HRESULT SoftwareEngine::PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pForcePaint);
+
+    *pForcePaint = false;
+    return S_FALSE;
+}
+
+// Routine Description:
+// - Starts a frame if anything was invalidated since the last one.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if we started to paint. S_FALSE if we didn't need to paint.
+//   E_NOT_VALID_STATE if we're already painting.
+[[nodiscard]] HRESULT SoftwareEngine::StartPaint() noexcept
+{
+    RETURN_HR_IF(E_NOT_VALID_STATE, _isPainting);
+
+    if (!_invalidMap.any() && _invalidScroll == til::point{ 0, 0 } && !_titleChanged)
+    {
+        return S_FALSE;
+    }
+
+    _isPainting = true;
+    _paintStart = std::chrono::steady_clock::now();
+    return S_OK;
+}
+
+// Routine Description:
+// - Ends the current frame and remembers which regions of the back buffer
+//   have to be copied to the front buffer by Present.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::EndPaint() noexcept
+try
+{
+    RETURN_HR_IF(E_INVALIDARG, !_isPainting);
+    _isPainting = false;
+
+    _presentDirty.assign(_invalidMap.begin(), _invalidMap.end());
+    _invalidMap.reset_all();
+    _invalidScroll = {};
+
+    _statistics.paintTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _paintStart);
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Copies the rows painted during the last frame to the front buffer.
+//   If the frame was scrolled every row moved, so everything is copied.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::Present() noexcept
+{
+    if (_presentAll)
+    {
+        std::copy(_backBuffer.begin(), _backBuffer.end(), _frontBuffer.begin());
+        _statistics.rowsPresented += gsl::narrow_cast<size_t>(_invalidMap.size().height());
+        _presentAll = false;
+    }
+    else
+    {
+        // The dirty runs are ordered top to bottom and never span multiple rows.
+        const auto frameWidth = _frameSize.width();
+        auto lastRow = std::numeric_limits<ptrdiff_t>::min();
+
+        for (const auto& run : _presentDirty)
+        {
+            const auto pixels = run.scale_up(_cellSize);
+            for (auto y = pixels.top(); y < pixels.bottom(); ++y)
+            {
+                const auto offset = y * frameWidth;
+                std::copy(_backBuffer.begin() + offset + pixels.left(),
+                          _backBuffer.begin() + offset + pixels.right(),
+                          _frontBuffer.begin() + offset + pixels.left());
+            }
+
+            if (run.top() != lastRow)
+            {
+                lastRow = run.top();
+                ++_statistics.rowsPresented;
+            }
+        }
+    }
+
+    _presentDirty.clear();
+    ++_statistics.framesPresented;
+    return S_OK;
+}
+
+// Routine Description:
+// - Moves the pixels of the back buffer by the distance that was passed to
+//   InvalidateScroll since the last frame. The uncovered rows are already
+//   marked as invalid and will be painted afterwards.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::ScrollFrame() noexcept
+try
+{
+    const auto deltaY = _invalidScroll.y();
+    if (_invalidScroll.x() != 0)
+    {
+        // Horizontal scrolling is rare enough that it's not worth moving
+        // pixels around for it.
+        _invalidMap.set_all();
+    }
+    else if (deltaY != 0)
+    {
+        const auto distance = gsl::narrow_cast<size_t>(std::abs(deltaY) * _cellSize.height() * _frameSize.width());
+        if (distance >= _backBuffer.size())
+        {
+            _invalidMap.set_all();
+        }
+        else if (deltaY < 0)
+        {
+            std::copy(_backBuffer.begin() + distance, _backBuffer.end(), _backBuffer.begin());
+        }
+        else
+        {
+            std::copy_backward(_backBuffer.begin(), _backBuffer.end() - distance, _backBuffer.end());
+        }
+        _presentAll = true;
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Fills the invalid regions with the default background color.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::PaintBackground() noexcept
+try
+{
+    for (const auto& run : _invalidMap.runs())
+    {
+        _FillRect(run.scale_up(_cellSize), _defaultBackgroundColor);
+    }
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Draws one line of the buffer to the back buffer: the background of every
+//   cluster in the current background color and its glyph from the atlas in
+//   the current foreground color.
+// Arguments:
+// - clusters - text and column counts for each piece of text.
+// - coord - character coordinate target to render within viewport
+// - trimLeft - This specifies whether to trim one character width off the left
+//              side of the output. Not used by this renderer.
+// - lineWrapped - Not used by this renderer.
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT SoftwareEngine::PaintBufferLine(gsl::span<const Cluster> const clusters,
+                                                      const COORD coord,
+                                                      const bool /*trimLeft*/,
+                                                      const bool /*lineWrapped*/) noexcept
+try
+{
+    auto left = coord.X * _cellSize.width();
+    const auto top = coord.Y * _cellSize.height();
+
+    for (const auto& cluster : clusters)
+    {
+        if (left >= _frameSize.width())
+        {
+            break;
+        }
+
+        const auto columns = cluster.GetColumns();
+        const til::point origin{ left, top };
+        const til::size size{ _cellSize.width() * gsl::narrow_cast<ptrdiff_t>(columns), _cellSize.height() };
+
+        _FillRect({ origin, size }, _backgroundColor);
+
+        const auto& glyph = _GetGlyph(cluster.GetText(), columns);
+        if (!glyph.blank)
+        {
+            _BlendGlyph(glyph, origin, _foregroundColor);
+        }
+        ++_statistics.glyphsDrawn;
+
+        left += size.width();
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Draws up to one line worth of grid lines on top of characters.
+// Arguments:
+// - lines - Enum defining which edges of the rectangle to draw
+// - color - The color to use for drawing the edges.
+// - cchLine - How many characters we should draw the grid lines along (left to right in a row)
+// - coordTarget - The starting X/Y position of the first character to draw on.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::PaintBufferGridLines(GridLines const lines,
+                                                           COLORREF const color,
+                                                           size_t const cchLine,
+                                                           COORD const coordTarget) noexcept
+try
+{
+    const auto pixel = s_ToPixel(color);
+    const auto cellWidth = _cellSize.width();
+    const auto cellHeight = _cellSize.height();
+    const auto thickness = std::max<ptrdiff_t>(1, cellHeight / 16);
+    const auto line = til::rectangle{ til::point{ coordTarget }, til::size{ gsl::narrow_cast<ptrdiff_t>(cchLine), 1 } }.scale_up(_cellSize);
+
+    const auto horizontal = [&](const ptrdiff_t offset) {
+        _FillRect({ line.left(), line.top() + offset, line.right(), line.top() + offset + thickness }, pixel);
+    };
+
+    if (WI_IsFlagSet(lines, GridLines::Top))
+    {
+        horizontal(0);
+    }
+    if (WI_IsFlagSet(lines, GridLines::Bottom))
+    {
+        horizontal(cellHeight - thickness);
+    }
+    if (WI_IsAnyFlagSet(lines, GridLines::Left | GridLines::Right))
+    {
+        for (auto x = line.left(); x < line.right(); x += cellWidth)
+        {
+            if (WI_IsFlagSet(lines, GridLines::Left))
+            {
+                _FillRect({ x, line.top(), x + thickness, line.bottom() }, pixel);
+            }
+            if (WI_IsFlagSet(lines, GridLines::Right))
+            {
+                _FillRect({ x + cellWidth - thickness, line.top(), x + cellWidth, line.bottom() }, pixel);
+            }
+        }
+    }
+    if (WI_IsFlagSet(lines, GridLines::Underline))
+    {
+        horizontal(cellHeight - 2 * thickness);
+    }
+    if (WI_IsFlagSet(lines, GridLines::DoubleUnderline))
+    {
+        horizontal(cellHeight - thickness);
+        horizontal(cellHeight - 3 * thickness);
+    }
+    if (WI_IsFlagSet(lines, GridLines::Strikethrough))
+    {
+        horizontal((cellHeight - thickness) / 2);
+    }
+    if (WI_IsFlagSet(lines, GridLines::HyperlinkUnderline))
+    {
+        // Hyperlinks get a dashed underline, just like in the other renderers.
+        const auto top = line.top() + cellHeight - 2 * thickness;
+        for (auto x = line.left(); x < line.right(); x += 4 * thickness)
+        {
+            _FillRect({ x, top, std::min(x + 2 * thickness, line.right()), top + thickness }, pixel);
+        }
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Inverts the selected region on the current frame.
+// Arguments:
+// - rect - Rectangle to invert or highlight to make the selection area
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::PaintSelection(const SMALL_RECT rect) noexcept
+try
+{
+    const til::rectangle cells{ Viewport::FromExclusive(rect).ToInclusive() };
+    _InvertRect(cells.scale_up(_cellSize));
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Draws the cursor on the frame, either by filling it with the requested
+//   color or by inverting the pixels underneath, like the GDI renderer.
+// Arguments:
+// - options - Parameters that affect the way that the cursor is drawn
+// Return Value:
+// - S_OK, S_FALSE if the cursor is off.
+[[nodiscard]] HRESULT SoftwareEngine::PaintCursor(const CursorOptions& options) noexcept
+try
+{
+    if (!options.isOn)
+    {
+        return S_FALSE;
+    }
+
+    const auto cellWidth = _cellSize.width();
+    const auto cellHeight = _cellSize.height();
+    const auto left = options.coordCursor.X * cellWidth;
+    const auto top = options.coordCursor.Y * cellHeight;
+    const auto right = left + cellWidth * (options.fIsDoubleWidth ? 2 : 1);
+    const auto bottom = top + cellHeight;
+
+    std::array<til::rectangle, 4> rects;
+    size_t count = 0;
+
+    switch (options.cursorType)
+    {
+    case CursorType::Legacy:
+    {
+        const auto percent = std::clamp<ptrdiff_t>(gsl::narrow_cast<ptrdiff_t>(options.ulCursorHeightPercent), 25, 100);
+        const auto height = std::max<ptrdiff_t>(1, cellHeight * percent / 100);
+        rects[count++] = { left, bottom - height, right, bottom };
+        break;
+    }
+    case CursorType::VerticalBar:
+        rects[count++] = { left, top, std::min<ptrdiff_t>(right, left + std::max<ptrdiff_t>(1, gsl::narrow_cast<ptrdiff_t>(options.cursorPixelWidth))), bottom };
+        break;
+    case CursorType::Underscore:
+        rects[count++] = { left, bottom - 1, right, bottom };
+        break;
+    case CursorType::DoubleUnderscore:
+        rects[count++] = { left, bottom - 1, right, bottom };
+        rects[count++] = { left, bottom - 3, right, bottom - 2 };
+        break;
+    case CursorType::EmptyBox:
+        rects[count++] = { left, top, right, top + 1 };
+        rects[count++] = { left, bottom - 1, right, bottom };
+        rects[count++] = { left, top + 1, left + 1, bottom - 1 };
+        rects[count++] = { right - 1, top + 1, right, bottom - 1 };
+        break;
+    case CursorType::FullBox:
+    default:
+        rects[count++] = { left, top, right, bottom };
+        break;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto& rect = til::at(rects, i);
+        if (options.fUseColor)
+        {
+            _FillRect(rect, s_ToPixel(options.cursorColor));
+        }
+        else
+        {
+            _InvertRect(rect);
+        }
+    }
+
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Updates the colors and font style used for the following draw calls.
+// Arguments:
+// - textAttributes - Text attributes to use for the brush color
+// - pData - The interface to console data structures required for rendering
+// - isSettingDefaultBrushes - Whether these are the default colors, which are
+//                             used to paint the background of the frame.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::UpdateDrawingBrushes(const TextAttribute& textAttributes,
+                                                           const gsl::not_null<IRenderData*> pData,
+                                                           bool const isSettingDefaultBrushes) noexcept
+{
+    const auto [foreground, background] = pData->GetAttributeColors(textAttributes);
+    _foregroundColor = s_ToPixel(foreground);
+    _backgroundColor = s_ToPixel(background);
+    _bold = textAttributes.IsBold();
+    _italic = textAttributes.IsItalic();
+
+    if (isSettingDefaultBrushes)
+    {
+        _defaultBackgroundColor = _backgroundColor;
+    }
+
+    return S_OK;
+}
+
+// Routine Description:
+// - Reports our cell size as the selected font. The cell size of this
+//   renderer is fixed at construction.
+// Arguments:
+// - fiFontInfoDesired - The font the caller would like to use
+// - fiFontInfo - Filled with the font we actually use
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::UpdateFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo) noexcept
+{
+    return GetProposedFont(fiFontInfoDesired, fiFontInfo, USER_DEFAULT_SCREEN_DPI);
+}
+
+// Routine Description:
+// - This currently has no effect in this renderer, as the cell size is
+//   already given in pixels.
+// Arguments:
+// - iDpi - DPI
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::UpdateDpi(int const /*iDpi*/) noexcept
+{
+    return S_OK;
+}
+
+// Method Description:
+// - This method will update our internal reference for how big the viewport is.
+//   If the viewport changed size, the framebuffer is reallocated and repainted.
+// Arguments:
+// - srNewViewport - The bounds of the new viewport.
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate.
+[[nodiscard]] HRESULT SoftwareEngine::UpdateViewport(const SMALL_RECT srNewViewport) noexcept
+try
+{
+    const til::size cells{ Viewport::FromInclusive(srNewViewport).Dimensions() };
+    if (cells != _invalidMap.size())
+    {
+        _Resize(cells);
+    }
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Reports our cell size as the font the caller would get.
+// Arguments:
+// - fiFontInfoDesired - The font the caller would like to use
+// - fiFontInfo - Filled with the font we actually use
+// - iDpi - Not used by this renderer
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::GetProposedFont(const FontInfoDesired& /*fiFontInfoDesired*/,
+                                                      FontInfo& fiFontInfo,
+                                                      int const /*iDpi*/) noexcept
+try
+{
+    const COORD size = _cellSize;
+    fiFontInfo.SetFromEngine(fiFontInfo.GetFaceName(),
+                             fiFontInfo.GetFamily(),
+                             fiFontInfo.GetWeight(),
+                             false,
+                             size,
+                             size);
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Gets the area that we currently believe is dirty within the character cell grid
+// Arguments:
+// - area - Rectangle describing dirty area in characters.
+// Return Value:
+// - S_OK, else an appropriate HRESULT for failing to allocate.
+[[nodiscard]] HRESULT SoftwareEngine::GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept
+try
+{
+    area = _invalidMap.runs();
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - Gets the size of a character cell in pixels.
+// Arguments:
+// - pFontSize - Filled with the font size.
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::GetFontSize(_Out_ COORD* const pFontSize) noexcept
+try
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pFontSize);
+
+    *pFontSize = _cellSize;
+    return S_OK;
+}
+CATCH_RETURN();
+
+// Routine Description:
+// - We don't have a real font, so we can't answer this.
+// Arguments:
+// - glyph - The glyph run to process for column width.
+// - pResult - Always filled with false.
+// Return Value:
+// - S_FALSE: This is unsupported by this renderer and should use another engine's value.
+[[nodiscard]] HRESULT SoftwareEngine::IsGlyphWideByFont(const std::wstring_view /*glyph*/, _Out_ bool* const pResult) noexcept
+{
+    RETURN_HR_IF_NULL(E_INVALIDARG, pResult);
+
+    *pResult = false;
+    return S_FALSE;
+}
+
+// Method Description:
+// - Updates the window's title string. We don't have a window.
+// Arguments:
+// - newTitle: the new string to use for the title of the window
+// Return Value:
+// - S_OK
+[[nodiscard]] HRESULT SoftwareEngine::_DoUpdateTitle(_In_ const std::wstring_view /*newTitle*/) noexcept
+{
+    return S_OK;
+}
+
+bool SoftwareEngine::GlyphKey::operator==(const GlyphKey& other) const noexcept
+{
+    return columns == other.columns && bold == other.bold && italic == other.italic && text == other.text;
+}
+
+size_t SoftwareEngine::GlyphKeyHash::operator()(const GlyphKey& key) const noexcept
+{
+    const auto flags = key.columns << 2 | size_t{ key.bold } << 1 | size_t{ key.italic };
+    auto hash = std::hash<std::wstring_view>{}(key.text);
+    hash ^= flags + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+// Routine Description:
+// - Gets the coverage of the given cluster in the current font style from
+//   the glyph atlas, rasterizing it first if we haven't seen it before.
+// Arguments:
+// - text - The text of the cluster
+// - columns - The number of cells the cluster covers
+// Return Value:
+// - The atlas entry of the glyph. It stays valid until the next call.
+const SoftwareEngine::GlyphEntry& SoftwareEngine::_GetGlyph(const std::wstring_view text, const size_t columns)
+{
+    // The lookup key is a member so that its string capacity is reused
+    // and cache hits don't allocate.
+    _lookupKey.text.assign(text);
+    _lookupKey.columns = columns;
+    _lookupKey.bold = _bold;
+    _lookupKey.italic = _italic;
+
+    if (const auto it = _glyphs.find(_lookupKey); it != _glyphs.end())
+    {
+        return it->second;
+    }
+
+    if (_glyphs.size() >= s_maxCachedGlyphs)
+    {
+        _glyphs.clear();
+        _atlas.clear();
+    }
+
+    const til::size size{ _cellSize.width() * gsl::narrow_cast<ptrdiff_t>(columns), _cellSize.height() };
+    const auto offset = _atlas.size();
+    _atlas.resize(offset + size.area<size_t>());
+
+    const auto coverage = gsl::make_span(_atlas).subspan(offset);
+    _rasterizer(text, _bold, _italic, size, coverage);
+    ++_statistics.glyphsRasterized;
+
+    const auto blank = std::all_of(coverage.begin(), coverage.end(), [](const auto alpha) { return alpha == 0; });
+    return _glyphs.emplace(_lookupKey, GlyphEntry{ offset, size, blank }).first->second;
+}
+
+// Routine Description:
+// - Blends the given color into the back buffer using the glyph's coverage.
+// Arguments:
+// - glyph - The atlas entry to draw
+// - origin - The top left corner of the glyph on the frame, in pixels
+// - color - The color to draw the glyph in
+// Return Value:
+// - <none>
+void SoftwareEngine::_BlendGlyph(const GlyphEntry& glyph, const til::point origin, const uint32_t color) noexcept
+{
+    const auto clip = til::rectangle{ origin, glyph.size } & til::rectangle{ _frameSize };
+    const auto glyphWidth = glyph.size.width();
+    const auto frameWidth = _frameSize.width();
+
+    for (auto y = clip.top(); y < clip.bottom(); ++y)
+    {
+        const auto* coverage = _atlas.data() + glyph.offset + (y - origin.y()) * glyphWidth;
+        auto* pixels = _backBuffer.data() + y * frameWidth;
+
+        for (auto x = clip.left(); x < clip.right(); ++x)
+        {
+            const uint32_t alpha = coverage[x - origin.x()];
+            if (alpha == 0xff)
+            {
+                pixels[x] = color;
+            }
+            else if (alpha != 0)
+            {
+                // Blend every channel with (src * a + dst * (255 - a)) / 255.
+                const auto dst = pixels[x];
+                uint32_t result = 0xff000000;
+                for (auto shift = 0; shift < 24; shift += 8)
+                {
+                    const auto s = (color >> shift) & 0xff;
+                    const auto d = (dst >> shift) & 0xff;
+                    result |= ((s * alpha + d * (255 - alpha) + 127) / 255) << shift;
+                }
+                pixels[x] = result;
+            }
+        }
+    }
+}
+
+// Routine Description:
+// - Fills a pixel rectangle of the back buffer, clipped to the frame.
+// Arguments:
+// - pixels - The area to fill
+// - color - The color to fill it with
+// Return Value:
+// - <none>
+void SoftwareEngine::_FillRect(const til::rectangle pixels, const uint32_t color) noexcept
+{
+    const auto clip = pixels & til::rectangle{ _frameSize };
+    const auto frameWidth = _frameSize.width();
+
+    for (auto y = clip.top(); y < clip.bottom(); ++y)
+    {
+        std::fill_n(_backBuffer.begin() + y * frameWidth + clip.left(), clip.width(), color);
+    }
+}
+
+// Routine Description:
+// - Inverts the colors of a pixel rectangle of the back buffer, clipped to the frame.
+// Arguments:
+// - pixels - The area to invert
+// Return Value:
+// - <none>
+void SoftwareEngine::_InvertRect(const til::rectangle pixels) noexcept
+{
+    const auto clip = pixels & til::rectangle{ _frameSize };
+    const auto frameWidth = _frameSize.width();
+
+    for (auto y = clip.top(); y < clip.bottom(); ++y)
+    {
+        const auto row = _backBuffer.begin() + y * frameWidth;
+        std::for_each(row + clip.left(), row + clip.right(), [](auto& pixel) { pixel ^= 0x00ffffff; });
+    }
+}
+
+// Routine Description:
+// - Reallocates the frame for the given number of cells and invalidates all of it.
+// Arguments:
+// - cells - The new size of the viewport in cells
+// Return Value:
+// - <none>
+void SoftwareEngine::_Resize(const til::size cells)
+{
+    _frameSize = cells * _cellSize;
+    _backBuffer.assign(_frameSize.area<size_t>(), _defaultBackgroundColor);
+    _frontBuffer = _backBuffer;
+    _presentDirty.clear();
+    _presentAll = false;
+
+    _invalidMap.resize(cells);
+    _invalidMap.set_all();
+    _invalidScroll = {};
+}
+
+// Routine Description:
+// - Converts a COLORREF into an opaque pixel of our framebuffer.
+//   COLORREFs are 0x00bbggrr, so they're already in RGBA byte order.
+uint32_t SoftwareEngine::s_ToPixel(const COLORREF color) noexcept
+{
+    return 0xff000000 | (color & 0x00ffffff);
+}
+
+// Routine Description:
+// - The default glyph rasterizer. It doesn't need a font: every cluster is
+//   drawn as the hex value of its first codepoint, inside a box if there's
+//   enough room. Whitespace stays blank.
+// Arguments:
+// - text - The text of the cluster
+// - bold - Draws every pixel one pixel wider
+// - italic - Slants the glyph to the right
+// - size - The size of the glyph in pixels
+// - coverage - Receives the coverage mask
+// Return Value:
+// - <none>
+void SoftwareEngine::s_RasterizeCodepointBox(const std::wstring_view text,
+                                             const bool bold,
+                                             const bool italic,
+                                             const til::size size,
+                                             gsl::span<uint8_t> coverage) noexcept
+{
+    std::fill(coverage.begin(), coverage.end(), uint8_t{ 0 });
+
+    uint32_t codepoint = text.empty() ? 0 : til::at(text, 0);
+    if (text.size() >= 2 && IS_HIGH_SURROGATE(til::at(text, 0)) && IS_LOW_SURROGATE(til::at(text, 1)))
+    {
+        codepoint = 0x10000 + ((til::at(text, 0) - 0xD800) << 10) + (til::at(text, 1) - 0xDC00);
+    }
+    if (codepoint <= L' ' || codepoint == 0x7F || codepoint == 0xA0 || codepoint == 0x3000)
+    {
+        return;
+    }
+
+    const auto width = size.width();
+    const auto height = size.height();
+
+    const auto plot = [&](ptrdiff_t x, const ptrdiff_t y) {
+        if (italic)
+        {
+            x += (height - 1 - y) / 6;
+        }
+        for (auto i = x; i <= x + (bold ? 1 : 0); ++i)
+        {
+            if (i >= 0 && i < width && y >= 0 && y < height)
+            {
+                til::at(coverage, y * width + i) = 0xff;
+            }
+        }
+    };
+
+    // Lay the digits out in two rows, with a pixel of space between them.
+    const ptrdiff_t digits = codepoint > 0xFFFF ? 6 : 4;
+    const auto blockWidth = digits / 2 * 4 - 1;
+    const ptrdiff_t blockHeight = 11;
+
+    auto scale = std::min((width - 4) / blockWidth, (height - 4) / blockHeight);
+    const auto boxed = scale >= 1 || std::min(width / blockWidth, height / blockHeight) < 1;
+    if (boxed)
+    {
+        for (ptrdiff_t x = 0; x < width; ++x)
+        {
+            plot(x, 0);
+            plot(x, height - 1);
+        }
+        for (ptrdiff_t y = 1; y < height - 1; ++y)
+        {
+            plot(0, y);
+            plot(width - 1, y);
+        }
+    }
+    else
+    {
+        scale = std::min(width / blockWidth, height / blockHeight);
+    }
+
+    if (scale < 1)
+    {
+        return;
+    }
+
+    const auto originX = (width - blockWidth * scale) / 2;
+    const auto originY = (height - blockHeight * scale) / 2;
+
+    for (ptrdiff_t i = 0; i < digits; ++i)
+    {
+        const auto bits = til::at(s_hexDigits, (codepoint >> (4 * (digits - 1 - i))) & 0xF);
+        const auto digitX = originX + (i % (digits / 2)) * 4 * scale;
+        const auto digitY = originY + (i / (digits / 2)) * 6 * scale;
+
+        for (ptrdiff_t bit = 0; bit < 15; ++bit)
+        {
+            if ((bits >> (14 - bit)) & 1)
+            {
+                for (ptrdiff_t dy = 0; dy < scale; ++dy)
+                {
+                    for (ptrdiff_t dx = 0; dx < scale; ++dx)
+                    {
+                        plot(digitX + (bit % 3) * scale + dx, digitY + (bit / 3) * scale + dy);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,160 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- SoftwareRenderer.hpp
+
+Abstract:
+- This is the definition of a rendering engine that rasterizes the console
+  into an in-memory 32bpp framebuffer on the CPU. It has no dependency on
+  GDI, DirectX or a window, which allows the full Renderer pipeline to be
+  driven headlessly for benchmarking and for pixel comparison tests.
+- Glyphs are rasterized once into a coverage atlas keyed by their text,
+  cell width and font style, and blended into the framebuffer from there.
+--*/
+
+#pragma once
+
+#include "../../renderer/inc/RenderEngineBase.hpp"
+
+namespace Microsoft::Console::Render
+{
+    class SoftwareEngine final : public RenderEngineBase
+    {
+    public:
+        // Receives the text of a single cluster and fills in an 8-bit coverage
+        // mask of size.width() * size.height() bytes, top row first.
+        using GlyphRasterizer = std::function<void(const std::wstring_view text,
+                                                   const bool bold,
+                                                   const bool italic,
+                                                   const til::size size,
+                                                   gsl::span<uint8_t> coverage)>;
+
+        struct Statistics
+        {
+            size_t framesPresented;
+            size_t rowsPresented;
+            size_t glyphsRasterized;
+            size_t glyphsDrawn;
+            std::chrono::microseconds paintTime;
+        };
+
+        SoftwareEngine(const til::size cellSize = s_defaultCellSize);
+        ~SoftwareEngine() override = default;
+
+        void SetGlyphRasterizer(GlyphRasterizer rasterizer);
+
+        til::size GetFrameSize() const noexcept;
+        gsl::span<const uint32_t> GetFrame() const noexcept;
+        const Statistics& GetStatistics() const noexcept;
+
+        // IRenderEngine Members
+        [[nodiscard]] HRESULT Invalidate(const SMALL_RECT* const psrRegion) noexcept override;
+        [[nodiscard]] HRESULT InvalidateCursor(const SMALL_RECT* const psrRegion) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSystem(const RECT* const prcDirtyClient) noexcept override;
+        [[nodiscard]] HRESULT InvalidateSelection(const std::vector<SMALL_RECT>& rectangles) noexcept override;
+        [[nodiscard]] HRESULT InvalidateScroll(const COORD* const pcoordDelta) noexcept override;
+        [[nodiscard]] HRESULT InvalidateAll() noexcept override;
+        [[nodiscard]] HRESULT InvalidateCircling(_Out_ bool* const pForcePaint) noexcept override;
+        [[nodiscard]] HRESULT PrepareForTeardown(_Out_ bool* const pForcePaint) noexcept override;
+
+        [[nodiscard]] HRESULT StartPaint() noexcept override;
+        [[nodiscard]] HRESULT EndPaint() noexcept override;
+        [[nodiscard]] HRESULT Present() noexcept override;
+
+        [[nodiscard]] HRESULT ScrollFrame() noexcept override;
+
+        [[nodiscard]] HRESULT PaintBackground() noexcept override;
+        [[nodiscard]] HRESULT PaintBufferLine(gsl::span<const Cluster> const clusters,
+                                              const COORD coord,
+                                              const bool trimLeft,
+                                              const bool lineWrapped) noexcept override;
+        [[nodiscard]] HRESULT PaintBufferGridLines(GridLines const lines, COLORREF const color, size_t const cchLine, COORD const coordTarget) noexcept override;
+        [[nodiscard]] HRESULT PaintSelection(const SMALL_RECT rect) noexcept override;
+
+        [[nodiscard]] HRESULT PaintCursor(const CursorOptions& options) noexcept override;
+
+        [[nodiscard]] HRESULT UpdateDrawingBrushes(const TextAttribute& textAttributes,
+                                                   const gsl::not_null<IRenderData*> pData,
+                                                   bool const isSettingDefaultBrushes) noexcept override;
+        [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo) noexcept override;
+        [[nodiscard]] HRESULT UpdateDpi(int const iDpi) noexcept override;
+        [[nodiscard]] HRESULT UpdateViewport(const SMALL_RECT srNewViewport) noexcept override;
+
+        [[nodiscard]] HRESULT GetProposedFont(const FontInfoDesired& fiFontInfoDesired, FontInfo& fiFontInfo, int const iDpi) noexcept override;
+
+        [[nodiscard]] HRESULT GetDirtyArea(gsl::span<const til::rectangle>& area) noexcept override;
+        [[nodiscard]] HRESULT GetFontSize(_Out_ COORD* const pFontSize) noexcept override;
+        [[nodiscard]] HRESULT IsGlyphWideByFont(const std::wstring_view glyph, _Out_ bool* const pResult) noexcept override;
+
+    protected:
+        [[nodiscard]] HRESULT _DoUpdateTitle(_In_ const std::wstring_view newTitle) noexcept override;
+
+    private:
+        static constexpr til::size s_defaultCellSize{ 8, 16 };
+        static constexpr size_t s_maxCachedGlyphs = 4096;
+
+        struct GlyphKey
+        {
+            std::wstring text;
+            size_t columns;
+            bool bold;
+            bool italic;
+
+            bool operator==(const GlyphKey& other) const noexcept;
+        };
+
+        struct GlyphKeyHash
+        {
+            size_t operator()(const GlyphKey& key) const noexcept;
+        };
+
+        struct GlyphEntry
+        {
+            size_t offset;
+            til::size size;
+            bool blank;
+        };
+
+        til::size _cellSize;
+        til::size _frameSize;
+
+        std::vector<uint32_t> _backBuffer;
+        std::vector<uint32_t> _frontBuffer;
+
+        std::pmr::unsynchronized_pool_resource _pool;
+        til::pmr::bitmap _invalidMap;
+        til::point _invalidScroll;
+        std::vector<til::rectangle> _presentDirty;
+        bool _presentAll;
+        bool _isPainting;
+
+        GlyphRasterizer _rasterizer;
+        std::unordered_map<GlyphKey, GlyphEntry, GlyphKeyHash> _glyphs;
+        std::vector<uint8_t> _atlas;
+        GlyphKey _lookupKey;
+
+        uint32_t _foregroundColor;
+        uint32_t _backgroundColor;
+        uint32_t _defaultBackgroundColor;
+        bool _bold;
+        bool _italic;
+
+        std::chrono::steady_clock::time_point _paintStart;
+        Statistics _statistics;
+
+        const GlyphEntry& _GetGlyph(const std::wstring_view text, const size_t columns);
+        void _BlendGlyph(const GlyphEntry& glyph, const til::point origin, const uint32_t color) noexcept;
+        void _FillRect(const til::rectangle pixels, const uint32_t color) noexcept;
+        void _InvertRect(const til::rectangle pixels) noexcept;
+        void _Resize(const til::size cells);
+
+        static uint32_t s_ToPixel(const COLORREF color) noexcept;
+        static void s_RasterizeCodepointBox(const std::wstring_view text,
+                                            const bool bold,
+                                            const bool italic,
+                                            const til::size size,
+                                            gsl::span<uint8_t> coverage) noexcept;
+    };
+}
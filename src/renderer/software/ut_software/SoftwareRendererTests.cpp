@@ -0,0 +1,199 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "WexTestClass.h"
+#include "../../inc/consoletaeftemplates.hpp"
+
+#include "../SoftwareRenderer.hpp"
+
+using namespace WEX::Common;
+using namespace WEX::Logging;
+using namespace WEX::TestExecution;
+
+using namespace Microsoft::Console::Render;
+
+static constexpr uint32_t black = 0xff000000;
+static constexpr uint32_t white = 0xffffffff;
+
+class SoftwareRendererTests
+{
+    TEST_CLASS(SoftwareRendererTests);
+
+    // Creates an engine with the default 8x16 cells and a viewport of 10x3 cells.
+    static std::unique_ptr<SoftwareEngine> _CreateEngine()
+    {
+        auto engine = std::make_unique<SoftwareEngine>();
+        VERIFY_SUCCEEDED(engine->UpdateViewport({ 0, 0, 9, 2 }));
+        return engine;
+    }
+
+    // Runs a frame the same way Renderer::_PaintFrameForEngine does.
+    template<typename T>
+    static void _PaintFrame(SoftwareEngine& engine, T&& paint)
+    {
+        VERIFY_ARE_EQUAL(S_OK, engine.StartPaint());
+        VERIFY_SUCCEEDED(engine.ScrollFrame());
+        VERIFY_SUCCEEDED(engine.PaintBackground());
+        paint();
+        VERIFY_SUCCEEDED(engine.EndPaint());
+        VERIFY_SUCCEEDED(engine.Present());
+    }
+
+    static uint32_t _PixelAt(const SoftwareEngine& engine, const ptrdiff_t x, const ptrdiff_t y)
+    {
+        return til::at(engine.GetFrame(), y * engine.GetFrameSize().width() + x);
+    }
+
+    TEST_METHOD(RendersGlyphsIntoFrame)
+    {
+        const auto engine = _CreateEngine();
+        VERIFY_ARE_EQUAL(til::size(80, 48), engine->GetFrameSize());
+
+        const std::array<Cluster, 2> clusters{ Cluster{ L"A", 1 }, Cluster{ L" ", 1 } };
+        _PaintFrame(*engine, [&]() {
+            VERIFY_SUCCEEDED(engine->PaintBufferLine(clusters, { 0, 0 }, false, false));
+        });
+
+        // The fallback glyph for "A" is its codepoint "0041" in two rows of
+        // 3x5 pixel digits, centered vertically in the 8x16 cell.
+        Log::Comment(L"Top row of the first \"0\"");
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 0, 2));
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 2, 2));
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 3, 2));
+        Log::Comment(L"Top row of the \"4\"");
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 0, 8));
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 1, 8));
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 2, 8));
+
+        Log::Comment(L"The space stays blank");
+        for (ptrdiff_t y = 0; y < 16; ++y)
+        {
+            for (ptrdiff_t x = 8; x < 16; ++x)
+            {
+                VERIFY_ARE_EQUAL(black, _PixelAt(*engine, x, y));
+            }
+        }
+    }
+
+    TEST_METHOD(PresentsOnlyDirtyRows)
+    {
+        const auto engine = _CreateEngine();
+
+        const std::array<Cluster, 1> a{ Cluster{ L"A", 1 } };
+        _PaintFrame(*engine, [&]() {
+            VERIFY_SUCCEEDED(engine->PaintBufferLine(a, { 0, 0 }, false, false));
+        });
+        VERIFY_ARE_EQUAL(3u, engine->GetStatistics().rowsPresented);
+        VERIFY_ARE_EQUAL(S_FALSE, engine->StartPaint(), L"Nothing is invalid after a frame");
+
+        SMALL_RECT row{ 0, 1, 10, 2 };
+        VERIFY_SUCCEEDED(engine->Invalidate(&row));
+
+        gsl::span<const til::rectangle> dirty;
+        VERIFY_SUCCEEDED(engine->GetDirtyArea(dirty));
+        VERIFY_ARE_EQUAL(1u, dirty.size());
+        VERIFY_ARE_EQUAL(til::rectangle(0, 1, 10, 2), til::at(dirty, 0));
+
+        const std::array<Cluster, 1> b{ Cluster{ L"B", 1 } };
+        _PaintFrame(*engine, [&]() {
+            VERIFY_SUCCEEDED(engine->PaintBufferLine(b, { 0, 1 }, false, false));
+        });
+
+        const auto& statistics = engine->GetStatistics();
+        VERIFY_ARE_EQUAL(2u, statistics.framesPresented);
+        VERIFY_ARE_EQUAL(4u, statistics.rowsPresented);
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 0, 2), L"Row 0 was left untouched");
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 0, 16 + 2), L"Row 1 received the new glyph");
+    }
+
+    TEST_METHOD(CachesGlyphsInAtlas)
+    {
+        const auto engine = _CreateEngine();
+
+        const std::array<Cluster, 4> clusters{ Cluster{ L"x", 1 }, Cluster{ L"x", 1 }, Cluster{ L"x", 2 }, Cluster{ L"x", 1 } };
+        _PaintFrame(*engine, [&]() {
+            VERIFY_SUCCEEDED(engine->PaintBufferLine(clusters, { 0, 0 }, false, false));
+            VERIFY_SUCCEEDED(engine->PaintBufferLine(clusters, { 0, 1 }, false, false));
+        });
+
+        // The wide "x" is a different glyph, as it covers two cells.
+        VERIFY_ARE_EQUAL(2u, engine->GetStatistics().glyphsRasterized);
+        VERIFY_ARE_EQUAL(8u, engine->GetStatistics().glyphsDrawn);
+    }
+
+    TEST_METHOD(UsesCustomRasterizer)
+    {
+        const auto engine = _CreateEngine();
+
+        std::wstring rasterized;
+        engine->SetGlyphRasterizer([&](const std::wstring_view text, const bool, const bool, const til::size size, gsl::span<uint8_t> coverage) {
+            VERIFY_ARE_EQUAL(til::size(8, 16), size);
+            rasterized += text;
+            std::fill(coverage.begin(), coverage.end(), uint8_t{ 0x80 });
+        });
+
+        const std::array<Cluster, 1> clusters{ Cluster{ L"\xD83D\xDE00", 1 } };
+        _PaintFrame(*engine, [&]() {
+            VERIFY_SUCCEEDED(engine->PaintBufferLine(clusters, { 1, 0 }, false, false));
+        });
+
+        VERIFY_ARE_EQUAL(L"\xD83D\xDE00", rasterized);
+
+        // Half coverage blends white halfway into black.
+        VERIFY_ARE_EQUAL(0xff808080u, _PixelAt(*engine, 8, 0));
+        VERIFY_ARE_EQUAL(0xff808080u, _PixelAt(*engine, 15, 15));
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 16, 0));
+    }
+
+    TEST_METHOD(PaintsSelectionAndCursor)
+    {
+        const auto engine = _CreateEngine();
+
+        CursorOptions options{};
+        options.coordCursor = { 3, 2 };
+        options.cursorType = CursorType::FullBox;
+        options.fUseColor = true;
+        options.cursorColor = RGB(0xff, 0, 0);
+        options.isOn = true;
+
+        _PaintFrame(*engine, [&]() {
+            VERIFY_SUCCEEDED(engine->PaintSelection({ 1, 0, 3, 1 }));
+            VERIFY_SUCCEEDED(engine->PaintCursor(options));
+        });
+
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 7, 0));
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 8, 0));
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 23, 15));
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 24, 0));
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 8, 16));
+
+        VERIFY_ARE_EQUAL(0xff0000ffu, _PixelAt(*engine, 24, 32));
+        VERIFY_ARE_EQUAL(0xff0000ffu, _PixelAt(*engine, 31, 47));
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 32, 32));
+    }
+
+    TEST_METHOD(ScrollsFramePixels)
+    {
+        const auto engine = _CreateEngine();
+
+        const std::array<Cluster, 1> clusters{ Cluster{ L"A", 1 } };
+        _PaintFrame(*engine, [&]() {
+            VERIFY_SUCCEEDED(engine->PaintBufferLine(clusters, { 0, 1 }, false, false));
+        });
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 0, 16 + 2));
+
+        COORD delta{ 0, -1 };
+        VERIFY_SUCCEEDED(engine->InvalidateScroll(&delta));
+
+        gsl::span<const til::rectangle> dirty;
+        VERIFY_SUCCEEDED(engine->GetDirtyArea(dirty));
+        VERIFY_ARE_EQUAL(1u, dirty.size());
+        VERIFY_ARE_EQUAL(til::rectangle(0, 2, 10, 3), til::at(dirty, 0), L"Only the uncovered row needs to be painted");
+
+        _PaintFrame(*engine, []() {});
+
+        VERIFY_ARE_EQUAL(white, _PixelAt(*engine, 0, 2), L"The glyph moved up by one row");
+        VERIFY_ARE_EQUAL(black, _PixelAt(*engine, 0, 16 + 2));
+    }
+};
@@ -97,6 +97,44 @@ using namespace Microsoft::Console::Render;
     return _WriteFormattedString(&format, chars);
 }
 
+// Method Description:
+// - Moves the cursor backward (left) a number of characters.
+// Arguments:
+// - chars: a number of characters to move cursor left by.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_CursorBackward(const short chars) noexcept
+{
+    static const std::string format = "\x1b[%dD";
+    return _WriteFormattedString(&format, chars);
+}
+
+// Method Description:
+// - Moves the cursor up a number of lines, staying in the same column.
+// Arguments:
+// - lines: a number of lines to move the cursor up by.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_CursorUp(const short lines) noexcept
+{
+    static const std::string format = "\x1b[%dA";
+    return _WriteFormattedString(&format, lines);
+}
+
+// Method Description:
+// - Moves the cursor down a number of lines, staying in the same column.
+//   Unlike a line feed, this doesn't break the line wrapping of the row the
+//   cursor leaves.
+// Arguments:
+// - lines: a number of lines to move the cursor down by.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_CursorDown(const short lines) noexcept
+{
+    static const std::string format = "\x1b[%dB";
+    return _WriteFormattedString(&format, lines);
+}
+
 // Method Description:
 // - Formats and writes a sequence to erase the remainder of the line starting
 //      from the cursor position.
@@ -200,7 +238,75 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetGraphicsDefault() noexcept
 {
-    return _Write("\x1b[m");
+    return _WriteGraphicsRendition("");
+}
+
+// Method Description:
+// - Writes a SGR sequence with the given parameters. Between a call to
+//   _BeginGraphicsRendition and _EndGraphicsRendition, the parameters are
+//   appended to a pending sequence instead, so that all the changes of a run
+//   go out as a single SGR.
+// - An empty parameter is a reset. Inside a batch it's written as an explicit
+//   0, since not every VT parser reads an empty parameter as its default.
+// Arguments:
+// - parameters: the parameters of the sequence, without the CSI or the final 'm'.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_WriteGraphicsRendition(const std::string_view parameters) noexcept
+try
+{
+    if (_batchGraphicsRendition)
+    {
+        if (_graphicsRenditionParams++ != 0)
+        {
+            _graphicsRenditionBatch.push_back(';');
+        }
+        _graphicsRenditionBatch.append(parameters.empty() ? "0" : parameters);
+        return S_OK;
+    }
+
+    _graphicsRenditionSequence.clear();
+    fmt::format_to(std::back_inserter(_graphicsRenditionSequence), FMT_COMPILE("\x1b[{}m"), parameters);
+    return _Write(_graphicsRenditionSequence);
+}
+CATCH_RETURN();
+
+// Method Description:
+// - Starts gathering the parameters of the following SGR sequences, until
+//   _EndGraphicsRendition writes them out.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtEngine::_BeginGraphicsRendition() noexcept
+{
+    _batchGraphicsRendition = true;
+    _graphicsRenditionParams = 0;
+    _graphicsRenditionBatch.clear();
+}
+
+// Method Description:
+// - Writes the SGR parameters gathered since _BeginGraphicsRendition as a
+//   single sequence, if there are any. A lone reset is still written as the
+//   shorter, parameterless SGR.
+// Arguments:
+// - <none>
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT VtEngine::_EndGraphicsRendition() noexcept
+{
+    _batchGraphicsRendition = false;
+    if (_graphicsRenditionParams == 0)
+    {
+        return S_OK;
+    }
+
+    _graphicsRenditionParams = 0;
+    if (_graphicsRenditionBatch == "0")
+    {
+        return _WriteGraphicsRendition("");
+    }
+    return _WriteGraphicsRendition(_graphicsRenditionBatch);
 }
 
 // Method Description:
@@ -213,8 +319,6 @@ using namespace Microsoft::Console::Render;
 [[nodiscard]] HRESULT VtEngine::_SetGraphicsRendition16Color(const WORD wAttr,
                                                              const bool fIsForeground) noexcept
 {
-    static const std::string fmt = "\x1b[%dm";
-
     // Always check using the foreground flags, because the bg flags constants
     //  are a higher byte
     // Foreground sequences are in [30,37] U [90,97]
@@ -234,7 +338,13 @@ using namespace Microsoft::Console::Render;
                         (WI_IsFlagSet(wAttr, FOREGROUND_GREEN) ? 2 : 0) +
                         (WI_IsFlagSet(wAttr, FOREGROUND_BLUE) ? 4 : 0);
 
-    return _WriteFormattedString(&fmt, vtIndex);
+    try
+    {
+        fmt::memory_buffer parameters;
+        fmt::format_to(std::back_inserter(parameters), FMT_COMPILE("{}"), vtIndex);
+        return _WriteGraphicsRendition({ parameters.data(), parameters.size() });
+    }
+    CATCH_RETURN();
 }
 
 // Method Description:
@@ -248,11 +358,13 @@ using namespace Microsoft::Console::Render;
 [[nodiscard]] HRESULT VtEngine::_SetGraphicsRendition256Color(const WORD index,
                                                               const bool fIsForeground) noexcept
 {
-    const std::string fmt = fIsForeground ?
-                                "\x1b[38;5;%dm" :
-                                "\x1b[48;5;%dm";
-
-    return _WriteFormattedString(&fmt, ::Xterm256ToWindowsIndex(index));
+    try
+    {
+        fmt::memory_buffer parameters;
+        fmt::format_to(std::back_inserter(parameters), FMT_COMPILE("{}8;5;{}"), fIsForeground ? 3 : 4, ::Xterm256ToWindowsIndex(index));
+        return _WriteGraphicsRendition({ parameters.data(), parameters.size() });
+    }
+    CATCH_RETURN();
 }
 
 // Method Description:
@@ -266,15 +378,17 @@ using namespace Microsoft::Console::Render;
 [[nodiscard]] HRESULT VtEngine::_SetGraphicsRenditionRGBColor(const COLORREF color,
                                                               const bool fIsForeground) noexcept
 {
-    const std::string fmt = fIsForeground ?
-                                "\x1b[38;2;%d;%d;%dm" :
-                                "\x1b[48;2;%d;%d;%dm";
-
     DWORD const r = GetRValue(color);
     DWORD const g = GetGValue(color);
     DWORD const b = GetBValue(color);
 
-    return _WriteFormattedString(&fmt, r, g, b);
+    try
+    {
+        fmt::memory_buffer parameters;
+        fmt::format_to(std::back_inserter(parameters), FMT_COMPILE("{}8;2;{};{};{}"), fIsForeground ? 3 : 4, r, g, b);
+        return _WriteGraphicsRendition({ parameters.data(), parameters.size() });
+    }
+    CATCH_RETURN();
 }
 
 // Method Description:
@@ -286,9 +400,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetGraphicsRenditionDefaultColor(const bool fIsForeground) noexcept
 {
-    const std::string_view fmt = fIsForeground ? ("\x1b[39m") : ("\x1b[49m");
-
-    return _Write(fmt);
+    return _WriteGraphicsRendition(fIsForeground ? "39" : "49");
 }
 
 // Method Description:
@@ -341,7 +453,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetBold(const bool isBold) noexcept
 {
-    return _Write(isBold ? "\x1b[1m" : "\x1b[22m");
+    return _WriteGraphicsRendition(isBold ? "1" : "22");
 }
 
 // Method Description:
@@ -352,7 +464,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetFaint(const bool isFaint) noexcept
 {
-    return _Write(isFaint ? "\x1b[2m" : "\x1b[22m");
+    return _WriteGraphicsRendition(isFaint ? "2" : "22");
 }
 
 // Method Description:
@@ -363,7 +475,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetUnderlined(const bool isUnderlined) noexcept
 {
-    return _Write(isUnderlined ? "\x1b[4m" : "\x1b[24m");
+    return _WriteGraphicsRendition(isUnderlined ? "4" : "24");
 }
 
 // Method Description:
@@ -374,7 +486,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetDoublyUnderlined(const bool isUnderlined) noexcept
 {
-    return _Write(isUnderlined ? "\x1b[21m" : "\x1b[24m");
+    return _WriteGraphicsRendition(isUnderlined ? "21" : "24");
 }
 
 // Method Description:
@@ -385,7 +497,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetOverlined(const bool isOverlined) noexcept
 {
-    return _Write(isOverlined ? "\x1b[53m" : "\x1b[55m");
+    return _WriteGraphicsRendition(isOverlined ? "53" : "55");
 }
 
 // Method Description:
@@ -396,7 +508,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetItalic(const bool isItalic) noexcept
 {
-    return _Write(isItalic ? "\x1b[3m" : "\x1b[23m");
+    return _WriteGraphicsRendition(isItalic ? "3" : "23");
 }
 
 // Method Description:
@@ -407,7 +519,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetBlinking(const bool isBlinking) noexcept
 {
-    return _Write(isBlinking ? "\x1b[5m" : "\x1b[25m");
+    return _WriteGraphicsRendition(isBlinking ? "5" : "25");
 }
 
 // Method Description:
@@ -418,7 +530,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetInvisible(const bool isInvisible) noexcept
 {
-    return _Write(isInvisible ? "\x1b[8m" : "\x1b[28m");
+    return _WriteGraphicsRendition(isInvisible ? "8" : "28");
 }
 
 // Method Description:
@@ -429,7 +541,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetCrossedOut(const bool isCrossedOut) noexcept
 {
-    return _Write(isCrossedOut ? "\x1b[9m" : "\x1b[29m");
+    return _WriteGraphicsRendition(isCrossedOut ? "9" : "29");
 }
 
 // Method Description:
@@ -440,7 +552,7 @@ using namespace Microsoft::Console::Render;
 // - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
 [[nodiscard]] HRESULT VtEngine::_SetReverseVideo(const bool isReversed) noexcept
 {
-    return _Write(isReversed ? "\x1b[7m" : "\x1b[27m");
+    return _WriteGraphicsRendition(isReversed ? "7" : "27");
 }
 
 // Method Description:
@@ -28,13 +28,58 @@ Xterm256Engine::Xterm256Engine(_In_ wil::unique_hfile hPipe,
                                                            const gsl::not_null<IRenderData*> pData,
                                                            const bool /*isSettingDefaultBrushes*/) noexcept
 {
-    RETURN_IF_FAILED(VtEngine::_RgbUpdateDrawingBrushes(textAttributes));
+    RETURN_IF_FAILED(_UpdateGraphicsRendition(textAttributes));
+
+    return _UpdateHyperlinkAttr(textAttributes, pData);
+}
 
-    RETURN_IF_FAILED(_UpdateHyperlinkAttr(textAttributes, pData));
+// Routine Description:
+// - Write a single SGR sequence to update the colors and the character
+//   rendition attributes. We work out both the changes relative to the last
+//   attributes, and the changes relative to a reset, and write whichever of
+//   the two is shorter.
+// Arguments:
+// - textAttributes - text attributes to use.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT Xterm256Engine::_UpdateGraphicsRendition(const TextAttribute& textAttributes) noexcept
+try
+{
+    _BeginGraphicsRendition();
+    auto endBatch = wil::scope_exit([&]() noexcept { _batchGraphicsRendition = false; });
 
+    const auto original = _lastTextAttributes;
+
+    RETURN_IF_FAILED(VtEngine::_RgbUpdateDrawingBrushes(textAttributes));
     // Only do extended attributes in xterm-256color, as to not break telnet.exe.
-    return _UpdateExtendedAttrs(textAttributes);
+    RETURN_IF_FAILED(_UpdateExtendedAttrs(textAttributes));
+
+    auto delta = std::move(_graphicsRenditionBatch);
+    const auto deltaParams = _graphicsRenditionParams;
+    const auto deltaAttributes = _lastTextAttributes;
+
+    // An SGR reset clears everything but the hyperlink.
+    _BeginGraphicsRendition();
+    auto reset = TextAttribute{};
+    reset.SetHyperlinkId(original.GetHyperlinkId());
+    _lastTextAttributes = reset;
+    RETURN_IF_FAILED(_WriteGraphicsRendition(""));
+    RETURN_IF_FAILED(VtEngine::_RgbUpdateDrawingBrushes(textAttributes));
+    RETURN_IF_FAILED(_UpdateExtendedAttrs(textAttributes));
+
+    // Keep the changes unless the reset is strictly shorter. When nothing
+    // changed at all, there are no changes to write.
+    if (deltaParams == 0 || delta.size() <= _graphicsRenditionBatch.size())
+    {
+        _graphicsRenditionBatch = std::move(delta);
+        _graphicsRenditionParams = deltaParams;
+        _lastTextAttributes = deltaAttributes;
+    }
+
+    endBatch.release();
+    return _EndGraphicsRendition();
 }
+CATCH_RETURN();
 
 // Routine Description:
 // - Write a VT sequence to update the character rendition attributes.
@@ -9,6 +9,17 @@ using namespace Microsoft::Console;
 using namespace Microsoft::Console::Render;
 using namespace Microsoft::Console::Types;
 
+// Returns the number of decimal digits needed to print the given number.
+static constexpr size_t s_DigitCount(int value) noexcept
+{
+    size_t digits = 1;
+    for (; value >= 10; value /= 10)
+    {
+        ++digits;
+    }
+    return digits;
+}
+
 XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
                          const Viewport initialViewport,
                          const bool fUseAsciiOnly) :
@@ -52,6 +63,7 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
         //      the screen on the first paint, just to make sure that the
         //      terminal's state is consistent with what we'll be rendering.
         RETURN_IF_FAILED(_ClearScreen());
+        _ForgetAllKnownCells();
         _clearedAllThisFrame = true;
         _firstPaint = false;
     }
@@ -223,10 +235,11 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
 // - Write a VT sequence to move the cursor to the specified coordinates. We
 //      also store the last place we left the cursor for future optimizations.
 //  If the cursor only needs to go to the origin, only write the home sequence.
-//  If the new cursor is only down one line from the current, only write a newline
 //  If the new cursor is only down one line and at the start of the line, write
-//      a carriage return.
-//  Otherwise just write the whole sequence for moving it.
+//      a carriage return and a newline.
+//  Otherwise, in ascii mode we keep using the handful of simple movements
+//      telnet is known to handle, and in every other mode we write whichever
+//      of the candidate encodings is the shortest. See _MoveCursorCheapest.
 // Arguments:
 // - coord: location to move the cursor to.
 // Return Value:
@@ -286,6 +299,10 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
             // otherwise we might accidentally break wrapped lines (GH#405)
             hr = _CursorPosition(coord);
         }
+        else if (!_fUseAsciiOnly)
+        {
+            hr = _MoveCursorCheapest(coord);
+        }
         else if (coord.X == 0 && coord.Y == _lastText.Y)
         {
             // Start of this line
@@ -330,6 +347,140 @@ XtermEngine::XtermEngine(_In_ wil::unique_hfile hPipe,
     return hr;
 }
 
+// Routine Description:
+// - Moves the cursor to the specified coordinates, using the shortest of:
+//   * an absolute CUP sequence
+//   * a carriage return, followed by a vertical and a horizontal movement
+//   * a vertical and a horizontal movement relative to the current position
+//   Moving forward over cells we've already printed with the current
+//   attributes may be done by simply printing them again.
+//   Relative movements are only considered when we know where the cursor is,
+//   and we never emit a newline unless the column stays the same, since a
+//   newline might clear the wrap flag of the row it leaves.
+// - The caller is responsible for updating _lastText.
+// Arguments:
+// - coord: location to move the cursor to.
+// Return Value:
+// - S_OK if we succeeded, else an appropriate HRESULT for failing to allocate or write.
+[[nodiscard]] HRESULT XtermEngine::_MoveCursorCheapest(const COORD coord) noexcept
+{
+    const auto width = _lastViewport.Width();
+    const auto height = _lastViewport.Height();
+
+    const auto verticalCost = [&](const short fromX) noexcept -> size_t {
+        const auto dy = coord.Y - _lastText.Y;
+        if (dy == 0)
+        {
+            return 0;
+        }
+        if (dy == 1 && fromX == coord.X)
+        {
+            return 1;
+        }
+        return 3 + s_DigitCount(std::abs(dy));
+    };
+    const auto horizontalCost = [&](const short fromX, bool& reprint) noexcept -> size_t {
+        const auto dx = coord.X - fromX;
+        reprint = false;
+        if (dx == 0)
+        {
+            return 0;
+        }
+        if (dx == -1)
+        {
+            return 1;
+        }
+        const size_t sequenceCost = 3 + s_DigitCount(std::abs(dx));
+        if (dx > 0 && gsl::narrow_cast<size_t>(dx) < sequenceCost && _CanReprintKnownCells({ fromX, coord.Y }, dx))
+        {
+            reprint = true;
+            return dx;
+        }
+        return sequenceCost;
+    };
+    const auto writeVertical = [&](const short fromX) noexcept -> HRESULT {
+        const auto dy = gsl::narrow_cast<short>(coord.Y - _lastText.Y);
+        if (dy == 0)
+        {
+            return S_OK;
+        }
+        if (dy == 1 && fromX == coord.X)
+        {
+            return _Write("\n");
+        }
+        // Jumping across rows used to be done with a CUP, and just like with a
+        // CUP, we don't want the cursor to be seen flying around.
+        _needToDisableCursor = true;
+        return dy > 0 ? _CursorDown(dy) : _CursorUp(gsl::narrow_cast<short>(-dy));
+    };
+    const auto writeHorizontal = [&](const short fromX, const bool reprint) noexcept -> HRESULT {
+        const auto dx = gsl::narrow_cast<short>(coord.X - fromX);
+        if (dx == 0)
+        {
+            return S_OK;
+        }
+        if (reprint)
+        {
+            return _ReprintKnownCells({ fromX, coord.Y }, dx);
+        }
+        if (dx == -1)
+        {
+            return _Write("\b");
+        }
+        return dx > 0 ? _CursorForward(dx) : _CursorBackward(gsl::narrow_cast<short>(-dx));
+    };
+
+    enum class Movement
+    {
+        Position,
+        CarriageReturn,
+        Relative
+    };
+
+    auto best = Movement::Position;
+    auto bestCost = 4 + s_DigitCount(coord.Y + 1) + s_DigitCount(coord.X + 1);
+
+    const auto targetInViewport = coord.X >= 0 && coord.X < width && coord.Y >= 0 && coord.Y < height;
+    const auto knownRow = _lastText.Y >= 0 && _lastText.Y < height;
+    const auto knownColumn = _lastText.X >= 0 && _lastText.X < width;
+
+    bool crReprint = false;
+    if (targetInViewport && knownRow)
+    {
+        const auto cost = 1 + verticalCost(0) + horizontalCost(0, crReprint);
+        if (cost < bestCost)
+        {
+            best = Movement::CarriageReturn;
+            bestCost = cost;
+        }
+    }
+
+    bool relativeReprint = false;
+    if (targetInViewport && knownRow && knownColumn)
+    {
+        const auto cost = verticalCost(_lastText.X) + horizontalCost(_lastText.X, relativeReprint);
+        if (cost < bestCost)
+        {
+            best = Movement::Relative;
+            bestCost = cost;
+        }
+    }
+
+    switch (best)
+    {
+    case Movement::CarriageReturn:
+        RETURN_IF_FAILED(_Write("\r"));
+        RETURN_IF_FAILED(writeVertical(0));
+        return writeHorizontal(0, crReprint);
+    case Movement::Relative:
+        RETURN_IF_FAILED(writeVertical(_lastText.X));
+        return writeHorizontal(_lastText.X, relativeReprint);
+    default:
+        _needToDisableCursor = true;
+        return _CursorPosition(coord);
+    }
+}
+
 // Routine Description:
 // - Scrolls the existing data on the in-memory frame by the scroll region
 //      deltas we have collectively received through the Invalidate methods
@@ -360,6 +511,10 @@ try
     const short dy = _scrollDelta.y<short>();
     const short absDy = static_cast<short>(abs(dy));
 
+    // The cells we've printed are moving around. We could shift them along,
+    // but scrolling is rare enough that it's not worth the trouble.
+    _ForgetAllKnownCells();
+
     // Save the old wrap state here. We're going to clear it so that
     // _MoveCursor will definitely move us to the right position. We'll
     // restore the state afterwards.
@@ -518,6 +673,8 @@ CATCH_RETURN();
 // - S_OK or suitable HRESULT error from either conversion or writing pipe.
 [[nodiscard]] HRESULT XtermEngine::WriteTerminalW(const std::wstring_view wstr) noexcept
 {
+    // We have no idea what this string does to the terminal's contents.
+    _ForgetAllKnownCells();
     RETURN_IF_FAILED(_fUseAsciiOnly ?
                          VtEngine::_WriteTerminalAscii(wstr) :
                          VtEngine::_WriteTerminalUtf8(wstr));
@@ -355,6 +355,7 @@ using namespace Microsoft::Console::Types;
         }
 
         RETURN_IF_FAILED(VtEngine::_WriteTerminalAscii(_bufferLine));
+        _RememberKnownCells(clusters, coord, totalWidth);
 
         // Update our internal tracker of the cursor's position
         _lastText.X += totalWidth;
@@ -491,6 +492,11 @@ using namespace Microsoft::Console::Types;
     // Write the actual text string
     RETURN_IF_FAILED(VtEngine::_WriteTerminalUtf8({ _bufferLine.data(), cchActual }));
 
+    // Whatever happens to the spaces we didn't print (erased, skipped over or
+    // printed separately below), we won't try to reprint them later.
+    _RememberKnownCells(clusters, coord, columnsActual);
+    _ForgetKnownCells({ coord.X + gsl::narrow_cast<short>(columnsActual), coord.Y }, totalWidth - columnsActual);
+
     // GH#4415, GH#5181
     // If the renderer told us that this was a wrapped line, then mark
     // that we've wrapped this line. The next time we attempt to move the
@@ -558,6 +564,7 @@ using namespace Microsoft::Console::Types;
         else
         {
             RETURN_IF_FAILED(_EraseLine());
+            _ForgetKnownCells(_lastText, _lastViewport.Width());
         }
     }
     else if (_newBottomLine && printingBottomLine)
@@ -589,6 +596,137 @@ using namespace Microsoft::Console::Types;
     return S_OK;
 }
 
+// Routine Description:
+// - Records the cells we just printed, so that a later cursor movement can
+//   print them again instead of moving over them. See _CanReprintKnownCells.
+// Arguments:
+// - clusters - the text that was printed
+// - coord - the position the text was printed at
+// - columns - the number of columns of the clusters that were actually printed
+// Return Value:
+// - <none>
+void VtEngine::_RememberKnownCells(gsl::span<const Cluster> clusters, const COORD coord, const size_t columns) noexcept
+{
+    const auto width = gsl::narrow_cast<size_t>(_lastViewport.Width());
+    if (coord.X < 0 || coord.Y < 0 || coord.Y >= _lastViewport.Height() || _knownCells.size() != width * _lastViewport.Height())
+    {
+        return;
+    }
+
+    const auto row = gsl::narrow_cast<size_t>(coord.Y) * width;
+    const auto end = std::min(gsl::narrow_cast<size_t>(coord.X) + columns, width);
+    auto column = gsl::narrow_cast<size_t>(coord.X);
+    for (const auto& cluster : clusters)
+    {
+        if (column >= end)
+        {
+            break;
+        }
+
+        const auto text = cluster.GetText();
+        const auto printable = cluster.GetColumns() == 1 && text.size() == 1 && text.front() >= L'\x20' && text.front() < L'\x7f';
+        const auto wch = printable ? text.front() : L'\0';
+        for (size_t i = 0; i < cluster.GetColumns() && column < end; ++i, ++column)
+        {
+            auto& cell = til::at(_knownCells, row + column);
+            cell.wch = wch;
+            cell.attr = _lastTextAttributes;
+        }
+    }
+}
+
+// Routine Description:
+// - Forgets the cells in the given part of a row, because they've been erased
+//   or we don't know what happened to them.
+// Arguments:
+// - coord - the first cell to forget
+// - columns - the number of cells to forget. Clamped to the end of the row.
+// Return Value:
+// - <none>
+void VtEngine::_ForgetKnownCells(const COORD coord, const size_t columns) noexcept
+{
+    const auto width = gsl::narrow_cast<size_t>(_lastViewport.Width());
+    if (coord.X < 0 || coord.Y < 0 || coord.Y >= _lastViewport.Height() || _knownCells.size() != width * _lastViewport.Height())
+    {
+        return;
+    }
+
+    const auto row = gsl::narrow_cast<size_t>(coord.Y) * width;
+    const auto end = std::min(gsl::narrow_cast<size_t>(coord.X) + columns, width);
+    for (auto column = gsl::narrow_cast<size_t>(coord.X); column < end; ++column)
+    {
+        til::at(_knownCells, row + column).wch = L'\0';
+    }
+}
+
+// Routine Description:
+// - Forgets every cell we've printed. Used whenever the terminal's contents
+//   were moved or changed in a way we don't track, like scrolling.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void VtEngine::_ForgetAllKnownCells() noexcept
+{
+    for (auto& cell : _knownCells)
+    {
+        cell.wch = L'\0';
+    }
+}
+
+// Routine Description:
+// - Returns true if we know what every cell in the given part of a row holds,
+//   and they were all printed with the attributes we're currently using. In
+//   that case printing them again leaves the terminal's contents unchanged,
+//   and simply moves the cursor past them.
+// Arguments:
+// - coord - the first cell to reprint
+// - columns - the number of cells to reprint
+// Return Value:
+// - true if the cells can be reprinted with _ReprintKnownCells.
+bool VtEngine::_CanReprintKnownCells(const COORD coord, const size_t columns) const noexcept
+{
+    const auto width = gsl::narrow_cast<size_t>(_lastViewport.Width());
+    if (coord.X < 0 || coord.Y < 0 || coord.Y >= _lastViewport.Height() || _knownCells.size() != width * _lastViewport.Height())
+    {
+        return false;
+    }
+
+    // Never reprint into the last column. That would put the terminal into
+    // the delayed EOL wrap state, which we go to great lengths to avoid.
+    if (gsl::narrow_cast<size_t>(coord.X) + columns >= width)
+    {
+        return false;
+    }
+
+    const auto begin = _knownCells.begin() + gsl::narrow_cast<size_t>(coord.Y) * width + coord.X;
+    return std::all_of(begin, begin + columns, [&](const auto& cell) {
+        return cell.wch != L'\0' && cell.attr == _lastTextAttributes;
+    });
+}
+
+// Routine Description:
+// - Prints the given known cells again, moving the cursor past them. The
+//   caller must have checked _CanReprintKnownCells first.
+// Arguments:
+// - coord - the first cell to reprint
+// - columns - the number of cells to reprint
+// Return Value:
+// - S_OK or suitable HRESULT error from writing pipe.
+[[nodiscard]] HRESULT VtEngine::_ReprintKnownCells(const COORD coord, const size_t columns) noexcept
+try
+{
+    const auto begin = _knownCells.begin() + gsl::narrow_cast<size_t>(coord.Y) * _lastViewport.Width() + coord.X;
+
+    std::string text;
+    text.reserve(columns);
+    std::transform(begin, begin + columns, std::back_inserter(text), [](const auto& cell) {
+        return gsl::narrow_cast<char>(cell.wch);
+    });
+    return _Write(text);
+}
+CATCH_RETURN();
+
 // Method Description:
 // - Updates the window's title string. Emits the VT sequence to SetWindowTitle.
 //      Because wintelnet does not understand these sequences by default, we
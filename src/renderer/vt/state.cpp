@@ -56,6 +56,8 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
     _formatBuffer{},
     _conversionBuffer{}
 {
+    _knownCells.resize(gsl::narrow_cast<size_t>(initialViewport.Width()) * initialViewport.Height());
+
 #ifndef UNIT_TESTING
     // When unit testing, we can instantiate a VtEngine without a pipe.
     THROW_HR_IF(E_HANDLE, _hFile.get() == INVALID_HANDLE_VALUE);
@@ -136,6 +138,8 @@ VtEngine::VtEngine(_In_ wil::unique_hfile pipe,
 // - Wrapper for ITerminalOutputConnection. See _Write.
 [[nodiscard]] HRESULT VtEngine::WriteTerminalUtf8(const std::string_view str) noexcept
 {
+    // We have no idea what this does to the terminal's contents.
+    _ForgetAllKnownCells();
     return _Write(str);
 }
 
@@ -294,6 +298,14 @@ CATCH_RETURN();
             hr = _ResizeWindow(newView.Width(), newView.Height());
         }
         _resized = true;
+
+        // The terminal is going to reflow its contents, so none of the cells
+        // we've printed are where we left them anymore.
+        try
+        {
+            _knownCells.assign(gsl::narrow_cast<size_t>(newView.Width()) * newView.Height(), KnownCell{});
+        }
+        CATCH_RETURN();
     }
 
     // See MSFT:19408543
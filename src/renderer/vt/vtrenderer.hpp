@@ -153,6 +153,25 @@ namespace Microsoft::Console::Render
         bool _resizeQuirk{ false };
         std::optional<TextColor> _newBottomLineBG{ std::nullopt };
 
+        // The cells we've printed to the terminal, row by row across the
+        // viewport. When moving the cursor forward over a few of them, it's
+        // cheaper to print them again than to emit a cursor sequence. Only
+        // single-column printable ASCII is remembered. A wch of 0 marks a cell
+        // we can't vouch for, because it was erased, scrolled or never printed.
+        struct KnownCell
+        {
+            wchar_t wch{ 0 };
+            TextAttribute attr;
+        };
+        std::vector<KnownCell> _knownCells;
+
+        // While batching, SGR parameters are gathered here instead of being
+        // written one sequence at a time. See _WriteGraphicsRendition.
+        bool _batchGraphicsRendition{ false };
+        size_t _graphicsRenditionParams{ 0 };
+        std::string _graphicsRenditionBatch;
+        std::string _graphicsRenditionSequence;
+
         [[nodiscard]] HRESULT _Write(std::string_view const str) noexcept;
         [[nodiscard]] HRESULT _WriteFormattedString(const std::string* const pFormat, ...) noexcept;
         [[nodiscard]] HRESULT _Flush() noexcept;
@@ -169,6 +188,9 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _DeleteLine(const short sLines) noexcept;
         [[nodiscard]] HRESULT _InsertLine(const short sLines) noexcept;
         [[nodiscard]] HRESULT _CursorForward(const short chars) noexcept;
+        [[nodiscard]] HRESULT _CursorBackward(const short chars) noexcept;
+        [[nodiscard]] HRESULT _CursorUp(const short lines) noexcept;
+        [[nodiscard]] HRESULT _CursorDown(const short lines) noexcept;
         [[nodiscard]] HRESULT _EraseCharacter(const short chars) noexcept;
         [[nodiscard]] HRESULT _CursorPosition(const COORD coord) noexcept;
         [[nodiscard]] HRESULT _CursorHome() noexcept;
@@ -184,6 +206,9 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _SetGraphicsRenditionDefaultColor(const bool fIsForeground) noexcept;
 
         [[nodiscard]] HRESULT _SetGraphicsDefault() noexcept;
+        [[nodiscard]] HRESULT _WriteGraphicsRendition(const std::string_view parameters) noexcept;
+        void _BeginGraphicsRendition() noexcept;
+        [[nodiscard]] HRESULT _EndGraphicsRendition() noexcept;
 
         [[nodiscard]] HRESULT _ResizeWindow(const short sWidth, const short sHeight) noexcept;
 
@@ -211,6 +236,12 @@ namespace Microsoft::Console::Render
 
         bool _WillWriteSingleChar() const;
 
+        void _RememberKnownCells(gsl::span<const Cluster> clusters, const COORD coord, const size_t columns) noexcept;
+        void _ForgetKnownCells(const COORD coord, const size_t columns) noexcept;
+        void _ForgetAllKnownCells() noexcept;
+        bool _CanReprintKnownCells(const COORD coord, const size_t columns) const noexcept;
+        [[nodiscard]] HRESULT _ReprintKnownCells(const COORD coord, const size_t columns) noexcept;
+
         // buffer space for these two functions to build their lines
         // so they don't have to alloc/free in a tight loop
         std::wstring _bufferLine;
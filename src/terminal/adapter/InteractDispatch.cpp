@@ -52,7 +52,7 @@ bool InteractDispatch::WriteCtrlKey(const KeyEvent& event)
 
 // Method Description:
 // - Writes a string of input to the host. The string is converted to keystrokes
-//      that will faithfully represent the input by CharToKeyEvents.
+//      that will faithfully represent the input by CharsToKeyEvents.
 // Arguments:
 // - string : a string to write to the console.
 // Return Value:
@@ -69,15 +69,7 @@ bool InteractDispatch::WriteString(const std::wstring_view string)
     if (success)
     {
         std::deque<std::unique_ptr<IInputEvent>> keyEvents;
-
-        for (const auto& wch : string)
-        {
-            std::deque<std::unique_ptr<KeyEvent>> convertedEvents = Microsoft::Console::Interactivity::CharToKeyEvents(wch, codepage);
-
-            std::move(convertedEvents.begin(),
-                      convertedEvents.end(),
-                      std::back_inserter(keyEvents));
-        }
+        Microsoft::Console::Interactivity::CharsToKeyEvents(string, codepage, keyEvents);
 
         success = WriteInput(keyEvents);
     }
@@ -1130,6 +1130,9 @@ bool AdaptDispatch::_ModeParamsHelper(const DispatchTypes::ModeParams param, con
     case DispatchTypes::ModeParams::W32IM_Win32InputMode:
         success = EnableWin32InputMode(enable);
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        success = EnableSynchronizedOutput(enable);
+        break;
     default:
         // If no functions to call, overall dispatch was a failure.
         success = false;
@@ -1919,6 +1922,9 @@ bool AdaptDispatch::HardReset()
     // Set the DECSCNM screen mode back to normal.
     success = SetScreenMode(false) && success;
 
+    // Don't leave the renderer waiting for the end of an update that won't come.
+    success = EnableSynchronizedOutput(false) && success;
+
     // Cursor to 1,1 - the Soft Reset guarantees this is absolute
     success = CursorPosition(1, 1) && success;
 
@@ -2208,6 +2214,20 @@ bool AdaptDispatch::EnableXtermBracketedPasteMode(const bool /*enabled*/) noexce
     return NoOp();
 }
 
+//Routine Description:
+// Enable "synchronized output mode" - While set, the application is in the
+//      middle of updating the screen, so the renderer holds back any frames
+//      until it's reset again (or a timeout passes). This avoids painting
+//      half-finished updates.
+//Arguments:
+// - enabled - true to enable, false to disable.
+// Return value:
+// True if handled successfully. False otherwise.
+bool AdaptDispatch::EnableSynchronizedOutput(const bool enabled)
+{
+    return _pConApi->PrivateEnableSynchronizedOutput(enabled);
+}
+
 //Routine Description:
 // Set Cursor Style - Changes the cursor's style to match the given Dispatch
 //      cursor style. Unix styles are a combination of the shape and the blinking state.
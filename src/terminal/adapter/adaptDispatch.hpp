@@ -20,6 +20,7 @@ Author(s):
 #include "adaptDefaults.hpp"
 #include "terminalOutput.hpp"
 #include "..\..\types\inc\sgrStack.hpp"
+#include "..\..\types\inc\sgrTransitionCache.hpp"
 
 namespace Microsoft::Console::VirtualTerminal
 {
@@ -111,6 +112,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool EnableAnyEventMouseMode(const bool enabled) override; // ?1003
         bool EnableAlternateScroll(const bool enabled) override; // ?1007
         bool EnableXtermBracketedPasteMode(const bool enabled) noexcept override; // ?2004
+        bool EnableSynchronizedOutput(const bool enabled) override; // ?2026
         bool SetCursorStyle(const DispatchTypes::CursorStyle cursorStyle) override; // DECSCUSR
         bool SetCursorColor(const COLORREF cursorColor) override;
 
@@ -204,6 +206,7 @@ namespace Microsoft::Console::VirtualTerminal
         bool _isDECCOLMAllowed;
 
         SgrStack _sgrStack;
+        SgrTransitionCache _sgrTransitions;
 
         size_t _SetRgbColorsHelper(const VTParameters options,
                                    TextAttribute& attr,
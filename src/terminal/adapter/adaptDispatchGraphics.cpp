@@ -103,6 +103,15 @@ bool AdaptDispatch::SetGraphicsRendition(const VTParameters options)
 
     if (success)
     {
+        // Colorized output keeps switching between the same few renditions,
+        // so most of the time we already know what these options result in.
+        if (const auto cached = _sgrTransitions.Lookup(attr, options))
+        {
+            return _pConApi->PrivateSetTextAttributes(*cached);
+        }
+
+        const auto previousAttr = attr;
+
         // Run through the graphics options and apply them
         for (size_t i = 0; i < options.size(); i++)
         {
@@ -281,6 +290,7 @@ bool AdaptDispatch::SetGraphicsRendition(const VTParameters options)
                 break;
             }
         }
+        _sgrTransitions.Store(previousAttr, options, attr);
         success = _pConApi->PrivateSetTextAttributes(attr);
     }
 
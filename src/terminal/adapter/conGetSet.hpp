@@ -72,6 +72,7 @@ namespace Microsoft::Console::VirtualTerminal
         virtual bool PrivateEnableButtonEventMouseMode(const bool enabled) = 0;
         virtual bool PrivateEnableAnyEventMouseMode(const bool enabled) = 0;
         virtual bool PrivateEnableAlternateScroll(const bool enabled) = 0;
+        virtual bool PrivateEnableSynchronizedOutput(const bool enabled) = 0;
         virtual bool PrivateEraseAll() = 0;
         virtual bool GetUserDefaultCursorStyle(CursorType& style) = 0;
         virtual bool SetCursorStyle(const CursorType style) = 0;
@@ -412,6 +412,16 @@ public:
         return _privateEnableAlternateScrollResult;
     }
 
+    bool PrivateEnableSynchronizedOutput(const bool enabled) override
+    {
+        Log::Comment(L"PrivateEnableSynchronizedOutput MOCK called...");
+        if (_privateEnableSynchronizedOutputResult)
+        {
+            VERIFY_ARE_EQUAL(_expectedSynchronizedOutputEnabled, enabled);
+        }
+        return _privateEnableSynchronizedOutputResult;
+    }
+
     bool PrivateEraseAll() override
     {
         Log::Comment(L"PrivateEraseAll MOCK called...");
@@ -792,6 +802,8 @@ public:
     bool _privateEnableButtonEventMouseModeResult = false;
     bool _privateEnableAnyEventMouseModeResult = false;
     bool _privateEnableAlternateScrollResult = false;
+    bool _expectedSynchronizedOutputEnabled = false;
+    bool _privateEnableSynchronizedOutputResult = false;
     bool _setCursorStyleResult = false;
     CursorType _expectedCursorStyle;
     bool _setCursorColorResult = false;
@@ -1812,6 +1824,56 @@ public:
         VERIFY_IS_TRUE(_testGetSet->_attribute.IsBold());
     }
 
+    TEST_METHOD(GraphicsRepeatedSequenceTests)
+    {
+        Log::Comment(L"Starting test...");
+
+        _testGetSet->PrepData();
+
+        VTParameter rgOptions[16];
+        size_t cOptions = 2;
+
+        Log::Comment(L"Testing graphics 'Bold, Foreground Color Red' from the default attributes");
+        rgOptions[0] = DispatchTypes::GraphicsOptions::BoldBright;
+        rgOptions[1] = DispatchTypes::GraphicsOptions::ForegroundRed;
+        _testGetSet->_attribute = {};
+        _testGetSet->_expectedAttribute = {};
+        _testGetSet->_expectedAttribute.SetBold(true);
+        _testGetSet->_expectedAttribute.SetIndexedForeground(FOREGROUND_RED);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"Applying the same sequence again gives the same result");
+        _testGetSet->_attribute = {};
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"Applying the same sequence to other attributes keeps their background");
+        _testGetSet->_attribute = {};
+        _testGetSet->_attribute.SetIndexedBackground(BACKGROUND_BLUE >> 4);
+        _testGetSet->_expectedAttribute.SetIndexedBackground(BACKGROUND_BLUE >> 4);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"An omitted parameter still resets the attributes");
+        rgOptions[0] = {};
+        _testGetSet->_attribute = {};
+        _testGetSet->_expectedAttribute = {};
+        _testGetSet->_expectedAttribute.SetIndexedForeground(FOREGROUND_RED);
+        VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+
+        Log::Comment(L"Sequences that only differ in the color index give different results");
+        cOptions = 3;
+        rgOptions[0] = DispatchTypes::GraphicsOptions::ForegroundExtended;
+        rgOptions[1] = DispatchTypes::GraphicsOptions::BlinkOrXterm256Index;
+        for (size_t index = 16; index < 24; index++)
+        {
+            rgOptions[2] = index;
+            _testGetSet->_attribute = {};
+            _testGetSet->_expectedAttribute = {};
+            _testGetSet->_expectedAttribute.SetIndexedForeground256(gsl::narrow_cast<BYTE>(index));
+            VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+            VERIFY_IS_TRUE(_pDispatch.get()->SetGraphicsRendition({ rgOptions, cOptions }));
+        }
+    }
+
     TEST_METHOD(DeviceStatusReportTests)
     {
         Log::Comment(L"Starting test...");
@@ -2234,6 +2296,24 @@ public:
         VERIFY_IS_TRUE(_pDispatch.get()->EnableAlternateScroll(false));
     }
 
+    TEST_METHOD(SynchronizedOutputTest)
+    {
+        Log::Comment(L"Starting test...");
+
+        Log::Comment(L"Test 1: DECSET 2026 starts a synchronized update");
+        _testGetSet->_expectedSynchronizedOutputEnabled = true;
+        _testGetSet->_privateEnableSynchronizedOutputResult = TRUE;
+        VERIFY_IS_TRUE(_pDispatch.get()->SetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+
+        Log::Comment(L"Test 2: DECRST 2026 ends it");
+        _testGetSet->_expectedSynchronizedOutputEnabled = false;
+        VERIFY_IS_TRUE(_pDispatch.get()->ResetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+
+        Log::Comment(L"Test 3: Failures are reported back");
+        _testGetSet->_privateEnableSynchronizedOutputResult = FALSE;
+        VERIFY_IS_FALSE(_pDispatch.get()->SetMode(DispatchTypes::ModeParams::SO_SynchronizedOutput));
+    }
+
     TEST_METHOD(Xterm256ColorTest)
     {
         Log::Comment(L"Starting test...");
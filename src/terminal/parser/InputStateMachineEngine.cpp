@@ -273,6 +273,9 @@ bool InputStateMachineEngine::ActionPassThroughString(const std::wstring_view st
     {
         // Synthesize string into key events that we'll write to the buffer
         // similar to TerminalInput::_SendInputSequence
+        // This deliberately doesn't use CharsToKeyEvents: a VT input client
+        // expects the raw characters of the sequence as key-down events without
+        // virtual keys, scan codes or synthesized modifier keys.
         if (!string.empty())
         {
             try
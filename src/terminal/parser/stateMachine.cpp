@@ -13,12 +13,13 @@ using namespace Microsoft::Console::VirtualTerminal;
 StateMachine::StateMachine(std::unique_ptr<IStateMachineEngine> engine) :
     _engine(std::move(engine)),
     _state(VTStates::Ground),
-    _trace(Microsoft::Console::VirtualTerminal::ParserTracing()),
+    _trace{},
+    _metrics{},
     _isInAnsiMode(true),
     _parameters{},
     _parameterLimitReached(false),
     _oscString{},
-    _cachedSequence{ std::nullopt },
+    _cachedSequence{},
     _processingIndividually(false)
 {
     _ActionClear();
@@ -39,6 +40,90 @@ IStateMachineEngine& StateMachine::Engine() noexcept
     return *_engine;
 }
 
+// Routine Description:
+// - Returns the counters describing the work this state machine has done
+//   since it was created or since the last call to ResetMetrics.
+// Arguments:
+// - <none>
+// Return Value:
+// - The current metrics.
+const ParserMetrics& StateMachine::Metrics() const noexcept
+{
+    return _metrics;
+}
+
+// Routine Description:
+// - Resets all counters returned by Metrics to zero.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void StateMachine::ResetMetrics() noexcept
+{
+    _metrics = {};
+}
+
+// Routine Description:
+// - Counts a dispatch to the engine.
+// Arguments:
+// - counter - The counter for the type of the dispatch.
+// - success - Whether the engine handled the dispatch.
+// Return Value:
+// - <none>
+void StateMachine::_RecordDispatch(uint64_t ParserMetrics::*const counter, const bool success) noexcept
+{
+    ++(_metrics.*counter);
+    if (!success)
+    {
+        ++_metrics.failedDispatches;
+    }
+}
+
+// Routine Description:
+// - Counts a dispatch to the engine and adds the time it took to dispatchTime.
+//   Executes are called for every single C0 control, so they don't use this.
+// Arguments:
+// - counter - The counter for the type of the dispatch.
+// - success - Whether the engine handled the dispatch.
+// - start - The time right before the engine was called.
+// Return Value:
+// - <none>
+void StateMachine::_RecordDispatch(uint64_t ParserMetrics::*const counter, const bool success, const std::chrono::steady_clock::time_point start) noexcept
+{
+    _metrics.dispatchTime += std::chrono::steady_clock::now() - start;
+    _RecordDispatch(counter, success);
+}
+
+// Routine Description:
+// - Counts a run of characters printed by the engine and adds the time it
+//   took to dispatchTime.
+// Arguments:
+// - length - The number of characters in the run.
+// - start - The time right before the engine was called.
+// Return Value:
+// - <none>
+void StateMachine::_RecordPrintRun(const size_t length, const std::chrono::steady_clock::time_point start) noexcept
+{
+    _metrics.dispatchTime += std::chrono::steady_clock::now() - start;
+    _RecordPrintRun(length);
+}
+
+// Routine Description:
+// - Counts a run of characters printed by the engine.
+// Arguments:
+// - length - The number of characters in the run.
+// Return Value:
+// - <none>
+void StateMachine::_RecordPrintRun(const size_t length) noexcept
+{
+    size_t bucket = 0;
+    for (auto remaining = length >> 1; remaining != 0 && bucket < _metrics.printRunLengths.size() - 1; remaining >>= 1)
+    {
+        ++bucket;
+    }
+    ++til::at(_metrics.printRunLengths, bucket);
+}
+
 // Routine Description:
 // - Determines if a character is a valid number character, 0-9.
 // Arguments:
@@ -384,6 +469,7 @@ void StateMachine::_ActionExecute(const wchar_t wch)
 {
     _trace.TraceOnExecute(wch);
     const bool success = _engine->ActionExecute(wch);
+    _RecordDispatch(&ParserMetrics::executed, success);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -402,6 +488,7 @@ void StateMachine::_ActionExecuteFromEscape(const wchar_t wch)
     _trace.TraceOnExecuteFromEscape(wch);
 
     const bool success = _engine->ActionExecuteFromEscape(wch);
+    _RecordDispatch(&ParserMetrics::executed, success);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -418,6 +505,7 @@ void StateMachine::_ActionPrint(const wchar_t wch)
     _trace.TraceOnAction(L"Print");
 
     const bool success = _engine->ActionPrint(wch);
+    _RecordPrintRun(1);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -434,7 +522,9 @@ void StateMachine::_ActionEscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"EscDispatch");
 
+    const auto start = std::chrono::steady_clock::now();
     const bool success = _engine->ActionEscDispatch(_identifier.Finalize(wch));
+    _RecordDispatch(&ParserMetrics::escDispatched, success, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -457,8 +547,10 @@ void StateMachine::_ActionVt52EscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Vt52EscDispatch");
 
+    const auto start = std::chrono::steady_clock::now();
     const bool success = _engine->ActionVt52EscDispatch(_identifier.Finalize(wch),
                                                         { _parameters.data(), _parameters.size() });
+    _RecordDispatch(&ParserMetrics::vt52Dispatched, success, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -481,8 +573,10 @@ void StateMachine::_ActionCsiDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"CsiDispatch");
 
+    const auto start = std::chrono::steady_clock::now();
     const bool success = _engine->ActionCsiDispatch(_identifier.Finalize(wch),
                                                     { _parameters.data(), _parameters.size() });
+    _RecordDispatch(&ParserMetrics::csiDispatched, success, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -648,7 +742,9 @@ void StateMachine::_ActionOscDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"OscDispatch");
 
+    const auto start = std::chrono::steady_clock::now();
     const bool success = _engine->ActionOscDispatch(wch, _oscParameter, _oscString);
+    _RecordDispatch(&ParserMetrics::oscDispatched, success, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -671,7 +767,9 @@ void StateMachine::_ActionSs3Dispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"Ss3Dispatch");
 
+    const auto start = std::chrono::steady_clock::now();
     const bool success = _engine->ActionSs3Dispatch(wch, { _parameters.data(), _parameters.size() });
+    _RecordDispatch(&ParserMetrics::ss3Dispatched, success, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -694,11 +792,13 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
 {
     _trace.TraceOnAction(L"DcsDispatch");
 
+    const auto start = std::chrono::steady_clock::now();
     _dcsStringHandler = _engine->ActionDcsDispatch(_identifier.Finalize(wch),
                                                    { _parameters.data(), _parameters.size() });
 
     // If the returned handler is null, the sequence is not supported.
     const bool success = _dcsStringHandler != nullptr;
+    _RecordDispatch(&ParserMetrics::dcsDispatched, success, start);
 
     // Trace the result.
     _trace.DispatchSequenceTrace(success);
@@ -728,7 +828,7 @@ void StateMachine::_ActionDcsDispatch(const wchar_t wch)
 void StateMachine::_EnterGround() noexcept
 {
     _state = VTStates::Ground;
-    _cachedSequence.reset(); // entering ground means we've completed the pending sequence
+    _cachedSequence.clear(); // entering ground means we've completed the pending sequence
     _trace.TraceStateChange(L"Ground");
 }
 
@@ -1803,13 +1903,13 @@ bool StateMachine::FlushToTerminal()
 {
     bool success{ true };
 
-    if (success && _cachedSequence.has_value())
+    if (success && !_cachedSequence.empty())
     {
         // Flush the partial sequence to the terminal before we flush the rest of it.
         // We always want to clear the sequence, even if we failed, so we don't accumulate bad state
         // and dump it out elsewhere later.
-        success = _engine->ActionPassThroughString(*_cachedSequence);
-        _cachedSequence.reset();
+        success = _engine->ActionPassThroughString(_cachedSequence);
+        _cachedSequence.clear();
     }
 
     if (success)
@@ -1835,6 +1935,8 @@ bool StateMachine::FlushToTerminal()
 // - <none>
 void StateMachine::ProcessString(const std::wstring_view string)
 {
+    _metrics.charactersParsed += string.size();
+
     size_t start = 0;
     size_t current = start;
 
@@ -1867,7 +1969,9 @@ void StateMachine::ProcessString(const std::wstring_view string)
                     // and only pass through everything before it.
                     const auto allLeadingUpTo = _run.substr(0, _run.size() - 1);
 
+                    const auto printStart = std::chrono::steady_clock::now();
                     _engine->ActionPrintString(allLeadingUpTo); // ... print all the chars leading up to it as part of the run...
+                    _RecordPrintRun(allLeadingUpTo.size(), printStart);
                     _trace.DispatchPrintRunTrace(allLeadingUpTo);
                 }
 
@@ -1891,7 +1995,9 @@ void StateMachine::ProcessString(const std::wstring_view string)
     if (!_processingIndividually && !_run.empty())
     {
         // print the rest of the characters in the string
+        const auto printStart = std::chrono::steady_clock::now();
         _engine->ActionPrintString(_run);
+        _RecordPrintRun(_run.size(), printStart);
         _trace.DispatchPrintRunTrace(_run);
     }
     else if (_processingIndividually)
@@ -1960,8 +2066,9 @@ void StateMachine::ProcessString(const std::wstring_view string)
         {
             // If the engine doesn't require flushing at the end of the string, we
             // want to cache the partial sequence in case we have to flush the whole
-            // thing to the terminal later.
-            _cachedSequence = _cachedSequence.value_or(std::wstring{}) + std::wstring{ _run };
+            // thing to the terminal later. We append to the same buffer every
+            // time, so it only grows when a sequence outgrows its capacity.
+            _cachedSequence.append(_run);
         }
     }
 }
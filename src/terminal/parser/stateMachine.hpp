@@ -17,6 +17,8 @@ Abstract:
 #include "IStateMachineEngine.hpp"
 #include "telemetry.hpp"
 #include "tracing.hpp"
+#include <array>
+#include <chrono>
 #include <memory>
 
 namespace Microsoft::Console::VirtualTerminal
@@ -32,6 +34,37 @@ namespace Microsoft::Console::VirtualTerminal
     // that number.
     constexpr size_t MAX_PARAMETER_COUNT = 32;
 
+    // Counters describing the work a StateMachine has done. Nothing in the tree
+    // reads them yet; they're there for hosts and tests through Metrics().
+    // Characters are counted once per ProcessString call. Executes and single
+    // printed characters are counted once each, but never timed.
+    struct ParserMetrics
+    {
+        // The number of characters passed to ProcessString.
+        uint64_t charactersParsed;
+
+        // The number of dispatches of each type.
+        uint64_t executed;
+        uint64_t escDispatched;
+        uint64_t vt52Dispatched;
+        uint64_t csiDispatched;
+        uint64_t oscDispatched;
+        uint64_t ss3Dispatched;
+        uint64_t dcsDispatched;
+
+        // The number of dispatches above that the engine didn't handle.
+        uint64_t failedDispatches;
+
+        // printRunLengths[i] counts the print runs with a length in [2^i, 2^(i+1)).
+        // The last bucket also counts all runs longer than that.
+        std::array<uint64_t, 16> printRunLengths;
+
+        // The time spent in the engine printing runs and dispatching escape,
+        // control and string sequences. Executes and characters that are
+        // printed one at a time aren't timed, to keep the clock off that path.
+        std::chrono::steady_clock::duration dispatchTime;
+    };
+
     class StateMachine final
     {
 #ifdef UNIT_TESTING
@@ -54,6 +87,9 @@ namespace Microsoft::Console::VirtualTerminal
         const IStateMachineEngine& Engine() const noexcept;
         IStateMachineEngine& Engine() noexcept;
 
+        const ParserMetrics& Metrics() const noexcept;
+        void ResetMetrics() noexcept;
+
     private:
         void _ActionExecute(const wchar_t wch);
         void _ActionExecuteFromEscape(const wchar_t wch);
@@ -115,6 +151,11 @@ namespace Microsoft::Console::VirtualTerminal
 
         void _AccumulateTo(const wchar_t wch, size_t& value) noexcept;
 
+        void _RecordDispatch(uint64_t ParserMetrics::*const counter, const bool success) noexcept;
+        void _RecordDispatch(uint64_t ParserMetrics::*const counter, const bool success, const std::chrono::steady_clock::time_point start) noexcept;
+        void _RecordPrintRun(const size_t length) noexcept;
+        void _RecordPrintRun(const size_t length, const std::chrono::steady_clock::time_point start) noexcept;
+
         enum class VTStates
         {
             Ground,
@@ -138,7 +179,8 @@ namespace Microsoft::Console::VirtualTerminal
             SosPmApcString
         };
 
-        Microsoft::Console::VirtualTerminal::ParserTracing _trace;
+        Microsoft::Console::VirtualTerminal::ParserTracingPolicy _trace;
+        ParserMetrics _metrics;
 
         std::unique_ptr<IStateMachineEngine> _engine;
 
@@ -148,8 +190,11 @@ namespace Microsoft::Console::VirtualTerminal
 
         std::wstring_view _run;
 
+        // The identifier and the parameters are stored inline, and the string
+        // buffers are cleared without releasing their capacity, so that
+        // parsing a sequence doesn't allocate once we've warmed up.
         VTIDBuilder _identifier;
-        std::vector<VTParameter> _parameters;
+        til::some<VTParameter, MAX_PARAMETER_COUNT> _parameters;
         bool _parameterLimitReached;
 
         std::wstring _oscString;
@@ -157,7 +202,8 @@ namespace Microsoft::Console::VirtualTerminal
 
         IStateMachineEngine::StringHandler _dcsStringHandler;
 
-        std::optional<std::wstring> _cachedSequence;
+        // The partial sequence we've seen so far, if we're caching one.
+        std::wstring _cachedSequence;
 
         // This is tracked per state machine instance so that separate calls to Process*
         //   can start and finish a sequence.
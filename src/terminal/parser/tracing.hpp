@@ -8,6 +8,9 @@ Module Name:
 Abstract:
 - This module is used for recording tracing/debugging information to the telemetry ETW channel
 - The data is not automatically broadcast to telemetry backends.
+- Which tracer the state machine uses is decided at compile time. Release
+  builds use NullParserTracing, whose methods are empty and compile away, so
+  the per-character trace calls don't cost anything outside of debug builds.
 - NOTE: Many functions in this file appear to be copy/pastes. This is because the TraceLog documentation warns
         to not be "cute" in trying to reduce its macro usages with variables as it can cause unexpected behavior.
 */
@@ -38,4 +41,27 @@ namespace Microsoft::Console::VirtualTerminal
     private:
         std::wstring _sequenceTrace;
     };
+
+    class NullParserTracing sealed
+    {
+    public:
+        constexpr void TraceStateChange(const std::wstring_view /*name*/) const noexcept {}
+        constexpr void TraceOnAction(const std::wstring_view /*name*/) const noexcept {}
+        constexpr void TraceOnExecute(const wchar_t /*wch*/) const noexcept {}
+        constexpr void TraceOnExecuteFromEscape(const wchar_t /*wch*/) const noexcept {}
+        constexpr void TraceOnEvent(const std::wstring_view /*name*/) const noexcept {}
+        constexpr void TraceCharInput(const wchar_t /*wch*/) noexcept {}
+
+        constexpr void AddSequenceTrace(const wchar_t /*wch*/) noexcept {}
+        constexpr void DispatchSequenceTrace(const bool /*fSuccess*/) noexcept {}
+        constexpr void ClearSequenceTrace() noexcept {}
+        constexpr void DispatchPrintRunTrace(const std::wstring_view /*string*/) const noexcept {}
+    };
+
+    // Define VT_PARSER_TRACING to get the ETW parser tracing in a release build.
+#if defined(DBG) || defined(VT_PARSER_TRACING)
+    using ParserTracingPolicy = ParserTracing;
+#else
+    using ParserTracingPolicy = NullParserTracing;
+#endif
 }
@@ -280,6 +280,8 @@ class Microsoft::Console::VirtualTerminal::InputEngineTest
     TEST_METHOD(TestWin32InputParsing);
     TEST_METHOD(TestWin32InputOptionals);
 
+    TEST_METHOD(CharsToKeyEventsTest);
+
     friend class TestInteractDispatch;
 };
 
@@ -375,15 +377,9 @@ bool TestInteractDispatch::WriteString(const std::wstring_view string)
 {
     std::deque<std::unique_ptr<IInputEvent>> keyEvents;
 
-    for (const auto& wch : string)
-    {
-        // We're forcing the translation to CP_USA, so that it'll be constant
-        //  regardless of the CP the test is running in
-        std::deque<std::unique_ptr<KeyEvent>> convertedEvents = Microsoft::Console::Interactivity::CharToKeyEvents(wch, CP_USA);
-        std::move(convertedEvents.begin(),
-                  convertedEvents.end(),
-                  std::back_inserter(keyEvents));
-    }
+    // We're forcing the translation to CP_USA, so that it'll be constant
+    //  regardless of the CP the test is running in
+    Microsoft::Console::Interactivity::CharsToKeyEvents(string, CP_USA, keyEvents);
 
     return WriteInput(keyEvents);
 }
@@ -1535,3 +1531,29 @@ void InputEngineTest::TestWin32InputOptionals()
         }
     }
 }
+
+void InputEngineTest::CharsToKeyEventsTest()
+{
+    Log::Comment(L"Converting a whole string at once must result in the same events as converting each character.");
+
+    // This contains repeated characters, to exercise the lookup cache, as well as shifted and non-ASCII ones.
+    const std::wstring_view text{ L"Hello, World! ~~ \x041B\u65C5 \r\n Hello\t" };
+
+    std::deque<std::unique_ptr<IInputEvent>> expected;
+    for (const auto& wch : text)
+    {
+        auto convertedEvents = Microsoft::Console::Interactivity::CharToKeyEvents(wch, CP_USA);
+        std::move(convertedEvents.begin(), convertedEvents.end(), std::back_inserter(expected));
+    }
+
+    std::deque<std::unique_ptr<IInputEvent>> actual;
+    Microsoft::Console::Interactivity::CharsToKeyEvents(text, CP_USA, actual);
+
+    const auto expectedRecords = IInputEvent::ToInputRecords(expected);
+    const auto actualRecords = IInputEvent::ToInputRecords(actual);
+    VERIFY_ARE_EQUAL(expectedRecords.size(), actualRecords.size());
+    for (size_t i = 0; i < expectedRecords.size(); ++i)
+    {
+        VERIFY_ARE_EQUAL(expectedRecords.at(i), actualRecords.at(i));
+    }
+}
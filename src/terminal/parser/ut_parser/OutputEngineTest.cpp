@@ -33,6 +33,37 @@ namespace Microsoft
 // 32767-32768 is our boundary SHORT_MAX for the Windows console
 #define PARAM_VALUES L"{0, 1, 2, 1000, 9999, 10000, 16383, 16384, 32767, 32768, 50000, 999999999}"
 
+// While s_countAllocations is set, every heap allocation made on the current
+// thread is counted, so we can verify that the parser doesn't allocate.
+// NOTE: Replacing the global operator new and delete is intentionally binary-wide:
+// they're used by every test in this test DLL, not just by this file. Only the
+// scalar, throwing new and the unsized delete are replaced. The array, nothrow
+// and sized forms forward to these in the CRT, so they stay paired with each
+// other. The over-aligned forms don't, and aren't counted. Outside of
+// TestSteadyStateDoesNotAllocate the counter is off and this behaves like the
+// default allocator.
+static thread_local bool s_countAllocations = false;
+static thread_local size_t s_allocationCount = 0;
+
+void* operator new(size_t size)
+{
+    if (s_countAllocations)
+    {
+        ++s_allocationCount;
+    }
+
+    if (const auto ptr = malloc(size ? size : 1))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
 class DummyDispatch final : public TermDispatch
 {
 public:
@@ -969,6 +1000,47 @@ class Microsoft::Console::VirtualTerminal::OutputEngineTest final
         mach.ProcessCharacter(L'\x9c');
         VERIFY_ARE_EQUAL(mach._state, StateMachine::VTStates::Ground);
     }
+
+    TEST_METHOD(TestSteadyStateDoesNotAllocate)
+    {
+        auto dispatch = std::make_unique<DummyDispatch>();
+        auto engine = std::make_unique<OutputStateMachineEngine>(std::move(dispatch));
+        StateMachine mach(std::move(engine));
+
+        // Sequences with and without parameters and intermediates, more
+        // parameters than we can store, OSC and DCS strings, and a sequence
+        // that's split across two writes, so that it has to be cached.
+        const std::array<std::wstring_view, 10> traces{
+            L"Hello world\r\n",
+            L"\x1b[H\x1b[2J\x1b[12;34H",
+            L"\x1b[38;2;12;34;56;48;5;123;1;4m",
+            L"\x1b[1;2;3;4;5;6;7;8;9;10;11;12;13;14;15;16;17;18;19;20;21;22;23;24;25;26;27;28;29;30;31;32;33;34;35m",
+            L"\x1b[?1049h\x1b[?1049l\x1b[ q\x1b(0\x1b(B",
+            L"\x1b]99;some long string that isn't dispatched anywhere\x07",
+            L"\x1bP1;2$xignored\x1b\\",
+            L"\x1b[3",
+            L"8;5;200m",
+            L"\x1b]99;split\x1b\\"
+        };
+        const auto processTraces = [&]() {
+            for (const auto trace : traces)
+            {
+                mach.ProcessString(trace);
+            }
+        };
+
+        // The first pass may allocate, since that's when the buffers grow.
+        processTraces();
+
+        s_allocationCount = 0;
+        s_countAllocations = true;
+        processTraces();
+        processTraces();
+        s_countAllocations = false;
+
+        VERIFY_ARE_EQUAL(0u, s_allocationCount);
+        VERIFY_ARE_EQUAL(mach._state, StateMachine::VTStates::Ground);
+    }
 };
 
 class StatefulDispatch final : public TermDispatch
@@ -162,6 +162,8 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(PassThroughUnhandledSplitAcrossWrites);
 
     TEST_METHOD(DcsDataStringsReceivedByHandler);
+
+    TEST_METHOD(MetricsCountRunsAndSequences);
 };
 
 void StateMachineTest::TwoStateMachinesDoNotInterfereWithEachother()
@@ -342,3 +344,41 @@ void StateMachineTest::DcsDataStringsReceivedByHandler()
     // Verify the control characters were executed (if expected).
     VERIFY_ARE_EQUAL(expectedExecuted, engine.executed);
 }
+
+void StateMachineTest::MetricsCountRunsAndSequences()
+{
+    StateMachine machine{ std::make_unique<TestStateMachineEngine>() };
+
+    const std::wstring_view text{ L"Hello\x1b[1mWorld!\r\n\x1b]0;title\x07\x1b"
+                                  L"7" };
+    machine.ProcessString(text);
+
+    auto& metrics = machine.Metrics();
+    VERIFY_ARE_EQUAL(text.size(), metrics.charactersParsed);
+    VERIFY_ARE_EQUAL(2u, metrics.executed);
+    VERIFY_ARE_EQUAL(1u, metrics.csiDispatched);
+    VERIFY_ARE_EQUAL(1u, metrics.oscDispatched);
+    VERIFY_ARE_EQUAL(1u, metrics.escDispatched);
+    VERIFY_ARE_EQUAL(0u, metrics.dcsDispatched);
+    VERIFY_ARE_EQUAL(0u, metrics.failedDispatches);
+
+    Log::Comment(L"\"Hello\" and \"World!\" are both 4 to 7 characters long.");
+    VERIFY_ARE_EQUAL(2u, metrics.printRunLengths.at(2));
+
+    Log::Comment(L"Runs are bucketed by the power of two of their length.");
+    machine.ProcessString(L"x");
+    machine.ProcessString(std::wstring(100, L'x'));
+    machine.ProcessString(std::wstring(70000, L'x'));
+    VERIFY_ARE_EQUAL(1u, metrics.printRunLengths.at(0));
+    VERIFY_ARE_EQUAL(1u, metrics.printRunLengths.at(6));
+    VERIFY_ARE_EQUAL(1u, metrics.printRunLengths.back(), L"Overly long runs end up in the last bucket");
+
+    Log::Comment(L"Print runs and sequences are timed in every build.");
+    VERIFY_IS_TRUE(metrics.dispatchTime > std::chrono::steady_clock::duration::zero());
+
+    machine.ResetMetrics();
+    VERIFY_ARE_EQUAL(0u, metrics.charactersParsed);
+    VERIFY_ARE_EQUAL(0u, metrics.csiDispatched);
+    VERIFY_ARE_EQUAL(0u, metrics.printRunLengths.at(2));
+    VERIFY_IS_TRUE(metrics.dispatchTime == std::chrono::steady_clock::duration::zero());
+}
@@ -31,8 +31,9 @@ class BitmapTests
             // If any of the rectangles we were given contains this point, we expect it should be on.
             const auto expected = std::any_of(bitsOn.cbegin(), bitsOn.cend(), [&pt](auto bitRect) { return bitRect.contains(pt); });
 
-            // Get the actual bit out of the map.
-            const auto actual = map._bits[map._rc.index_of(pt)];
+            // Get the actual bit out of the map by looking for an interval in its row that covers it.
+            const auto& row = map._rows.at(pt.y<size_t>());
+            const auto actual = std::any_of(row.cbegin(), row.cend(), [&pt](auto interval) { return interval.left <= pt.x() && pt.x() < interval.right; });
 
             // Do it this way and not with equality so you can see it in output.
             if (expected)
@@ -53,11 +54,9 @@ class BitmapTests
         const til::rectangle expectedRect{ 0, 0, 0, 0 };
         VERIFY_ARE_EQUAL(expectedSize, bitmap._sz);
         VERIFY_ARE_EQUAL(expectedRect, bitmap._rc);
-        VERIFY_ARE_EQUAL(0u, bitmap._bits.size());
-
-        // The find will go from begin to end in the bits looking for a "true".
-        // It should miss so the result should be "cend" and turn out true here.
-        VERIFY_IS_TRUE(bitmap._bits.none());
+        VERIFY_ARE_EQUAL(0u, bitmap._rows.size());
+        VERIFY_ARE_EQUAL(0, bitmap._count);
+        VERIFY_IS_TRUE(bitmap.none());
     }
 
     TEST_METHOD(SizeConstruct)
@@ -67,11 +66,11 @@ class BitmapTests
         const til::bitmap bitmap{ expectedSize };
         VERIFY_ARE_EQUAL(expectedSize, bitmap._sz);
         VERIFY_ARE_EQUAL(expectedRect, bitmap._rc);
-        VERIFY_ARE_EQUAL(50u, bitmap._bits.size());
+        VERIFY_ARE_EQUAL(10u, bitmap._rows.size());
 
-        // The find will go from begin to end in the bits looking for a "true".
-        // It should miss so the result should be "cend" and turn out true here.
-        VERIFY_IS_TRUE(bitmap._bits.none());
+        // No row should contain any interval of set bits.
+        VERIFY_IS_TRUE(std::all_of(bitmap._rows.cbegin(), bitmap._rows.cend(), [](auto& row) { return row.empty(); }));
+        VERIFY_IS_TRUE(bitmap.none());
     }
 
     TEST_METHOD(SizeConstructWithFill)
@@ -88,15 +87,24 @@ class BitmapTests
         const til::bitmap bitmap{ expectedSize, fill };
         VERIFY_ARE_EQUAL(expectedSize, bitmap._sz);
         VERIFY_ARE_EQUAL(expectedRect, bitmap._rc);
-        VERIFY_ARE_EQUAL(50u, bitmap._bits.size());
+        VERIFY_ARE_EQUAL(10u, bitmap._rows.size());
 
         if (!fill)
         {
-            VERIFY_IS_TRUE(bitmap._bits.none());
+            VERIFY_ARE_EQUAL(0, bitmap._count);
+            VERIFY_IS_TRUE(bitmap.none());
         }
         else
         {
-            VERIFY_IS_TRUE(bitmap._bits.all());
+            // Every row should be a single interval spanning the full width.
+            for (const auto& row : bitmap._rows)
+            {
+                VERIFY_ARE_EQUAL(1u, row.size());
+                VERIFY_ARE_EQUAL(0, row.front().left);
+                VERIFY_ARE_EQUAL(5, row.front().right);
+            }
+            VERIFY_ARE_EQUAL(50, bitmap._count);
+            VERIFY_IS_TRUE(bitmap.all());
         }
     }
 
@@ -587,7 +595,7 @@ class BitmapTests
 
         // Every bit should be false.
         Log::Comment(L"All bits false on creation.");
-        VERIFY_IS_TRUE(bitmap._bits.none());
+        VERIFY_IS_TRUE(bitmap.none());
 
         const til::point point{ 2, 2 };
         bitmap.set(point);
@@ -632,6 +640,48 @@ class BitmapTests
         _checkBits(expectedSet, bitmap);
     }
 
+    TEST_METHOD(SetMergesIntervals)
+    {
+        til::bitmap map{ til::size{ 8, 2 } };
+
+        Log::Comment(L"1.) Disjoint intervals stay apart and are kept sorted.");
+        // 0 0 0 0 0 0 0 0      0 1 0 0 0 1 1 0
+        // 0 0 0 0 0 0 0 0 -->  0 0 0 0 0 0 0 0
+        map.set(til::rectangle{ til::point{ 5, 0 }, til::size{ 2, 1 } });
+        map.set(til::point{ 1, 0 });
+        VERIFY_ARE_EQUAL(2u, map._rows[0].size());
+        VERIFY_ARE_EQUAL(1, map._rows[0][0].left);
+        VERIFY_ARE_EQUAL(5, map._rows[0][1].left);
+        VERIFY_ARE_EQUAL(3, map._count);
+
+        Log::Comment(L"2.) An adjacent interval merges with its neighbor.");
+        // 0 1 0 0 0 1 1 0      0 1 1 0 0 1 1 0
+        map.set(til::point{ 2, 0 });
+        VERIFY_ARE_EQUAL(2u, map._rows[0].size());
+        VERIFY_ARE_EQUAL(3, map._rows[0][0].right);
+        VERIFY_ARE_EQUAL(4, map._count);
+
+        Log::Comment(L"3.) Setting bits that are already set changes nothing.");
+        map.set(til::rectangle{ til::point{ 1, 0 }, til::size{ 2, 1 } });
+        VERIFY_ARE_EQUAL(2u, map._rows[0].size());
+        VERIFY_ARE_EQUAL(4, map._count);
+
+        Log::Comment(L"4.) An interval bridging two others merges all of them.");
+        // 0 1 1 0 0 1 1 0      0 1 1 1 1 1 1 1
+        map.set(til::rectangle{ til::point{ 2, 0 }, til::size{ 6, 1 } });
+        VERIFY_ARE_EQUAL(1u, map._rows[0].size());
+        VERIFY_ARE_EQUAL(1, map._rows[0][0].left);
+        VERIFY_ARE_EQUAL(8, map._rows[0][0].right);
+        VERIFY_ARE_EQUAL(7, map._count);
+        VERIFY_IS_TRUE(map._rows[1].empty());
+
+        Log::Comment(L"5.) Filling the remaining bits makes every row a single interval.");
+        map.set(til::point{ 0, 0 });
+        map.set(til::rectangle{ til::point{ 0, 1 }, til::size{ 8, 1 } });
+        VERIFY_IS_TRUE(map.all());
+        VERIFY_ARE_EQUAL(til::bitmap(til::size{ 8, 2 }, true), map);
+    }
+
     TEST_METHOD(SetResetExceptions)
     {
         til::bitmap map{ til::size{ 4, 4 } };
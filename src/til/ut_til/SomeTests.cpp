@@ -224,6 +224,12 @@ class SomeTests
 
         VERIFY_ARE_EQUAL(one, s.front());
         VERIFY_ARE_EQUAL(two, s.back());
+
+        s.front() = two;
+        s.back() = one;
+
+        VERIFY_ARE_EQUAL(two, s.front());
+        VERIFY_ARE_EQUAL(one, s.back());
     }
 
     TEST_METHOD(Indexing)
@@ -555,20 +555,23 @@ std::wstring UiaTextRangeBase::_getTextValue(std::optional<unsigned int> maxLeng
         auto inclusiveEnd = _end;
         bufferSize.DecrementInBounds(inclusiveEnd, true);
 
-        const auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange, true);
+        auto textRects = buffer.GetTextRects(_start, inclusiveEnd, _blockRange, true);
+
+        // Every row of the range contributes at least one character, so
+        // there's no point in extracting more rows than we'll return.
+        if (maxLength.has_value() && textRects.size() > *maxLength)
+        {
+            textRects.resize(std::max(*maxLength, 1u));
+        }
+
         const auto bufferData = buffer.GetText(true,
                                                false,
                                                textRects);
 
-        const size_t textDataSize = base::ClampMul(bufferData.text.size(), bufferSize.Width());
-        textData.reserve(textDataSize);
-        for (const auto& text : bufferData.text)
-        {
-            textData += text;
-        }
+        textData = bufferData.JoinText();
     }
 
-    if (maxLength.has_value())
+    if (maxLength.has_value() && textData.size() > *maxLength)
     {
         textData.resize(*maxLength);
     }
@@ -958,33 +961,12 @@ void UiaTextRangeBase::_moveEndpointByUnitCharacter(_In_ const int moveCount,
     }
 
     const bool allowBottomExclusive = !preventBufferEnd;
-    const MovementDirection moveDirection = (moveCount > 0) ? MovementDirection::Forward : MovementDirection::Backward;
     const auto& buffer = _pData->GetTextBuffer();
 
-    bool success = true;
+    // MoveByGlyphs walks the rows directly, so that moving by a large
+    // number of characters doesn't cost a buffer lookup per character.
     til::point target = GetEndpoint(endpoint);
-    while (std::abs(*pAmountMoved) < std::abs(moveCount) && success)
-    {
-        switch (moveDirection)
-        {
-        case MovementDirection::Forward:
-            success = buffer.MoveToNextGlyph(target, allowBottomExclusive);
-            if (success)
-            {
-                (*pAmountMoved)++;
-            }
-            break;
-        case MovementDirection::Backward:
-            success = buffer.MoveToPreviousGlyph(target);
-            if (success)
-            {
-                (*pAmountMoved)--;
-            }
-            break;
-        default:
-            break;
-        }
-    }
+    *pAmountMoved = buffer.MoveByGlyphs(target, moveCount, allowBottomExclusive);
 
     SetEndpoint(endpoint, target);
 }
@@ -0,0 +1,80 @@
+/*++
+Copyright (c) Microsoft Corporation
+Licensed under the MIT license.
+
+Module Name:
+- sgrTransitionCache.hpp
+
+Abstract:
+- Remembers the outcome of recent SGR sequences, so that the dispatchers can
+  skip walking the graphics options when the same sequence is applied to the
+  same attributes again. Colorized output (compiler diagnostics, ls --color)
+  switches between a handful of renditions every few characters, so nearly
+  all of its SGR sequences end up as a single lookup.
+
+--*/
+
+#pragma once
+
+#include "..\..\buffer\out\TextAttribute.hpp"
+#include "..\..\terminal\adapter\DispatchTypes.hpp"
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    class SgrTransitionCache
+    {
+    public:
+        // Sequences with more parameters than this are rare and never cached.
+        // It's enough to hold an RGB color and a couple of other options.
+        static constexpr size_t MaxParameters = 8;
+
+        SgrTransitionCache() noexcept;
+
+        // Method Description:
+        // - Looks up the attributes that applying the given options to
+        //   currentAttributes resulted in the last time.
+        // Arguments:
+        // - currentAttributes - The attributes the options are applied to.
+        // - options - The SGR parameters.
+        // Return Value:
+        // - The resulting attributes, or nullptr if the transition isn't cached.
+        const TextAttribute* Lookup(const TextAttribute& currentAttributes,
+                                    const VTParameters options) const noexcept;
+
+        // Method Description:
+        // - Records that applying the given options to currentAttributes
+        //   results in newAttributes.
+        // Arguments:
+        // - currentAttributes - The attributes the options were applied to.
+        // - options - The SGR parameters.
+        // - newAttributes - The attributes that resulted from it.
+        // Return Value:
+        // - <none>
+        void Store(const TextAttribute& currentAttributes,
+                   const VTParameters options,
+                   const TextAttribute& newAttributes) noexcept;
+
+    private:
+        // The cache is 2-way set associative and indexed by the parameters
+        // alone, so that the same sequence applied to two different
+        // renditions (say, ESC[0m after either of two colors) doesn't thrash.
+        static constexpr size_t _setCount = 32;
+        static constexpr size_t _ways = 2;
+
+        struct Transition
+        {
+            TextAttribute from;
+            TextAttribute to;
+            std::array<size_t, MaxParameters> parameters;
+            size_t parameterCount; // 0 marks an unused entry
+        };
+
+        static size_t _GetSet(const VTParameters options) noexcept;
+        static bool _Matches(const Transition& transition,
+                             const TextAttribute& currentAttributes,
+                             const VTParameters options) noexcept;
+
+        std::array<Transition, _setCount * _ways> _transitions;
+        std::array<uint8_t, _setCount> _nextVictim;
+    };
+}
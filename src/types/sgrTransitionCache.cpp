@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "inc/sgrTransitionCache.hpp"
+
+namespace Microsoft::Console::VirtualTerminal
+{
+    SgrTransitionCache::SgrTransitionCache() noexcept :
+        _transitions{},
+        _nextVictim{}
+    {
+    }
+
+    const TextAttribute* SgrTransitionCache::Lookup(const TextAttribute& currentAttributes,
+                                                    const VTParameters options) const noexcept
+    {
+        if (options.size() > MaxParameters)
+        {
+            return nullptr;
+        }
+
+        const auto first = _GetSet(options) * _ways;
+        for (auto way = first; way < first + _ways; way++)
+        {
+            const auto& transition = til::at(_transitions, way);
+            if (_Matches(transition, currentAttributes, options))
+            {
+                return &transition.to;
+            }
+        }
+        return nullptr;
+    }
+
+    void SgrTransitionCache::Store(const TextAttribute& currentAttributes,
+                                   const VTParameters options,
+                                   const TextAttribute& newAttributes) noexcept
+    {
+        const auto parameterCount = options.size();
+        if (parameterCount > MaxParameters)
+        {
+            return;
+        }
+
+        // The ways of a set are replaced round-robin, which for two ways
+        // is the same as evicting the least recently stored one.
+        const auto set = _GetSet(options);
+        auto& victim = til::at(_nextVictim, set);
+        auto& transition = til::at(_transitions, set * _ways + victim);
+        victim = gsl::narrow_cast<uint8_t>((victim + 1) % _ways);
+
+        transition.from = currentAttributes;
+        transition.to = newAttributes;
+        for (size_t i = 0; i < parameterCount; i++)
+        {
+            // VTParameters::at returns an omitted parameter beyond the end of
+            // the list, so value() distinguishes omitted from explicit zeros.
+            til::at(transition.parameters, i) = options.at(i).value();
+        }
+        transition.parameterCount = parameterCount;
+    }
+
+    size_t SgrTransitionCache::_GetSet(const VTParameters options) noexcept
+    {
+        size_t hash = options.size();
+        for (size_t i = 0; i < options.size(); i++)
+        {
+            hash = hash * 31 + options.at(i).value();
+        }
+        return (hash ^ (hash >> 7)) % _setCount;
+    }
+
+    bool SgrTransitionCache::_Matches(const Transition& transition,
+                                      const TextAttribute& currentAttributes,
+                                      const VTParameters options) noexcept
+    {
+        if (transition.parameterCount != options.size() || transition.from != currentAttributes)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < transition.parameterCount; i++)
+        {
+            if (til::at(transition.parameters, i) != options.at(i).value())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}